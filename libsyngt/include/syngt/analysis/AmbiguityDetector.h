@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Параметры поиска неоднозначностей
+ */
+struct AmbiguityOptions {
+    size_t maxLength = 8;           // Проверять предложения длины до maxLength
+    double timeBudgetMs = 0;        // 0 - без ограничения
+    size_t sentenceBudget = 1000000;// Предел числа хранимых цепочек
+    unsigned threads = 1;           // 0 - по числу ядер
+};
+
+/**
+ * @brief Кратчайшая цепочка, которую правило нетерминала выводит двумя способами
+ */
+struct AmbiguityWitness {
+    std::string nonTerminal;
+    std::vector<int> sentence;      // Идентификаторы терминалов
+};
+
+struct AmbiguityReport {
+    std::vector<AmbiguityWitness> ambiguities;  // В порядке getNonTerminals()
+    int checkedLength = -1;         // Все цепочки длины <= checkedLength проверены
+    bool complete = false;          // Проверены все длины до maxLength
+    bool timedOut = false;
+    bool budgetExceeded = false;
+};
+
+/**
+ * @brief Поиск неоднозначностей с ограничением длины предложений
+ *
+ * Развёртка грамматики по длинам: для каждого узла RE-дерева и длины n
+ * хранится множество выводимых цепочек с числом выводов (до двух).
+ * Ссылка на нетерминал даёт каждую его цепочку ровно один раз, поэтому
+ * два вывода находятся в том правиле, где разборы впервые расходятся, а
+ * правила, неоднозначные только из-за своих нетерминалов, не
+ * сообщаются. Для нетерминала, достижимого из стартового символа и
+ * выводящего предложение, это означает неоднозначность грамматики.
+ *
+ * Длины перебираются по возрастанию, так что найденная цепочка
+ * кратчайшая; внутри одной длины зависимости через пустые контексты
+ * решаются итерацией до неподвижной точки, нетерминалы одной итерации
+ * обрабатываются параллельно. Как и в SentenceGenerator, итерация A#B
+ * есть A(BA)* с непустыми повторениями BA, семантики и пустой терминал
+ * выводят пустую цепочку. Если же повторение BA может быть пустым,
+ * каждая цепочка итерации имеет бесконечно много выводов, и правило
+ * сообщается с кратчайшей из них.
+ */
+class AmbiguityDetector {
+public:
+    static AmbiguityReport analyze(const Grammar* grammar, const AmbiguityOptions& options = {});
+};
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <syngt/analysis/ParsingTable.h>
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Контрпример для одного конфликта LL(1) M[A, t]
+ *
+ * derivation - кратчайшая цепочка нетерминалов от стартового до A.
+ * prefix - терминальная цепочка, выводимая слева от A в этом контексте.
+ * firstWitness / secondWitness - два полных предложения языка с общим
+ * префиксом prefix, в которых A раскрывается через разные альтернативы,
+ * а сразу после prefix стоит конфликтный терминал t.
+ */
+struct ConflictExplanation {
+    std::string nonTerminal;
+    int terminal = -1;                  // -1 = $
+    std::string firstAlternative;
+    std::string secondAlternative;
+    bool viaFollow = false;             // Одна из альтернатив пуста, t берется из FOLLOW
+    bool found = false;
+    std::vector<std::string> derivation;
+    std::vector<int> prefix;
+    std::vector<int> firstWitness;
+    std::vector<int> secondWitness;
+};
+
+/**
+ * @brief Генератор контрпримеров для конфликтов таблицы LL(1)
+ *
+ * Использует минимальные по длине выводимые цепочки нетерминалов и
+ * поиск в ширину по контекстам вхождений, поэтому работает за время,
+ * близкое к линейному от размера грамматики.
+ */
+class ConflictExplainer {
+public:
+    static std::vector<ConflictExplanation> explain(Grammar* grammar, const ParsingTable& table);
+
+    static ConflictExplanation explain(Grammar* grammar, const ParsingTable::Conflict& conflict);
+
+    /**
+     * @brief Читаемое многострочное описание контрпримера
+     */
+    static std::string format(const Grammar* grammar, const ConflictExplanation& explanation);
+};
+
+}
@@ -1,7 +1,10 @@
 #pragma once
 #include <syngt/analysis/Minimization.h>
-#include <vector>
+#include <chrono>
 #include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Преобразование конечного автомата в регулярное выражение
@@ -14,19 +17,80 @@ namespace syngt {
 
 class Grammar;
 class RETree;
+class SymbolSnapshot;
+
+/**
+ * @brief Порядок удаления состояний
+ * 
+ * Размер итогового RE сильно зависит от порядка удаления, а лучшего
+ * порядка для всех автоматов нет, поэтому можно перебрать несколько.
+ */
+enum EliminationOrder {
+    eoGreedyCost = 0,           // Минимальный прирост размера выражений (как в Pascal)
+    eoMinDegree = 1,            // Минимальное число новых дуг: in * out
+    eoWeight = 2,               // Вес Дельгадо-Мораиса: размер всех новых дуг минус удаляемых
+    eoReverseTopological = 3    // Обратный порядок обхода в глубину от начального состояния
+};
+
+constexpr int EliminationOrderCount = 4;
+
+const char* eliminationOrderName(EliminationOrder order);
+
+/**
+ * @brief Параметры перебора порядков удаления
+ */
+struct EliminationOptions {
+    std::vector<EliminationOrder> orders{
+        eoGreedyCost, eoMinDegree, eoWeight, eoReverseTopological
+    };
+    unsigned threads = 0;       // 0 - по числу ядер
+    double timeBudgetMs = 0;    // 0 - без ограничения; первый порядок всегда доводится до конца
+};
+
+/**
+ * @brief Результат одного порядка удаления
+ */
+struct EliminationStats {
+    EliminationOrder order = eoGreedyCost;
+    bool completed = false;     // false - прерван по времени
+    int operationCount = 0;     // Размер полученного RE
+    double milliseconds = 0;
+};
+
+struct ArcExpr;
+using ArcExprPtr = std::shared_ptr<const ArcExpr>;
+
+/**
+ * @brief Неизменяемый узел регулярного выражения на дуге
+ * 
+ * При удалении состояния выражения дуг не копируются: новые дуги
+ * ссылаются на общие поддеревья. RE-дерево строится один раз
+ * в getRegularExpression().
+ */
+struct ArcExpr {
+    enum Kind { Leaf, And, Or, Iteration };
+    
+    Kind kind = Leaf;
+    std::unique_ptr<RETree> leaf;  // Только для Leaf
+    ArcExprPtr left;
+    ArcExprPtr right;
+    int operationCount = 1;        // Как RETree::getOperationCount()
+    bool epsilon = false;          // Лист - пустая цепочка
+};
 
 /**
  * @brief Дуга (переход) автомата
  * 
  * Представляет переход между двумя состояниями с регулярным выражением.
+ * Удаленная дуга имеет пустое выражение.
  */
 struct Arc {
     State fromState;               // Начальное состояние
     State toState;                 // Конечное состояние
-    std::unique_ptr<RETree> tree;  // Регулярное выражение перехода
+    ArcExprPtr expr;               // Регулярное выражение перехода
     
-    Arc(State from, State to, std::unique_ptr<RETree> t)
-        : fromState(from), toState(to), tree(std::move(t)) {}
+    Arc(State from, State to, ArcExprPtr e)
+        : fromState(from), toState(to), expr(std::move(e)) {}
 };
 
 /**
@@ -39,15 +103,72 @@ struct Arc {
  *    - Для каждой пары входящих/исходящих дуг создаем новую дугу
  *    - Учитываем петли (циклы) как итерации
  * 4. В конце остается одна дуга Start→Final с итоговым RE
+ * 
+ * Дуги хранятся в порядке создания, у каждого состояния есть списки
+ * входящих и исходящих дуг. Стоимости удаления состояний хранятся
+ * в упорядоченной очереди и пересчитываются только для соседей
+ * измененных дуг, поэтому один шаг удаления работает за время,
+ * пропорциональное степеням затронутых состояний.
  */
 class DFAToRegex {
 private:
     Grammar* m_grammar;
-    std::vector<std::unique_ptr<Arc>> m_arcs;  // Список дуг
-    std::vector<State> m_states;               // Список состояний
+    std::vector<Arc> m_arcs;                        // Все дуги; индекс - номер дуги
+    std::vector<std::vector<size_t>> m_inArcs;      // Входящие дуги состояния (по номеру)
+    std::vector<std::vector<size_t>> m_outArcs;     // Исходящие дуги состояния (по номеру)
+    std::vector<long long> m_costs;                 // Стоимость удаления состояния
+    std::set<std::pair<long long, State>> m_queue;  // (стоимость, -состояние)
+    std::vector<State> m_dirtyStates;               // Состояния с устаревшей стоимостью
+    std::vector<bool> m_isDirty;
+    std::vector<State> m_mergeStates;               // Состояния с новыми исходящими дугами
+    std::vector<bool> m_needsMerge;
+    std::vector<bool> m_removed;
+    std::vector<long long> m_ranks;                 // Для eoReverseTopological
+    EliminationOrder m_order = eoGreedyCost;
+    ArcExprPtr m_epsilon;
+    
+    /**
+     * @brief Удалить все состояния в порядке m_order
+     * @return false если истек срок deadline (при limited)
+     */
+    bool eliminate(bool limited, std::chrono::steady_clock::time_point deadline);
+    
+    /**
+     * @brief Номера состояний в обратном порядке обхода в глубину
+     */
+    void computeReverseTopologicalRanks();
+    
+    /**
+     * @brief Добавить состояния 0..count-1
+     */
+    void initStates(int count);
+    
+    /**
+     * @brief Добавить дугу в конец списка дуг
+     */
+    void addArc(State from, State to, ArcExprPtr expr);
+    
+    /**
+     * @brief Удалить дугу из списков смежности
+     */
+    void eraseArc(size_t arcIndex);
+    
+    /**
+     * @brief Пометить состояние для пересчета стоимости
+     */
+    void markDirty(State state);
+    
+    /**
+     * @brief Пересчитать стоимость помеченных состояний
+     */
+    void updateCosts();
     
     /**
      * @brief Объединить все дуги с одинаковыми from/to через OR
+     * 
+     * Рассматриваются только состояния с новыми исходящими дугами.
+     * Дуги сливаются в дугу с меньшим номером в том же порядке,
+     * что и при полном просмотре списка дуг.
      */
     void mergeParallelArcs();
     
@@ -57,24 +178,13 @@ private:
      * Создает новые дуги, обходящие удаляемое состояние:
      * Для каждой пары (X→S, S→Y) создается дуга X→Y
      * с выражением: X→S, (S→S)*, S→Y
-     * 
-     * @param stateIndex Индекс состояния в m_states
      */
-    void removeState(size_t stateIndex);
+    void removeState(State state);
     
     /**
-     * @brief Найти оптимальное состояние для удаления
-     * 
-     * Выбирает состояние с минимальной "стоимостью" удаления.
-     * Стоимость = количество новых дуг, которые будут созданы.
-     * 
-     * @return Индекс оптимального состояния
-     */
-    size_t findBestStateToRemove();
-    
-    /**
-     * @brief Вычислить стоимость удаления состояния
+     * @brief Вычислить стоимость удаления состояния для m_order
      * 
+     * Для eoGreedyCost:
      * Стоимость = inCount * outCount * roundLength + 
      *             inLength * (outCount-1) + 
      *             outLength * (inCount-1)
@@ -84,69 +194,67 @@ private:
      * - outCount: количество исходящих дуг  
      * - roundLength: длина петли (если есть)
      * 
-     * @return Стоимость или -1 если нужен перерасчет
+     * Для состояний без входящих или исходящих дуг стоимость 0.
+     * Удаляется состояние с наименьшей стоимостью, при равенстве -
+     * с наибольшим номером.
      */
-    int getStateRemovalCost(State state);
+    long long getStateRemovalCost(State state) const;
     
     /**
      * @brief Проверить и оптимизировать бинарную итерацию
      * 
-     * Если состояние имеет:
-     * - Ровно 1 входящую дугу (A→S)
-     * - Ровно 1 исходящую дугу (S→B)
-     * - Обратную дугу (B→S)
+     * Если состояние S имеет:
+     * - Ровно 1 входящую дугу (A→S), и у A нет других исходящих дуг
+     * - Не более 1 исходящей дуги
+     * - Обратную дугу (S→A)
      * - Нет петли на S
      * 
-     * То создается итерация: A→S, (S→B, B→S)*, S→B
+     * То дуга A→S заменяется итерацией (A→S) # (S→A)
      * 
      * @return true если оптимизация применена
      */
-    bool tryOptimizeBinaryIteration(Arc* arc);
+    bool tryOptimizeBinaryIteration(State state);
     
-    /**
-     * @brief Создать epsilon терминал
-     */
-    std::unique_ptr<RETree> createEpsilon();
+    ArcExprPtr makeLeaf(std::unique_ptr<RETree> tree) const;
+    ArcExprPtr makeNode(ArcExpr::Kind kind, ArcExprPtr left, ArcExprPtr right) const;
     
     /**
      * @brief Создать унарную итерацию (E)*
      */
-    std::unique_ptr<RETree> createUnaryIteration(std::unique_ptr<RETree> tree);
+    ArcExprPtr createUnaryIteration(ArcExprPtr expr) const;
     
     /**
      * @brief Создать последовательность E1, E2
      */
-    std::unique_ptr<RETree> createAnd(
-        std::unique_ptr<RETree> left, 
-        std::unique_ptr<RETree> right
-    );
+    ArcExprPtr createAnd(ArcExprPtr left, ArcExprPtr right) const;
     
     /**
-     * @brief Создать альтернативу E1 ; E2
+     * @brief Выражение первой оставшейся дуги или epsilon
      */
-    std::unique_ptr<RETree> createOr(
-        std::unique_ptr<RETree> left,
-        std::unique_ptr<RETree> right
-    );
+    const ArcExpr* resultExpression() const;
     
     /**
-     * @brief Создать бинарную итерацию E1 # E2
+     * @brief Построить RE-дерево по выражению дуги
      */
-    std::unique_ptr<RETree> createIteration(
-        std::unique_ptr<RETree> left,
-        std::unique_ptr<RETree> right
-    );
+    std::unique_ptr<RETree> buildTree(const ArcExpr* expr) const;
     
 public:
     /**
      * @brief Создать преобразователь из таблицы минимизации
      * 
+     * Без symbols недостающие символы добавляются в грамматику. Со
+     * снимком symbols грамматика только читается, и преобразователи для
+     * разных таблиц можно строить параллельно; если символа нет в снимке,
+     * возвращается nullptr.
+     * 
      * @param grammar Грамматика для создания RE
      * @param table Таблица минимизированного автомата
+     * @param symbols Снимок символов грамматики или nullptr
      */
     static std::unique_ptr<DFAToRegex> fromMinimizationTable(
         Grammar* grammar,
-        const MinimizationTable* table
+        const MinimizationTable* table,
+        const SymbolSnapshot* symbols = nullptr
     );
     
     /**
@@ -155,7 +263,20 @@ public:
      * Последовательно удаляет состояния, пока не останется
      * только Start→Final с итоговым регулярным выражением.
      */
-    void removeAllStates();
+    void removeAllStates(EliminationOrder order = eoGreedyCost);
+    
+    /**
+     * @brief Удалить состояния несколькими порядками и оставить лучший
+     * 
+     * Каждый порядок работает на своей копии автомата (выражения дуг
+     * общие и не копируются), крупные автоматы обрабатываются
+     * параллельно. Остается результат с наименьшим getOperationCount(),
+     * при равенстве - более ранний в options.orders, поэтому без
+     * ограничения по времени результат не зависит от числа потоков.
+     * 
+     * @return Статистика по каждому порядку из options.orders
+     */
+    std::vector<EliminationStats> removeAllStates(const EliminationOptions& options);
     
     /**
      * @brief Получить итоговое регулярное выражение
@@ -166,7 +287,7 @@ public:
      */
     std::unique_ptr<RETree> getRegularExpression();
     
-    DFAToRegex(Grammar* grammar) : m_grammar(grammar) {}
+    DFAToRegex(Grammar* grammar);
     ~DFAToRegex() = default;
 };
 
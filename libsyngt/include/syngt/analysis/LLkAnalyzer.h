@@ -0,0 +1,75 @@
+#pragma once
+#include <syngt/analysis/TokenTrie.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Ограничения анализа LL(k)
+ *
+ * Множества FIRST_k/FOLLOW_k растут экспоненциально по k, поэтому
+ * анализ ограничен максимальным k, размером любого множества и временем.
+ */
+struct LLkOptions {
+    int maxK = 3;                       // Значения меньше 1 считаются равными 1
+    size_t maxSetSize = 20000;          // Максимум цепочек в одном множестве
+    size_t maxReportedPrefixes = 8;     // Сколько конфликтных префиксов сохранять
+    int timeLimitMs = 5000;             // 0 - без ограничения
+};
+
+/**
+ * @brief Точка выбора в правиле нетерминала, конфликтующая при k = 1
+ *
+ * kind = "alternative" - выбор между альтернативами ';'
+ * kind = "iteration"   - выбор между продолжением и выходом из '*'
+ */
+struct LLkDecision {
+    std::string nonTerminal;
+    std::string kind;
+    std::string location;                           // Текст узла выбора
+    std::vector<std::string> alternatives;          // Конфликтующие ветви
+    int minimalK = 0;                               // 0 - не разрешается до maxK
+    bool budgetExceeded = false;
+    std::vector<std::vector<int>> conflictingPrefixes;  // Префиксы при наибольшем конфликтном k
+};
+
+struct LLkReport {
+    std::vector<LLkDecision> decisions;
+    int grammarK = 1;               // Минимальное k для всей грамматики, 0 - не найдено
+    int checkedK = 0;               // До какого k удалось досчитать
+    bool budgetExceeded = false;
+};
+
+/**
+ * @brief Анализ сильной LL(k) разрешимости конфликтов
+ *
+ * Для каждой точки выбора, конфликтующей в LL(1), ищет минимальное k,
+ * при котором множества предпросмотра ветвей не пересекаются.
+ * Множества FIRST_k/FOLLOW_k строятся прямо по RE-деревьям и хранятся
+ * в префиксных деревьях (TokenTrie).
+ */
+class LLkAnalyzer {
+public:
+    static LLkReport analyze(Grammar* grammar, const LLkOptions& options = LLkOptions());
+
+    /**
+     * @brief FIRST_k для всех нетерминалов (индексация как в getNonTerminals())
+     */
+    static std::vector<TokenTrie> computeFirstK(Grammar* grammar, int k);
+
+    /**
+     * @brief FOLLOW_k для всех нетерминалов (индексация как в getNonTerminals())
+     */
+    static std::vector<TokenTrie> computeFollowK(Grammar* grammar, int k);
+
+    /**
+     * @brief Цепочка терминалов в виде "'a' 'b' $"
+     */
+    static std::string formatSequence(const Grammar* grammar, const std::vector<int>& sequence);
+};
+
+}
@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <memory>
+#include <unordered_map>
 
 namespace syngt {
 
@@ -15,6 +16,9 @@ constexpr State StartState = 0;
 constexpr State FinalState = 1;
 
 constexpr const char* EmptySymbol = "";
+constexpr const char* EpsilonSymbol = "\"\"";   // Пустой переход в таблице Minimize
+
+constexpr size_t DefaultDeterminizeBudget = 4096;
 
 class StatesSet {
 private:
@@ -52,13 +56,20 @@ struct MinRecord {
     MinRecord(State s, State f) : start(s), finish(f) {}
 };
 
+/**
+ * @brief Таблица переходов НКА, построенного по RE-дереву правила
+ *
+ * Символы хранятся под целыми номерами, строка таблицы каждого состояния -
+ * плотный массив по номерам символов.
+ */
 class MinimizationTable {
 private:
-    // Таблица переходов: [состояние][символ] → набор состояний
-    std::map<std::pair<State, std::string>, std::unique_ptr<StatesSet>> m_table;
+    // Таблица переходов: m_rows[состояние][символ] → набор состояний
+    std::vector<std::vector<StatesSet>> m_rows;
     
-    // Список символов алфавита
+    // Список символов алфавита и обратный индекс
     std::vector<std::string> m_symbols;
+    std::unordered_map<std::string, int> m_symbolIds;
     
     // Имена состояний (StartState, FinalState, State2, State3, ...)
     std::map<State, std::string> m_stateNames;
@@ -68,9 +79,13 @@ private:
     
     int findOrAddSymbol(const std::string& symbol);
     
-    void determinize();
+    bool isDeterministic() const;
     
-    void minimizeByEquivalence();
+    /**
+     * @brief Крупнейшее разбиение состояний на классы бисимуляции
+     * @return Для каждого состояния - минимальное состояние его класса
+     */
+    std::vector<State> computeEquivalence() const;
     
 public:
     MinimizationTable() = default;
@@ -96,8 +111,36 @@ public:
         return static_cast<int>(m_symbols.size());
     }
     
+    /**
+     * @brief Число состояний, встречающихся в таблице (с переходами или как цели)
+     */
+    int getUsedStatesCount() const;
+    
+    /**
+     * @brief Объединить состояния с одинаковыми переходами
+     *
+     * Два состояния эквивалентны, если по каждому символу они переходят в
+     * одни и те же классы эквивалентности; FinalState ни с чем не
+     * объединяется. Классы ищутся уточнением разбиения: алгоритмом Хопкрофта
+     * для детерминированной таблицы и уточнением по всем частям для НКА.
+     * Представитель класса - его минимальное состояние.
+     */
     void minimize();
     
+    /**
+     * @brief Заменить НКА эквивалентным ДКА построением подмножеств
+     *
+     * Пустые переходы (EpsilonSymbol) убираются ε-замыканием, состояния ДКА -
+     * битовые множества состояний НКА, ищутся по хэшу. Строятся только
+     * достижимые подмножества; подмножества, из которых FinalState
+     * недостижим, отбрасываются. Допускающее состояние получает пустой
+     * переход в FinalState, подмножество {FinalState} становится им самим.
+     *
+     * @param maxStates Ограничение на число состояний ДКА
+     * @return false, если ограничение превышено (таблица не меняется)
+     */
+    bool determinize(size_t maxStates = DefaultDeterminizeBudget);
+    
     void writeToFile(const std::string& filename) const;
     
     std::string toString() const;
@@ -1,24 +1,83 @@
 #pragma once
+#include <syngt/analysis/DFAToREGEX.h>
+#include <array>
+#include <cstddef>
 
 namespace syngt {
 
 class Grammar;
+class MinimizationTable;
+class RETree;
+
+enum MinimizeAutomaton {
+    maNFA = 0,          // Слияние эквивалентных состояний НКА (как в Pascal)
+    maDFA = 1,          // Построение подмножеств и минимизация ДКА
+    maSmallest = 2      // Оба варианта, для каждого правила остается меньшее RE
+};
+
+enum MinimizeConstruction {
+    mcThompson = 0,     // Состояние на каждую ',' и итерацию, пустые переходы (как в Pascal)
+    mcGlushkov = 1      // Автомат позиций: состояние на каждый символ, без пустых переходов
+};
+
+struct MinimizeOptions {
+    MinimizeAutomaton automaton = maSmallest;
+    MinimizeConstruction construction = mcThompson;
+    size_t maxDfaStates = 4096;         // Сверх этого правило минимизируется как НКА
+    EliminationOptions elimination;     // Порядки удаления состояний при обратном переводе в RE
+    unsigned threads = 1;               // Правила обрабатываются параллельно; 0 - по числу ядер
+};
+
+struct MinimizeStats {
+    int rules = 0;
+    int nfaStates = 0;                  // Суммарно по правилам
+    int dfaStates = 0;                  // После построения подмножеств
+    int minimizedStates = 0;            // В выбранных автоматах после слияния состояний
+    int dfaChosen = 0;                  // Правил, где результат взят из ДКА
+    int budgetExceeded = 0;             // Правил, для которых ДКА не построен
+    std::array<int, EliminationOrderCount> orderWins{};  // Автоматов, где порядок дал лучшее RE
+    int eliminationTimeouts = 0;        // Порядков, прерванных по времени
+};
 
 /**
  * @brief Минимизация регулярных выражений через автоматный подход
  *
  * Реализует алгоритм TGrammar.minimize() из оригинального Pascal-инструмента:
- *   1. Для каждого нетерминала строится NFA (таблица переходов) из его RE-дерева
- *   2. NFA минимизируется слиянием эквивалентных состояний
- *   3. Результирующий автомат конвертируется обратно в RE методом устранения состояний
+ *   1. Для каждого нетерминала строится NFA (таблица переходов) из его RE-дерева:
+ *      по Томпсону или, при mcGlushkov, автомат позиций (first/last/follow
+ *      за один проход по дереву, размер линеен по числу листьев)
+ *   2. NFA минимизируется слиянием эквивалентных состояний; в режимах
+ *      maDFA/maSmallest он сначала детерминизируется (если ДКА укладывается
+ *      в ограничение). Минимальный ДКА не всегда дает более короткое RE:
+ *      пустые переходы НКА сохраняют вынесенные необязательные части,
+ *      поэтому maSmallest строит оба варианта
+ *   3. Результирующий автомат конвертируется обратно в RE методом устранения состояний;
+ *      перебираются порядки удаления из options.elimination, остается
+ *      наименьшее RE
  *   4. Полученное RE устанавливается как новое правило нетерминала
+ *
+ * При options.threads != 1 шаги 1-3 выполняются для разных правил
+ * параллельно: грамматика только читается, символы ищутся в снимке
+ * SymbolSnapshot. Правила устанавливаются по порядку после завершения
+ * всех потоков; правило, которому нужен новый символ, пересчитывается
+ * последовательно, поэтому результат совпадает с однопоточным.
  */
 class Minimize {
 public:
     /**
      * @brief Минимизировать все нетерминалы грамматики
      */
-    static void minimize(Grammar* grammar);
+    static MinimizeStats minimize(Grammar* grammar, const MinimizeOptions& options = MinimizeOptions());
+
+    /**
+     * @brief Построить НКА для RE-дерева (шаг 1) в пустой таблице
+     *
+     * Переходы ведут из StartState в FinalState; терминалы хранятся в
+     * кавычках, нетерминалы и семантики - по имени, пустой переход -
+     * EpsilonSymbol. Грамматика только читается.
+     */
+    static void buildTable(const RETree* root, MinimizationTable& table, Grammar* grammar,
+                           MinimizeConstruction construction = mcThompson);
 };
 
 } // namespace syngt
@@ -18,6 +18,19 @@ public:
     // Значение: правило (дерево)
     using TableValue = const RETree*;
     
+    /**
+     * @brief Конфликт: две альтернативы претендуют на одну ячейку M[A, t]
+     *
+     * Указатели ссылаются на альтернативы в дереве правила нетерминала
+     * и действительны, пока правило не изменено.
+     */
+    struct Conflict {
+        std::string nonTerminal;
+        int terminal;               // -1 = $
+        const RETree* existing;     // Альтернатива, уже занимавшая ячейку
+        const RETree* incoming;     // Альтернатива, вызвавшая конфликт
+    };
+    
     /**
      * @brief Построить таблицу разбора для грамматики
      */
@@ -44,6 +57,11 @@ public:
      */
     const std::vector<std::string>& getConflicts() const { return m_conflicts; }
     
+    /**
+     * @brief Получить конфликты в структурированном виде (в том же порядке)
+     */
+    const std::vector<Conflict>& getConflictDetails() const { return m_conflictDetails; }
+    
     /**
      * @brief Вывести таблицу в читаемом виде
      */
@@ -57,6 +75,7 @@ public:
 private:
     std::map<TableKey, TableValue> m_table;
     std::vector<std::string> m_conflicts;
+    std::vector<Conflict> m_conflictDetails;
     Grammar* m_grammar = nullptr;
     
     ParsingTable() = default;
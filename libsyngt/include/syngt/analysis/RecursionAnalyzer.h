@@ -19,6 +19,11 @@ struct RecursionResult {
  *
  * Для каждого нетерминала определяет тип рекурсии (прямая/косвенная)
  * и её направление (левая/центральная/правая).
+ *
+ * Строит три графа вхождений (ReferenceGraph: любые, крайние левые и
+ * крайние правые вхождения) и ищет в них компоненты сильной связности:
+ * петля даёт прямую рекурсию, нетривиальная компонента — косвенную.
+ * Время линейно по размеру грамматики.
  */
 class RecursionAnalyzer {
 public:
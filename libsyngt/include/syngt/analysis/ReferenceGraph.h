@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+class RETree;
+
+/**
+ * @brief Какие вхождения нетерминалов учитываются в графе
+ */
+enum ReferencePosition {
+    rpAnywhere,     // Любое вхождение в правую часть
+    rpLeftmost,     // Вхождение, перед которым может стоять только пустая цепочка
+    rpRightmost     // Вхождение, после которого может стоять только пустая цепочка
+};
+
+/**
+ * @brief Граф вхождений нетерминалов по идентификаторам
+ *
+ * Вершины — индексы getNonTerminals(), дуга A -> B означает, что B
+ * входит в правило A в заданной позиции. Для крайних позиций
+ * обнуляемость частей правила берётся из YieldAnalysis: нетерминал
+ * обнуляем, если выводит пустую цепочку; семантики и пустой терминал
+ * пусты; итерация A#B обнуляема вместе с A.
+ */
+class ReferenceGraph {
+public:
+    static ReferenceGraph build(const Grammar* grammar, ReferencePosition position = rpAnywhere);
+
+    int size() const { return static_cast<int>(m_successors.size()); }
+
+    /**
+     * @brief Нетерминалы, на которые ссылается правило nt (по возрастанию, без повторов)
+     */
+    const std::vector<int>& successors(int nt) const { return m_successors[nt]; }
+
+    bool hasSelfLoop(int nt) const;
+
+    /**
+     * @brief Компоненты сильной связности (итеративный Тарьян)
+     *
+     * Компонента выдаётся после всех компонент, достижимых из неё.
+     */
+    std::vector<std::vector<int>> stronglyConnectedComponents() const;
+
+    /**
+     * @brief То же для произвольного графа, заданного списками смежности
+     */
+    static std::vector<std::vector<int>> stronglyConnectedComponents(
+        const std::vector<std::vector<int>>& successors);
+
+private:
+    std::vector<std::vector<int>> m_successors;
+};
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <syngt/analysis/Minimization.h>
+#include <syngt/analysis/Minimize.h>
+#include <syngt/analysis/TokenDFA.h>
+#include <syngt/regex/RETree.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+enum RegularStatus {
+    rsRegular = 0,          // Язык регулярен, RE и ДКА построены
+    rsSelfEmbedding = 1,    // Компонента рекурсии не лево- и не праволинейна
+    rsNonRegularReference = 2,  // Достигает самовставляющей компоненты
+    rsTooLarge = 3,         // Регулярен, но RE или ДКА превысили ограничение
+    rsUndefined = 4         // Нет правила: внешний символ (LETTER, DIGIT, ...)
+};
+
+struct RegularSubgrammarOptions {
+    size_t maxNodes = 20000;            // Ограничение на размер подставленного RE
+    size_t maxDfaStates = DefaultDeterminizeBudget;
+    MinimizeConstruction construction = mcGlushkov;
+};
+
+/**
+ * @brief Нетерминалы с регулярным языком и их ДКА
+ *
+ * Компоненты сильной связности графа вхождений обходятся от листьев.
+ * Нерекурсивная компонента регулярна, если регулярны все нетерминалы,
+ * на которые она ссылается. В рекурсивной компоненте каждое вхождение
+ * её нетерминала должно стоять в самом конце правила (праволинейная
+ * компонента) или в самом начале (леволинейная); иначе компонента
+ * считается самовставляющей. Проверка консервативна: например,
+ * A : A , 'x' ; 'y' , A ; 'z' регулярен, но отвергается.
+ *
+ * Для регулярной компоненты правила записываются системой уравнений
+ * X = c + Σ b·Y (или X = c + Σ Y·b), куда уже подставлены RE
+ * нижележащих нетерминалов, и решаются исключением по лемме Ардена.
+ * По полученному RE строится НКА (Minimize::buildTable), затем
+ * determinize и minimize; результат - TokenDFA. Семантики считаются
+ * пустыми, нетерминалы без правил остаются символами алфавита.
+ *
+ * Грамматика только читается.
+ */
+class RegularSubgrammar {
+public:
+    static RegularSubgrammar analyze(Grammar* grammar,
+                                     const RegularSubgrammarOptions& options = RegularSubgrammarOptions());
+
+    int size() const { return static_cast<int>(m_entries.size()); }
+
+    RegularStatus status(int nt) const { return m_entries[nt].status; }
+
+    /**
+     * @brief Правило без нетерминалов с правилами
+     *
+     * nullptr, если язык пуст или RE не построено (статус не rsRegular и
+     * не rsTooLarge из-за ДКА)
+     */
+    const RETree* regex(int nt) const { return m_entries[nt].regex.get(); }
+
+    /**
+     * @brief Минимальный ДКА; nullptr, если статус не rsRegular
+     */
+    const TokenDFA* dfa(int nt) const { return m_entries[nt].dfa.get(); }
+
+    /**
+     * @brief Индексы нетерминалов со статусом rsRegular по возрастанию
+     */
+    std::vector<int> regularNonTerminals() const;
+
+private:
+    struct Entry {
+        RegularStatus status = rsUndefined;
+        std::unique_ptr<RETree> regex;
+        std::unique_ptr<TokenDFA> dfa;
+    };
+
+    std::vector<Entry> m_entries;   // Индексация как в getNonTerminals()
+};
+
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+class RETree;
+
+/**
+ * @brief Результат сравнения языков двух правил
+ */
+struct EquivalenceResult {
+    bool equivalent = true;
+    bool complete = true;                       // false: превышен лимит состояний, ответ не получен
+    std::vector<std::string> counterexample;    // Слово, принимаемое ровно одним из правил
+    bool acceptedByFirst = false;               // Какое из правил принимает контрпример
+    int pairsExplored = 0;                      // Просмотрено пар состояний
+};
+
+/**
+ * @brief Проверка одного правила преобразованной грамматики
+ */
+struct RuleVerification {
+    std::string name;
+    bool missing = false;                       // Правила нет в преобразованной грамматике
+    EquivalenceResult result;
+};
+
+/**
+ * @brief Точная проверка эквивалентности регулярных правил
+ *
+ * Язык правила рассматривается над именами терминалов, нетерминалов и
+ * семантик (ссылка на нетерминал — один символ), пустой терминал и "@"
+ * обозначают пустое слово. По каждому дереву строится автомат позиций
+ * Глушкова; детерминированные состояния (множества позиций) обоих
+ * автоматов порождаются по мере надобности и склеиваются алгоритмом
+ * Хопкрофта–Карпа с объединением-поиском. Обход в ширину даёт короткий
+ * контрпример.
+ */
+class RuleEquivalence {
+public:
+    static constexpr int DefaultStateLimit = 100000;
+
+    /**
+     * @brief Сравнить языки двух деревьев (возможно, из разных грамматик)
+     */
+    static EquivalenceResult check(const RETree* first, const Grammar* firstGrammar,
+                                   const RETree* second, const Grammar* secondGrammar,
+                                   int stateLimit = DefaultStateLimit);
+
+    /**
+     * @brief Сравнить каждое правило исходной грамматики с одноимённым правилом преобразованной
+     *
+     * Нетерминалы, появившиеся при преобразовании (например, factored_N),
+     * подставляются в правила на место ссылок, если они не рекурсивны.
+     * Автоматы строятся последовательно, сравнение идёт в threads потоках
+     * (0 — по числу ядер).
+     */
+    static std::vector<RuleVerification> verify(const Grammar* original, const Grammar* transformed,
+                                                unsigned threads = 1,
+                                                int stateLimit = DefaultStateLimit);
+
+    /**
+     * @brief Слово через пробел, "@" для пустого
+     */
+    static std::string wordToString(const std::vector<std::string>& word);
+};
+
+}
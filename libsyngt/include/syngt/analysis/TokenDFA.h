@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace syngt {
+
+class MinimizationTable;
+
+/**
+ * @brief Табличный ДКА для распознавания нетерминала как одной лексемы
+ *
+ * Строится по детерминированной таблице MinimizationTable (после
+ * determinize и minimize). Состояния перенумерованы обходом в ширину от
+ * начального (оно имеет номер 0), переходы хранятся плотной матрицей
+ * "состояние x символ", так что шаг автомата - одно обращение к массиву.
+ *
+ * Символы алфавита - символы таблицы без пустого: терминалы в кавычках
+ * ("\"x\""), нетерминалы без правил - по имени.
+ */
+class TokenDFA {
+public:
+    static constexpr int DeadState = -1;
+    static constexpr size_t NoMatch = static_cast<size_t>(-1);
+
+    TokenDFA() = default;
+
+    /**
+     * @brief Перевести детерминированную таблицу в матрицу переходов
+     * @throws std::invalid_argument если в таблице есть недетерминированный переход
+     */
+    static TokenDFA fromMinimizationTable(const MinimizationTable& table);
+
+    int stateCount() const { return static_cast<int>(m_accepting.size()); }
+    int symbolCount() const { return static_cast<int>(m_symbols.size()); }
+
+    const std::string& symbol(int index) const { return m_symbols[index]; }
+
+    /**
+     * @brief Номер символа таблицы или -1, если его нет в алфавите
+     */
+    int symbolIndex(const std::string& symbol) const;
+
+    /**
+     * @brief Номер терминала (имя без кавычек) или -1
+     */
+    int terminalIndex(const std::string& terminal) const;
+
+    int startState() const { return 0; }
+
+    int next(int state, int symbol) const {
+        return m_next[static_cast<size_t>(state) * m_symbols.size() + symbol];
+    }
+
+    bool accepting(int state) const { return m_accepting[state] != 0; }
+
+    /**
+     * @brief Допускается ли цепочка номеров символов
+     */
+    bool matches(const std::vector<int>& symbols) const;
+
+    /**
+     * @brief То же для цепочки имён: терминал без кавычек или нетерминал
+     */
+    bool matches(const std::vector<std::string>& tokens) const;
+
+    /**
+     * @brief Длина самого длинного допускаемого префикса symbols[from..]
+     * @return NoMatch, если не допускается ни один префикс
+     */
+    size_t longestMatch(const std::vector<int>& symbols, size_t from = 0) const;
+
+private:
+    std::vector<int> m_next;                // [состояние * число символов + символ] -> состояние
+    std::vector<char> m_accepting;
+    std::vector<std::string> m_symbols;
+    std::unordered_map<std::string, int> m_symbolIds;
+};
+
+}
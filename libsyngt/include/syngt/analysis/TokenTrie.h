@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace syngt {
+
+/**
+ * @brief Множество цепочек терминалов длины не более k (префиксное дерево)
+ *
+ * Используется для FIRST_k / FOLLOW_k. Каждая цепочка хранится как путь
+ * от корня; узел, на котором цепочка заканчивается, помечен как конечный.
+ * Маркер конца входа ($) кодируется как EndOfInput (-1), как и в FirstFollow.
+ *
+ * Чтобы множества не разрастались неограниченно, можно задать лимит числа
+ * цепочек: при его превышении insert() бросает std::length_error.
+ */
+class TokenTrie {
+public:
+    static constexpr int EndOfInput = -1;
+
+    TokenTrie();
+
+    /**
+     * @brief Добавить цепочку
+     * @return true если цепочка была новой
+     */
+    bool insert(const std::vector<int>& sequence);
+
+    bool contains(const std::vector<int>& sequence) const;
+
+    /**
+     * @brief Содержит ли множество пустую цепочку
+     */
+    bool containsEmpty() const { return m_nodes[0].terminal; }
+
+    /**
+     * @brief Объединить с другим множеством
+     * @return true если множество изменилось
+     */
+    bool unite(const TokenTrie& other);
+
+    /**
+     * @brief k-усеченная конкатенация: { (x · y) : k | x ∈ this, y ∈ tail }
+     *
+     * Цепочки длины k и цепочки, оканчивающиеся на $, не продолжаются.
+     */
+    TokenTrie concat(const TokenTrie& tail, int k) const;
+
+    /**
+     * @brief Пересечение двух множеств
+     */
+    TokenTrie intersect(const TokenTrie& other) const;
+
+    bool intersects(const TokenTrie& other) const;
+
+    /**
+     * @brief Все цепочки в лексикографическом порядке
+     */
+    std::vector<std::vector<int>> sequences() const;
+
+    size_t size() const { return m_size; }
+    size_t nodeCount() const { return m_nodes.size(); }
+    bool empty() const { return m_size == 0; }
+
+    void setLimit(size_t limit) { m_limit = limit; }
+    size_t limit() const { return m_limit; }
+
+private:
+    struct Node {
+        std::vector<std::pair<int, int>> children;  // (терминал, индекс узла), по возрастанию терминала
+        bool terminal = false;
+    };
+
+    std::vector<Node> m_nodes;
+    size_t m_size = 0;
+    size_t m_limit = std::numeric_limits<size_t>::max();
+
+    int findChild(int node, int symbol) const;
+    int findOrAddChild(int node, int symbol);
+    void markTerminal(int node);
+};
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+class RETree;
+
+/**
+ * @brief Выводимые цепочки одного нетерминала
+ */
+struct NTYield {
+    std::string name;
+    bool productive = false;        // Выводит хотя бы одну терминальную цепочку
+    std::vector<int> minYield;      // Кратчайшая выводимая цепочка терминалов
+    size_t minLength = 0;
+    size_t minHeight = 0;           // Высота дерева вывода minYield (нетерминалы в нём ниже)
+    size_t maxLength = 0;           // YieldAnalysis::Infinite, если длина не ограничена
+};
+
+/**
+ * @brief Кратчайшие выводимые цепочки и границы длин для нетерминалов
+ *
+ * Кратчайшие цепочки строятся алгоритмом Кнута (обобщение Дейкстры на
+ * грамматики) с приоритетом (длина, высота вывода). Итерация A#B
+ * рассматривается как A(BA)* (ноль и более повторений), семантики и
+ * пустой терминал выводят пустую цепочку.
+ *
+ * Максимальная длина бесконечна, если в компоненте сильной связности
+ * графа вхождений есть цикл с непустым контекстом или итерация,
+ * повторяемая часть которой выводит непустую цепочку.
+ */
+class YieldAnalysis {
+public:
+    static constexpr size_t Infinite = std::numeric_limits<size_t>::max();
+
+    using Table = std::vector<NTYield>;  // Индексация как в getNonTerminals()
+
+    /**
+     * @brief Результат анализа с кэшированием по (грамматика, ревизия)
+     */
+    static std::shared_ptr<const Table> analyze(const Grammar* grammar);
+
+    /**
+     * @brief Вычислить без кэша
+     */
+    static Table compute(const Grammar* grammar);
+
+    /**
+     * @brief Кратчайшая цепочка, выводимая из поддерева правила
+     * @return std::nullopt, если поддерево непродуктивно
+     */
+    static std::optional<std::vector<int>> minYieldOf(const RETree* tree,
+                                                      const Table& table,
+                                                      const Grammar* grammar);
+
+    static void clearCache();
+};
+
+}
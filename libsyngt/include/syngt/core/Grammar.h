@@ -3,6 +3,7 @@
 #include <syngt/core/NonTerminalList.h>
 #include <syngt/core/SemanticList.h>
 #include <syngt/core/MacroList.h>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,7 @@ private:
     std::unique_ptr<SemanticList> m_semantics;
     std::unique_ptr<NonTerminalList> m_nonTerminals;
     std::unique_ptr<MacroList> m_macros;
+    uint64_t m_revision = 0;
     
     void addToDictionary(int dictionaryID, CharProducer* charProducer);
     
@@ -53,18 +55,22 @@ public:
     void save(const std::string& filename);
     
     int addTerminal(const std::string& s) {
+        touch();
         return m_terminals->add(s);
     }
     
     int addSemantic(const std::string& s) {
+        touch();
         return m_semantics->add(s);
     }
     
     int addNonTerminal(const std::string& s) {
+        touch();
         return m_nonTerminals->add(s);
     }
     
     int addMacro(const std::string& s) {
+        touch();
         return m_macros->add(s);
     }
     
@@ -156,6 +162,14 @@ public:
      * @brief Проверить, есть ли правило у нетерминала
      */
     bool hasRule(const std::string& name) const;
+
+    /**
+     * @brief Свободное имя нетерминала вида prefix_<n>
+     *
+     * n начинается с текущего числа нетерминалов и увеличивается, пока
+     * имя занято. Нетерминал не добавляется.
+     */
+    std::string freshNonTerminalName(const std::string& prefix) const;
     
     /**
      * @brief Регуляризация грамматики
@@ -174,6 +188,21 @@ public:
      */
     void closeAllRefs(const std::string& ntName);
 
+    /**
+     * @brief Метка версии грамматики
+     *
+     * Меняется при изменении правил и списков символов. Метки берутся из
+     * общего для процесса счетчика, поэтому пара (адрес, ревизия) однозначно
+     * определяет состояние грамматики для кэшей результатов анализа.
+     */
+    uint64_t revision() const { return m_revision; }
+    
+    /**
+     * @brief Отметить грамматику как измененную
+     * Нужно вызывать после изменения деревьев правил «на месте»
+     */
+    void touch();
+
     TerminalList* terminals() { return m_terminals.get(); }
     const TerminalList* terminals() const { return m_terminals.get(); }
     
@@ -0,0 +1,63 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Подграмматика, достижимая из выбранных нетерминалов
+ *
+ * Замыкание по ссылкам строится обходом в ширину по индексам
+ * нетерминалов; в новую грамматику копируются только правила
+ * достигнутых нетерминалов и встречающиеся в них символы. Выбранные
+ * нетерминалы идут первыми (первый из них — стартовый), остальные в
+ * порядке обхода. Анализы и преобразования можно запускать на срезе,
+ * а результат вернуть в исходную грамматику через writeBack().
+ */
+class GrammarSlice {
+public:
+    /**
+     * @brief Срез по индексам нетерминалов исходной грамматики
+     */
+    static GrammarSlice extract(const Grammar* grammar, const std::vector<int>& roots);
+
+    /**
+     * @brief Срез по именам
+     * @throws std::invalid_argument, если нетерминала нет в грамматике
+     */
+    static GrammarSlice extract(const Grammar* grammar, const std::vector<std::string>& roots);
+
+    Grammar* grammar() const { return m_grammar.get(); }
+
+    /**
+     * @brief Индекс нетерминала среза в исходной грамматике
+     * @return -1 для нетерминалов, добавленных в срез после extract()
+     */
+    int originalNonTerminal(int slicedId) const;
+
+    /**
+     * @brief Индекс нетерминала исходной грамматики в срезе, -1 если его нет
+     */
+    int slicedNonTerminal(int originalId) const;
+
+    /**
+     * @brief Перенести правила среза в исходную грамматику
+     *
+     * Правила нетерминалов среза заменяют исходные; нетерминалы, созданные
+     * в срезе (например, factored_N), добавляются в original, при совпадении
+     * имени с посторонним нетерминалом — с суффиксом. Символы
+     * сопоставляются по именам.
+     * @return Число перенесённых правил
+     */
+    int writeBack(Grammar* original) const;
+
+private:
+    std::unique_ptr<Grammar> m_grammar;
+    std::vector<int> m_toOriginal;      // Индекс в срезе -> индекс в исходной грамматике
+    std::vector<int> m_toSliced;        // И обратно, -1 вне среза
+};
+
+}
@@ -3,6 +3,7 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace syngt {
 
@@ -13,6 +14,7 @@ class NonTerminalList {
 private:
     std::vector<std::string> m_list;
     std::vector<std::unique_ptr<NTListItem>> m_items;
+    std::unordered_map<std::string, int> m_index;   // Имя -> индекс в m_list
     Grammar* m_grammar = nullptr;
     
 public:
@@ -24,12 +26,8 @@ public:
     void clear();
     
     int find(const std::string& s) const {
-        for (size_t i = 0; i < m_list.size(); ++i) {
-            if (m_list[i] == s) {
-                return static_cast<int>(i);
-            }
-        }
-        return -1;
+        auto it = m_index.find(s);
+        return it != m_index.end() ? it->second : -1;
     }
     
     int getCount() const {
@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Неизменяемый снимок имен символов грамматики
+ *
+ * Поиск по хеш-таблицам без обращения к грамматике, поэтому снимок можно
+ * читать из нескольких потоков, пока грамматика не меняется. Символы,
+ * добавленные в грамматику после создания снимка, в нем не видны.
+ */
+class SymbolSnapshot {
+public:
+    explicit SymbolSnapshot(const Grammar* grammar);
+
+    /**
+     * @return Идентификатор или -1, если символа не было в грамматике
+     */
+    int findTerminal(const std::string& name) const;
+    int findNonTerminal(const std::string& name) const;
+    int findSemantic(const std::string& name) const;
+
+private:
+    std::unordered_map<std::string, int> m_terminals;
+    std::unordered_map<std::string, int> m_nonTerminals;
+    std::unordered_map<std::string, int> m_semantics;
+};
+
+}
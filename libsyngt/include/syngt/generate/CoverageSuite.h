@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Элемент грамматики, который должен быть пройден хотя бы одним предложением
+ *
+ * kind = "alternative"     - альтернатива ';'
+ * kind = "iteration"       - хотя бы одно повторение итерации
+ * kind = "empty iteration" - ноль повторений итерации
+ * kind = "semantic"        - семантическое действие
+ */
+struct CoverageGoal {
+    std::string nonTerminal;
+    std::string kind;
+    std::string location;           // Текст узла
+    bool covered = false;           // false - недостижим из стартового символа или непродуктивен
+};
+
+struct CoverageSentence {
+    std::vector<int> tokens;
+    std::vector<size_t> newGoals;   // Цели, впервые покрытые этим предложением
+};
+
+struct CoverageReport {
+    std::vector<CoverageGoal> goals;
+    std::vector<CoverageSentence> sentences;
+    size_t coveredGoals = 0;
+};
+
+/**
+ * @brief Небольшой набор предложений, покрывающий все точки выбора грамматики
+ *
+ * Для каждой цели строится кратчайшее предложение, вывод которого через
+ * неё проходит: кратчайший контекст нетерминала из стартового символа
+ * (Дейкстра по вхождениям), путь от корня правила до узла цели и
+ * кратчайшие выводы всех остальных частей (по YieldAnalysis). Каждое
+ * такое предложение покрывает и другие цели своего вывода; итоговый набор
+ * выбирается жадным покрытием множеств.
+ */
+class CoverageSuite {
+public:
+    static CoverageReport build(const Grammar* grammar);
+
+    /**
+     * @brief Предложение в виде терминалов через separator
+     */
+    static std::string formatSentence(const Grammar* grammar, const std::vector<int>& tokens,
+                                      const std::string& separator = " ");
+};
+
+}
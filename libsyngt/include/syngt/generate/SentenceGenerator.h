@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+class RETree;
+class REIteration;
+
+/**
+ * @brief Параметры потоковой генерации предложений
+ */
+struct GeneratorOptions {
+    size_t length = 10;             // Длина каждого предложения (в терминалах)
+    size_t count = 100;             // Сколько предложений сгенерировать
+    uint64_t seed = 1;
+    unsigned threads = 0;           // 0 - по числу ядер
+    std::string separator = " ";    // Разделитель терминалов в строке
+};
+
+/**
+ * @brief Равномерная генерация случайных предложений заданной длины
+ *
+ * Для каждого узла RE-дерева заранее считается число выводов цепочек
+ * каждой длины до maxLength (в double, чтобы не переполняться на длинных
+ * предложениях). Выбор ветвей ';', точек разбиения ',' и числа повторений
+ * '*' делается пропорционально этим числам, поэтому все выводы заданной
+ * длины равновероятны.
+ *
+ * Повторение итерации, выводящее пустую цепочку, не считается отдельным
+ * выводом. Если в грамматике есть цикл выводов без потребления
+ * терминалов (например A : A ; 'a'), число выводов бесконечно и build()
+ * бросает std::runtime_error. Нетерминал без правила не выводит ни
+ * одной цепочки (как в YieldAnalysis), поэтому ветви с ним не выбираются.
+ *
+ * Предложение с номером i зависит только от (seed, i), поэтому результат
+ * воспроизводим и не зависит от числа потоков.
+ */
+class SentenceGenerator {
+public:
+    /**
+     * @brief Подготовить таблицы числа выводов для длин 0..maxLength
+     */
+    static std::unique_ptr<SentenceGenerator> build(const Grammar* grammar, size_t maxLength);
+
+    /**
+     * @brief Число выводов предложений длины length из стартового символа
+     */
+    double countDerivations(size_t length) const;
+
+    /**
+     * @brief Сгенерировать предложение номер index для данного seed
+     * @return Идентификаторы терминалов
+     */
+    std::vector<int> sentence(size_t length, uint64_t seed, uint64_t index) const;
+
+    /**
+     * @brief Записать options.count предложений в поток, по одному в строке
+     */
+    void generate(std::ostream& out, const GeneratorOptions& options) const;
+
+    size_t maxLength() const { return m_maxLength; }
+
+private:
+    struct NodeCounts {
+        std::vector<double> count;
+        std::vector<double> body;   // Для итерации A#B: одно повторение BA
+        std::vector<double> loop;   // Для итерации A#B: (BA)* с непустыми повторениями
+    };
+
+    const Grammar* m_grammar = nullptr;
+    size_t m_maxLength = 0;
+    std::vector<const RETree*> m_roots;
+    std::vector<std::vector<double>> m_ntCounts;
+    std::unordered_map<const RETree*, NodeCounts> m_nodes;
+    std::vector<std::string> m_terminalNames;
+
+    SentenceGenerator() = default;
+
+    double count(const RETree* tree, size_t length) const;
+    void computeNode(const RETree* tree, size_t length);
+    void sampleInto(size_t length, uint64_t seed, uint64_t index, std::vector<int>& out) const;
+};
+
+}
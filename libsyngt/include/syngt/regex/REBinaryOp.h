@@ -20,6 +20,19 @@ protected:
      * @return ',' для And, ';' для Or, '*' для Iteration
      */
     virtual char getOperationChar() const = 0;
+
+    /**
+     * @brief Операнд в виде строки; альтернатива внутри последовательности
+     * берётся в скобки, иначе save() не сохранит приоритет
+     */
+    std::string operandToString(const RETree* operand, const SelectionMask& mask, bool reverse) const {
+        std::string s = operand->toString(mask, reverse);
+        auto binary = dynamic_cast<const REBinaryOp*>(operand);
+        if (getOperationChar() == ',' && binary && binary->getOperationChar() == ';') {
+            return '(' + s + ')';
+        }
+        return s;
+    }
     
 public:
     REBinaryOp() = default;
@@ -67,13 +80,13 @@ public:
         }
         
         if (reverse) {
-            return m_second->toString(mask, reverse) + 
+            return operandToString(m_second.get(), mask, reverse) + 
                    getOperationChar() + 
-                   m_first->toString(mask, reverse);
+                   operandToString(m_first.get(), mask, reverse);
         } else {
-            return m_first->toString(mask, reverse) + 
+            return operandToString(m_first.get(), mask, reverse) + 
                    getOperationChar() + 
-                   m_second->toString(mask, reverse);
+                   operandToString(m_second.get(), mask, reverse);
         }
     }
     
@@ -88,6 +101,15 @@ public:
         m_second = std::move(second);
     }
     
+    /**
+     * @brief Забрать операнд, оставив узел без него
+     *
+     * Для преобразований, которые разбирают дерево и переиспользуют
+     * поддеревья вместо копирования.
+     */
+    std::unique_ptr<RETree> releaseFirst() { return std::move(m_first); }
+    std::unique_ptr<RETree> releaseSecond() { return std::move(m_second); }
+    
     char operationChar() const { return getOperationChar(); }
     const RETree* firstOperand() const { return m_first.get(); }
     const RETree* secondOperand() const { return m_second.get(); }
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace syngt {
+
+class RETree;
+
+/**
+ * @brief Структурный хеш RE-дерева
+ *
+ * Учитывает тип каждого узла, идентификаторы листьев (и признак
+ * раскрытия макроса) и порядок потомков. Структурно равные деревья
+ * имеют равные хеши.
+ */
+size_t structuralHash(const RETree* tree);
+
+/**
+ * @brief Структурный хеш узла по хешам его потомков
+ *
+ * Для операции structuralHash(tree) равен structuralNodeHash(tree,
+ * structuralHash(tree->left()), structuralHash(tree->right())); для
+ * листа хеши потомков не используются. Позволяет получить хеши всех
+ * поддеревьев одним проходом снизу вверх.
+ */
+size_t structuralNodeHash(const RETree* node, size_t leftHash, size_t rightHash);
+
+/**
+ * @brief Деревья совпадают с точностью до размещения узлов в памяти
+ */
+bool structurallyEqual(const RETree* a, const RETree* b);
+
+/**
+ * @brief Хеш и равенство с точностью до классов нетерминалов
+ *
+ * Нетерминал с индексом id считается равным любому нетерминалу
+ * того же класса ntBlocks[id]; остальные листья сравниваются по id.
+ */
+size_t structuralHash(const RETree* tree, const std::vector<int>& ntBlocks);
+bool structurallyEqual(const RETree* a, const RETree* b, const std::vector<int>& ntBlocks);
+
+/**
+ * @brief Число узлов дерева (листья и операции)
+ */
+int nodeCount(const RETree* tree);
+
+/**
+ * @brief Функторы для unordered-контейнеров с ключом const RETree*
+ */
+struct StructuralHash {
+    size_t operator()(const RETree* tree) const { return structuralHash(tree); }
+};
+
+struct StructuralEqual {
+    bool operator()(const RETree* a, const RETree* b) const { return structurallyEqual(a, b); }
+};
+
+}
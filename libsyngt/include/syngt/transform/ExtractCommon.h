@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace syngt {
+
+class Grammar;
+
+struct ExtractCommonOptions {
+    int minNodes = 5;                   // Меньшие поддеревья не выносятся
+    int minOccurrences = 2;             // Сколько раз поддерево должно встретиться
+    std::string prefix = "common";      // Имена новых нетерминалов: common_N
+};
+
+/**
+ * @brief Результат выноса общих подвыражений
+ */
+struct ExtractCommonStats {
+    int extracted = 0;                  // Создано нетерминалов
+    int reused = 0;                     // Подвыражений, совпавших с правилом целиком (новый нетерминал не нужен)
+    int occurrences = 0;                // Заменено вхождений ссылкой
+    int rounds = 0;
+    int nodesBefore = 0;                // Узлов во всех правилах
+    int nodesAfter = 0;
+    size_t bytesBefore = 0;             // sizeof узлов во всех правилах
+    size_t bytesAfter = 0;
+};
+
+/**
+ * @brief Автоматический вынос повторяющихся подвыражений в нетерминалы
+ *
+ * Автоматический аналог ручной операции Extract Rule. За один обход всех
+ * правил каждое поддерево получает структурный хеш и размер; поддеревья
+ * из не менее options.minNodes узлов, встретившиеся не менее
+ * options.minOccurrences раз, выносятся в новый нетерминал, а все
+ * вхождения заменяются ссылкой на него. Если подвыражение совпадает с
+ * правилом какого-то нетерминала целиком, ссылаются на этот нетерминал.
+ *
+ * Классы обрабатываются от больших поддеревьев к меньшим; вхождения
+ * внутри уже вынесенных не считаются. Повторы внутри вынесенных
+ * подвыражений обрабатываются следующим проходом; проходы повторяются,
+ * пока есть что выносить (каждый уменьшает число узлов).
+ * Правила макросов (NTListItem::isMacro) не изменяются.
+ */
+class ExtractCommon {
+public:
+    static ExtractCommonStats extract(Grammar* grammar, const ExtractCommonOptions& options = ExtractCommonOptions());
+};
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+struct InliningOptions {
+    bool unitRules = true;              // Правила из одного символа: A : B.
+    bool singleUse = true;              // Нетерминалы с единственным вхождением
+    int maxRuleOperations = 100;        // Бюджет: правило не растёт сверх стольких getOperationCount()
+};
+
+/**
+ * @brief Результат подстановки
+ */
+struct InliningStats {
+    int unitRules = 0;                  // Подставлено правил из одного символа
+    int singleUse = 0;                  // Подставлено нетерминалов с одним вхождением
+    int overBudget = 0;                 // Не подставлено из-за maxRuleOperations
+    int rowsRemoved = 0;                // Удалено правил (строк таблицы разбора)
+    int operationsBefore = 0;           // getOperationCount() по всем правилам
+    int operationsAfter = 0;
+    std::vector<std::string> inlined;   // Удалённые нетерминалы в порядке подстановки
+};
+
+/**
+ * @brief Подстановка правил из одного символа и нетерминалов с одним вхождением
+ *
+ * Цепочки A : B. B : C. и нетерминалы, на которые есть ровно одна ссылка,
+ * удлиняют разбор и добавляют строки в таблицы. Проход ведёт индекс
+ * ссылок (число вхождений и ссылающиеся правила для каждого
+ * нетерминала) и подставляет правило кандидата во все его вхождения,
+ * после чего правило удаляется. Индекс обновляется при каждой
+ * подстановке, поэтому цепочки сворачиваются за один проход.
+ *
+ * Не подставляются стартовый нетерминал (первый с правилом), макросы
+ * (NTListItem::isMacro) и правила, ссылающиеся на себя. Правило из
+ * одного символа не увеличивает размер; нетерминал с одним вхождением
+ * подставляется, только если правило-получатель не превысит
+ * options.maxRuleOperations.
+ */
+class Inlining {
+public:
+    static InliningStats inlineRules(Grammar* grammar, const InliningOptions& options = InliningOptions());
+};
+
+}
@@ -25,6 +25,14 @@ public:
     static void eliminate(Grammar* grammar);
     static bool hasDirectLeftRecursion(NTListItem* nt);
 
+    /**
+     * @brief Правило ntId без прямой левой рекурсии
+     *
+     * Грамматика только читается. nullptr, если построить правило не удалось
+     * (тогда правило остаётся прежним).
+     */
+    static std::unique_ptr<RETree> eliminateRule(const RETree* root, int ntId, Grammar* grammar);
+
 private:
     // Используется в hasDirectLeftRecursion для быстрой проверки
     static bool isLeftRecursive(const RETree* node, const NTListItem* nt);
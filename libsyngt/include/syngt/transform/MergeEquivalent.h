@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <string>
+
+namespace syngt {
+
+class Grammar;
+
+struct MergeEquivalentReport {
+    std::vector<std::vector<std::string>> merged;   // Классы: представитель, затем поглощённые
+    int rounds = 0;                                 // Проходов уточнения разбиения
+};
+
+/**
+ * @brief Слияние эквивалентных нетерминалов
+ *
+ * Нетерминалы эквивалентны, если их правила совпадают структурно, когда
+ * каждая ссылка на нетерминал заменена номером его класса (бисимуляция
+ * правил). Классы строятся уточнением разбиения: сначала все определённые
+ * нетерминалы в одном классе, затем на каждом проходе класс делится по
+ * хешу правила с учётом текущих классов, пока разбиение не перестанет
+ * меняться. Нетерминалы без правила не сливаются.
+ *
+ * Представитель класса — нетерминал с наименьшим индексом (стартовый
+ * остаётся на месте). Ссылки на остальные члены класса во всех правилах
+ * заменяются ссылкой на представителя, их правила удаляются.
+ * Дополняет Minimize, который упрощает каждое правило по отдельности.
+ */
+class MergeEquivalent {
+public:
+    static MergeEquivalentReport merge(Grammar* grammar);
+};
+
+}
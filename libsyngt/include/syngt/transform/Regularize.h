@@ -1,8 +1,42 @@
 #pragma once
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace syngt {
 
 class Grammar;
+class RETree;
+
+/**
+ * @brief Преобразование, применяемое к каждому правилу компоненты
+ */
+enum RecursionTransform {
+    rtRegularize,       // Регуляризация: левая и правая рекурсия
+    rtEliminateLeft     // LeftElimination: только левая рекурсия
+};
+
+struct RegularizeOptions {
+    RecursionTransform transform = rtRegularize;
+    unsigned threads = 1;               // Компоненты обрабатываются параллельно; 0 - по числу ядер
+};
+
+/**
+ * @brief Рост одной рекурсивной компоненты сильной связности
+ */
+struct ComponentStats {
+    std::vector<std::string> nonTerminals;  // В порядке обработки
+    int substitutions = 0;              // Подставленных крайних вхождений
+    int nodesBefore = 0;                // Узлов во всех правилах компоненты
+    int nodesAfter = 0;
+};
+
+struct RegularizeStats {
+    int components = 0;                 // Всего компонент
+    std::vector<ComponentStats> recursive;  // Рекурсивные компоненты в топологическом порядке
+    int nodesBefore = 0;                // По всей грамматике
+    int nodesAfter = 0;
+};
 
 /**
  * @brief Полная регуляризация грамматики
@@ -24,6 +58,30 @@ public:
      * @brief Регуляризировать всю грамматику (устранить левую и правую рекурсию)
      */
     static void regularize(Grammar* grammar);
+
+    /**
+     * @brief Регуляризация по компонентам сильной связности
+     *
+     * Компоненты графа вхождений (ReferenceGraph) обрабатываются
+     * в топологическом порядке. Внутри компоненты — алгоритм Пола:
+     * нетерминалы A1..Ak берутся по возрастанию индекса, в правило Ai
+     * подставляются уже обработанные правила Aj (j < i) на месте их
+     * крайних вхождений (левых, а для rtRegularize и правых), после чего
+     * у Ai устраняется прямая рекурсия. Так снимается и косвенная
+     * рекурсия внутри компоненты; подстановки за её пределы не выходят.
+     *
+     * Компоненты независимы и обрабатываются в options.threads потоках;
+     * грамматика при этом только читается, правила записываются после,
+     * поэтому результат не зависит от числа потоков.
+     */
+    static RegularizeStats regularize(Grammar* grammar, const RegularizeOptions& options);
+
+    /**
+     * @brief Правило ntId после регуляризации; грамматика только читается
+     *
+     * nullptr, если построить правило не удалось (правило остаётся прежним).
+     */
+    static std::unique_ptr<RETree> regularizeRule(const RETree* root, int ntId, Grammar* grammar);
 };
 
 } // namespace syngt
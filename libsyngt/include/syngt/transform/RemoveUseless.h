@@ -1,26 +1,39 @@
 #pragma once
 #include <vector>
 #include <string>
-#include <set>
 
 namespace syngt {
 
 class Grammar;
 class NTListItem;
 
+/**
+ * @brief Удалённые символы
+ */
+struct RemoveUselessReport {
+    std::vector<std::string> unproductive;  // Правило удалено: терминальная строка не выводится
+    std::vector<std::string> unreachable;   // Правило удалено: недостижим из стартового
+};
+
 /**
  * @brief Удаление бесполезных символов из грамматики
  * 
  * Удаляет:
  * 1. Непродуктивные символы - из которых нельзя вывести терминальную строку
  * 2. Недостижимые символы - до которых нельзя дойти из стартового
+ *
+ * Продуктивность распространяется от листьев по обратным дугам из
+ * очереди: у каждого узла ',' и ';' хранится число ещё не выведенных
+ * операндов, у каждого нетерминала — список его вхождений. Затем один
+ * обход в ширину от стартового нетерминала. Время линейно по размеру
+ * грамматики.
  */
 class RemoveUseless {
 public:
     /**
      * @brief Удалить все бесполезные символы
      */
-    static void remove(Grammar* grammar);
+    static RemoveUselessReport remove(Grammar* grammar);
 };
 
-}
\ No newline at end of file
+}
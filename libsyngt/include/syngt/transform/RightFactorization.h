@@ -0,0 +1,36 @@
+#pragma once
+
+namespace syngt {
+
+class Grammar;
+class NTListItem;
+
+/**
+ * @brief Правая факторизация грамматики
+ *
+ * Выносит общие окончания альтернатив:
+ *   A → α γ | β γ
+ * Преобразует в:
+ *   A → (α | β) γ
+ *
+ * Цепочки конкатенации альтернатив вставляются в префиксное дерево
+ * в обратном порядке (ключи — структурные хеши элементов), и правило
+ * строится за один обход. Новые нетерминалы не создаются: различающиеся
+ * начала собираются в альтернативу перед общим окончанием, а если одна
+ * альтернатива целиком является окончанием другой, её начало — пустая
+ * цепочка.
+ */
+class RightFactorization {
+public:
+    /**
+     * @brief Факторизовать один нетерминал
+     */
+    static void factorize(NTListItem* nt, Grammar* grammar);
+
+    /**
+     * @brief Факторизовать всю грамматику
+     */
+    static void factorizeAll(Grammar* grammar);
+};
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <syngt/regex/RETree.h>
+#include <memory>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Результат упрощения
+ */
+struct SimplifyStats {
+    int rules = 0;              // Просмотрено правил
+    int changedRules = 0;       // Правил, дерево которых изменилось
+    int nodesBefore = 0;        // Узлов во всех правилах до упрощения
+    int nodesAfter = 0;         // И после
+};
+
+/**
+ * @brief Алгебраическое упрощение RE-деревьев
+ *
+ * Правила (@ - пустая цепочка, X* = @ # X, X+ = X # @):
+ *   @ , X = X , @ = X
+ *   X ; X = X, повторяющиеся альтернативы цепочки ';' удаляются
+ *   X ; X* = X*, альтернатива @ удаляется, если есть другая обнуляемая
+ *   (X*)* = (X+)* = X*, (X ; @)* = X*, (X* ; Y)* = (X ; Y)*
+ *   @* = @, X+ = X* для обнуляемого X
+ *   X* , X* = X*
+ *
+ * Поддеревья хранятся в таблице уникальных узлов (hash-consing), поэтому
+ * структурно равные поддеревья совпадают по указателю, а каждое из них
+ * упрощается один раз. Упрощение идет снизу вверх до неподвижной точки.
+ * Семантические действия не считаются пустыми и не выбрасываются.
+ */
+class Simplify {
+public:
+    /**
+     * @brief Упростить все правила грамматики
+     */
+    static SimplifyStats simplify(Grammar* grammar);
+
+    /**
+     * @brief Упрощенная копия дерева
+     */
+    static std::unique_ptr<RETree> simplify(const RETree* tree, Grammar* grammar);
+};
+
+}
@@ -0,0 +1,378 @@
+#include <syngt/analysis/AmbiguityDetector.h>
+#include <syngt/analysis/YieldAnalysis.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+namespace syngt {
+
+namespace {
+
+using Sentence = std::vector<int>;
+using Sentences = std::map<Sentence, int>;      // Number of derivations, capped at 2
+
+struct NodeSentences {
+    std::vector<Sentences> count;
+    std::vector<Sentences> body;    // For A#B: one repetition BA
+    std::vector<Sentences> loop;    // For A#B: (BA)* with non-empty repetitions
+};
+
+void collectReferences(const RETree* tree, std::vector<int>& out) {
+    if (!tree) return;
+    if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+        out.push_back(nt->getID());
+        return;
+    }
+    collectReferences(tree->left(), out);
+    collectReferences(tree->right(), out);
+}
+
+void collectPostOrder(const RETree* tree, std::vector<const RETree*>& out) {
+    if (!tree || dynamic_cast<const RENonTerminal*>(tree)) return;
+    collectPostOrder(tree->left(), out);
+    collectPostOrder(tree->right(), out);
+    out.push_back(tree);
+}
+
+// References in a context that may derive the empty string: the rule's
+// sentences of length n then depend on the referenced NT's of the same length
+void collectSameLengthEdges(const RETree* tree, bool emptyContext,
+                            const YieldAnalysis::Table& yields, const Grammar* grammar,
+                            std::vector<int>& out) {
+    if (!tree) return;
+
+    auto nullable = [&](const RETree* t) {
+        auto y = YieldAnalysis::minYieldOf(t, yields, grammar);
+        return y && y->empty();
+    };
+
+    if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+        if (emptyContext) out.push_back(nt->getID());
+        return;
+    }
+    if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+        collectSameLengthEdges(andNode->left(), emptyContext && nullable(andNode->right()),
+                               yields, grammar, out);
+        collectSameLengthEdges(andNode->right(), emptyContext && nullable(andNode->left()),
+                               yields, grammar, out);
+        return;
+    }
+    if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+        collectSameLengthEdges(iterNode->left(), emptyContext, yields, grammar, out);
+        collectSameLengthEdges(iterNode->right(), emptyContext && nullable(iterNode->left()),
+                               yields, grammar, out);
+        return;
+    }
+    collectSameLengthEdges(tree->left(), emptyContext, yields, grammar, out);
+    collectSameLengthEdges(tree->right(), emptyContext, yields, grammar, out);
+}
+
+class Unfolding {
+public:
+    Unfolding(const Grammar* grammar, const AmbiguityOptions& options)
+        : m_grammar(grammar), m_options(options) {}
+
+    AmbiguityReport run();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const Grammar* m_grammar;
+    AmbiguityOptions m_options;
+    Clock::time_point m_deadline;
+
+    std::vector<const RETree*> m_roots;
+    std::vector<std::vector<const RETree*>> m_nodes;                        // Post-order per NT
+    std::vector<std::unordered_map<const RETree*, NodeSentences>> m_tables; // Per NT
+    std::vector<std::vector<Sentences>> m_languages;                        // [nt][length], counts are 1
+
+    std::atomic<size_t> m_stored{0};
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_timedOut{false};
+
+    bool overBudget() {
+        if (m_stop) return true;
+        if (m_stored > m_options.sentenceBudget) {
+            m_stop = true;
+        } else if (m_options.timeBudgetMs > 0 && Clock::now() > m_deadline) {
+            m_timedOut = true;
+            m_stop = true;
+        }
+        return m_stop;
+    }
+
+    const Sentences& sentencesOf(int nt, const RETree* tree, size_t n) const {
+        static const Sentences none;
+        static const Sentences empty{{Sentence(), 1}};
+        if (!tree) return n == 0 ? empty : none;
+
+        if (auto* ref = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ref->getID();
+            if (id < 0 || id >= static_cast<int>(m_languages.size()) ||
+                m_languages[id].size() <= n) {
+                return none;
+            }
+            return m_languages[id][n];
+        }
+
+        auto it = m_tables[nt].find(tree);
+        return it != m_tables[nt].end() ? it->second.count[n] : none;
+    }
+
+    // target += a . b
+    void concatenate(const Sentences& a, const Sentences& b, Sentences& target) {
+        for (const auto& [u, cu] : a) {
+            size_t added = 0;
+            for (const auto& [v, cv] : b) {
+                Sentence w;
+                w.reserve(u.size() + v.size());
+                w.insert(w.end(), u.begin(), u.end());
+                w.insert(w.end(), v.begin(), v.end());
+                auto inserted = target.emplace(std::move(w), 0);
+                if (inserted.second) ++added;
+                inserted.first->second = std::min(2, inserted.first->second + cu * cv);
+            }
+            m_stored += added;
+            if (overBudget()) break;
+        }
+    }
+
+    void computeNode(int nt, const RETree* tree, size_t n);
+    Sentences computeRule(int nt, size_t n);
+};
+
+void Unfolding::computeNode(int nt, const RETree* tree, size_t n) {
+    NodeSentences& node = m_tables[nt][tree];
+    Sentences& result = node.count[n];
+    result.clear();
+
+    if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+        bool epsilon = m_grammar->terminals()->getRawString(term->getID()).empty();
+        if (epsilon && n == 0) result.emplace(Sentence(), 1);
+        if (!epsilon && n == 1) result.emplace(Sentence{term->getID()}, 1);
+        return;
+    }
+
+    if (dynamic_cast<const RESemantic*>(tree)) {
+        if (n == 0) result.emplace(Sentence(), 1);
+        return;
+    }
+
+    if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+        result = sentencesOf(nt, orNode->left(), n);
+        for (const auto& [w, c] : sentencesOf(nt, orNode->right(), n)) {
+            int& count = result[w];
+            count = std::min(2, count + c);
+        }
+        m_stored += result.size();
+        return;
+    }
+
+    if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+        for (size_t i = 0; i <= n && !m_stop; ++i) {
+            concatenate(sentencesOf(nt, andNode->left(), i),
+                        sentencesOf(nt, andNode->right(), n - i), result);
+        }
+        return;
+    }
+
+    // A#B = A(BA)*, counting only non-empty repetitions of BA; a nullable
+    // BA makes the iteration ambiguous by itself
+    if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+        Sentences& body = node.body[n];
+        Sentences& loop = node.loop[n];
+        body.clear();
+        loop.clear();
+
+        if (!iterNode->left() || !iterNode->right()) return;
+        for (size_t k = 0; k <= n && !m_stop; ++k) {
+            concatenate(sentencesOf(nt, iterNode->right(), k),
+                        sentencesOf(nt, iterNode->left(), n - k), body);
+        }
+        if (n == 0) {
+            loop.emplace(Sentence(), 1);
+        }
+        for (size_t j = 1; j <= n && !m_stop; ++j) {
+            concatenate(node.body[j], node.loop[n - j], loop);
+        }
+        for (size_t i = 0; i <= n && !m_stop; ++i) {
+            concatenate(sentencesOf(nt, iterNode->left(), i), node.loop[n - i], result);
+        }
+
+        // An empty repetition BA can be inserted anywhere: every sentence
+        // of the iteration has infinitely many derivations
+        if (!node.body[0].empty()) {
+            for (auto& entry : result) entry.second = 2;
+        }
+    }
+}
+
+Sentences Unfolding::computeRule(int nt, size_t n) {
+    for (const RETree* node : m_nodes[nt]) {
+        if (overBudget()) return {};
+        computeNode(nt, node, n);
+    }
+    return sentencesOf(nt, m_roots[nt], n);
+}
+
+AmbiguityReport Unfolding::run() {
+    AmbiguityReport report;
+    m_deadline = Clock::now() + std::chrono::microseconds(
+        static_cast<long long>(m_options.timeBudgetMs * 1000.0));
+
+    int ntCount = static_cast<int>(m_grammar->getNonTerminals().size());
+    if (ntCount == 0) {
+        report.complete = true;
+        report.checkedLength = static_cast<int>(m_options.maxLength);
+        return report;
+    }
+
+    m_roots.assign(ntCount, nullptr);
+    for (int i = 0; i < ntCount; ++i) {
+        NTListItem* item = m_grammar->getNTItemByIndex(i);
+        if (item && item->hasRoot()) m_roots[i] = item->root();
+    }
+
+    // Nonterminals reachable from the start symbol
+    std::vector<int> reachable;
+    std::vector<bool> seen(ntCount, false);
+    std::vector<int> stack = {0};
+    seen[0] = true;
+    while (!stack.empty()) {
+        int nt = stack.back();
+        stack.pop_back();
+        reachable.push_back(nt);
+        std::vector<int> refs;
+        collectReferences(m_roots[nt], refs);
+        for (int r : refs) {
+            if (r >= 0 && r < ntCount && !seen[r]) {
+                seen[r] = true;
+                stack.push_back(r);
+            }
+        }
+    }
+    std::sort(reachable.begin(), reachable.end());
+
+    // Who has to be recomputed when a language of the same length grows
+    auto yields = YieldAnalysis::analyze(m_grammar);
+    std::vector<std::vector<int>> dependents(ntCount);
+    for (int nt : reachable) {
+        std::vector<int> edges;
+        collectSameLengthEdges(m_roots[nt], true, *yields, m_grammar, edges);
+        for (int e : edges) {
+            if (e >= 0 && e < ntCount) dependents[e].push_back(nt);
+        }
+    }
+
+    m_nodes.resize(ntCount);
+    m_tables.resize(ntCount);
+    m_languages.resize(ntCount);
+    for (int nt : reachable) {
+        collectPostOrder(m_roots[nt], m_nodes[nt]);
+        for (const RETree* node : m_nodes[nt]) {
+            m_tables[nt][node];
+        }
+    }
+
+    unsigned threads = m_options.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<bool> reported(ntCount, false);
+    std::vector<std::pair<int, Sentence>> found;
+    std::vector<Sentences> results(ntCount);
+
+    for (size_t n = 0; n <= m_options.maxLength; ++n) {
+        for (int nt : reachable) {
+            m_languages[nt].emplace_back();
+            for (auto& entry : m_tables[nt]) {
+                entry.second.count.emplace_back();
+                if (dynamic_cast<const REIteration*>(entry.first)) {
+                    entry.second.body.emplace_back();
+                    entry.second.loop.emplace_back();
+                }
+            }
+        }
+
+        // Same-length fixpoint; rules of one round only read the languages
+        // of the previous one, so they run in parallel
+        std::vector<int> dirty = reachable;
+        while (!dirty.empty() && !m_stop) {
+            std::atomic<size_t> next{0};
+            auto worker = [&]() {
+                for (size_t i = next++; i < dirty.size(); i = next++) {
+                    results[dirty[i]] = computeRule(dirty[i], n);
+                }
+            };
+            unsigned roundThreads = std::min<unsigned>(threads, static_cast<unsigned>(dirty.size()));
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < roundThreads; ++t) {
+                pool.emplace_back(worker);
+            }
+            worker();
+            for (auto& thread : pool) thread.join();
+            if (m_stop) break;
+
+            std::vector<bool> queued(ntCount, false);
+            std::vector<int> changed;
+            for (int nt : dirty) {
+                Sentences& language = m_languages[nt][n];
+                if (results[nt].size() == language.size()) continue;
+                language.clear();
+                for (const auto& entry : results[nt]) {
+                    language.emplace_hint(language.end(), entry.first, 1);
+                }
+                for (int dependent : dependents[nt]) {
+                    if (!queued[dependent]) {
+                        queued[dependent] = true;
+                        changed.push_back(dependent);
+                    }
+                }
+            }
+            std::sort(changed.begin(), changed.end());
+            dirty = std::move(changed);
+        }
+
+        if (m_stop) break;
+
+        for (int nt : reachable) {
+            if (reported[nt]) continue;
+            for (const auto& [sentence, count] : results[nt]) {
+                if (count < 2) continue;
+                found.emplace_back(nt, sentence);
+                reported[nt] = true;
+                break;
+            }
+        }
+        report.checkedLength = static_cast<int>(n);
+    }
+
+    std::sort(found.begin(), found.end());
+    for (auto& [nt, sentence] : found) {
+        report.ambiguities.push_back({m_grammar->getNonTerminalName(nt), std::move(sentence)});
+    }
+    report.timedOut = m_timedOut;
+    report.budgetExceeded = m_stop && !m_timedOut;
+    report.complete = !m_stop;
+    return report;
+}
+
+} // namespace
+
+AmbiguityReport AmbiguityDetector::analyze(const Grammar* grammar, const AmbiguityOptions& options) {
+    if (!grammar) return AmbiguityReport();
+    return Unfolding(grammar, options).run();
+}
+
+}
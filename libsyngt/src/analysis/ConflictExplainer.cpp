@@ -0,0 +1,504 @@
+#include <syngt/analysis/ConflictExplainer.h>
+#include <syngt/analysis/YieldAnalysis.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+
+#include <deque>
+#include <map>
+#include <optional>
+
+namespace syngt {
+
+namespace {
+
+using Str = std::vector<int>;
+using MaybeStr = std::optional<Str>;
+
+MaybeStr concat(const MaybeStr& a, const MaybeStr& b) {
+    if (!a || !b) return std::nullopt;
+    Str result = *a;
+    result.insert(result.end(), b->begin(), b->end());
+    return result;
+}
+
+void keepShorter(MaybeStr& best, const MaybeStr& candidate) {
+    if (candidate && (!best || candidate->size() < best->size())) {
+        best = candidate;
+    }
+}
+
+// Piece of a right context: either a subtree derived once, or the tail
+// (B A)* of an iteration A#B whose body A has just been left
+struct Piece {
+    const RETree* tree;
+    const RETree* loopSeparator;
+};
+
+// Occurrence of NT `target` inside the rule of `owner`, with the shortest
+// terminal string to its left and the remaining right context
+struct Occurrence {
+    int owner;
+    int target;
+    Str left;
+    std::vector<Piece> right;
+};
+
+class ExplainContext {
+public:
+    explicit ExplainContext(Grammar* grammar) : m_grammar(grammar) {
+        m_ntCount = static_cast<int>(grammar->getNonTerminals().size());
+        computeMinYields();
+        collectAllOccurrences();
+    }
+
+    ConflictExplanation explain(const ParsingTable::Conflict& conflict) {
+        ConflictExplanation result;
+        result.nonTerminal = conflict.nonTerminal;
+        result.terminal = conflict.terminal;
+        result.firstAlternative = describe(conflict.existing);
+        result.secondAlternative = describe(conflict.incoming);
+
+        int target = m_grammar->findNonTerminal(conflict.nonTerminal);
+        if (target < 0 || target >= m_ntCount) return result;
+
+        int t = conflict.terminal;
+        // The empty terminal never appears in the input: nothing to explain
+        if (t >= 0 && m_grammar->terminals()->getRawString(t).empty()) return result;
+
+        MaybeStr first = t >= 0 ? startWith(conflict.existing, t) : std::nullopt;
+        MaybeStr second = t >= 0 ? startWith(conflict.incoming, t) : std::nullopt;
+
+        bool needFollow = !first || !second;
+        if (needFollow) {
+            if (!first) first = nullableString(conflict.existing);
+            if (!second) second = nullableString(conflict.incoming);
+            if (!first || !second) return result;
+        }
+
+        Str suffix;
+        if (!findContext(target, needFollow, t, result.derivation, result.prefix, suffix)) {
+            return result;
+        }
+
+        result.viaFollow = needFollow;
+        result.firstWitness = *concat(concat(result.prefix, first), suffix);
+        result.secondWitness = *concat(concat(result.prefix, second), suffix);
+        result.found = true;
+        return result;
+    }
+
+private:
+    Grammar* m_grammar;
+    int m_ntCount = 0;
+    std::vector<MaybeStr> m_minYield;
+    std::vector<Occurrence> m_occurrences;
+    std::vector<std::vector<int>> m_byTarget;
+    std::map<int, std::vector<MaybeStr>> m_firstWith;
+    const std::vector<MaybeStr>* m_currentFirstWith = nullptr;
+
+    static std::string describe(const RETree* tree) {
+        if (!tree) return "@";
+        SelectionMask emptyMask;
+        return tree->toString(emptyMask, false);
+    }
+
+    bool isEpsilon(const RETerminal* term) const {
+        return m_grammar->terminals()->getRawString(term->getID()).empty();
+    }
+
+    // -----------------------------------------------------------------------
+    // Shortest yields
+    // -----------------------------------------------------------------------
+
+    MaybeStr yieldOf(const RETree* tree) const {
+        if (!tree) return Str{};
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            if (isEpsilon(term)) return Str{};
+            return Str{term->getID()};
+        }
+
+        if (dynamic_cast<const RESemantic*>(tree)) return Str{};
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = nt->getID();
+            if (id < 0 || id >= m_ntCount) return std::nullopt;
+            return m_minYield[id];
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            MaybeStr best = yieldOf(orNode->left());
+            keepShorter(best, yieldOf(orNode->right()));
+            return best;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            return concat(yieldOf(andNode->left()), yieldOf(andNode->right()));
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            return yieldOf(iterNode->left());
+        }
+
+        return std::nullopt;
+    }
+
+    bool nullable(const RETree* tree) const {
+        MaybeStr y = yieldOf(tree);
+        return y && y->empty();
+    }
+
+    MaybeStr nullableString(const RETree* tree) const {
+        return nullable(tree) ? MaybeStr(Str{}) : std::nullopt;
+    }
+
+    void computeMinYields() {
+        auto table = YieldAnalysis::analyze(m_grammar);
+        m_minYield.assign(m_ntCount, std::nullopt);
+        for (int i = 0; i < m_ntCount && i < static_cast<int>(table->size()); ++i) {
+            if ((*table)[i].productive) m_minYield[i] = (*table)[i].minYield;
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Shortest strings starting with a given terminal
+    // -----------------------------------------------------------------------
+
+    MaybeStr startWithTree(const RETree* tree, int t) const {
+        if (!tree) return std::nullopt;
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            if (!isEpsilon(term) && term->getID() == t) return Str{t};
+            return std::nullopt;
+        }
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = nt->getID();
+            if (id < 0 || id >= m_ntCount) return std::nullopt;
+            return (*m_currentFirstWith)[id];
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            MaybeStr best = startWithTree(orNode->left(), t);
+            keepShorter(best, startWithTree(orNode->right(), t));
+            return best;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            MaybeStr best = concat(startWithTree(andNode->left(), t), yieldOf(andNode->right()));
+            if (nullable(andNode->left())) {
+                keepShorter(best, startWithTree(andNode->right(), t));
+            }
+            return best;
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            MaybeStr best = startWithTree(iterNode->left(), t);
+            if (nullable(iterNode->left())) {
+                keepShorter(best, startWithTree(iterNode->right(), t));
+            }
+            return best;
+        }
+
+        return std::nullopt;
+    }
+
+    void selectTerminal(int t) {
+        auto it = m_firstWith.find(t);
+        if (it != m_firstWith.end()) {
+            m_currentFirstWith = &it->second;
+            return;
+        }
+
+        auto& table = m_firstWith[t];
+        table.assign(m_ntCount, std::nullopt);
+        m_currentFirstWith = &table;
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = 0; i < m_ntCount; ++i) {
+                NTListItem* item = m_grammar->getNTItemByIndex(i);
+                if (!item || !item->hasRoot()) continue;
+                MaybeStr candidate = startWithTree(item->root(), t);
+                if (candidate && (!table[i] || candidate->size() < table[i]->size())) {
+                    table[i] = candidate;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    MaybeStr startWith(const RETree* tree, int t) {
+        selectTerminal(t);
+        return startWithTree(tree, t);
+    }
+
+    // -----------------------------------------------------------------------
+    // Right contexts
+    // -----------------------------------------------------------------------
+
+    MaybeStr pieceYield(const Piece& piece) const {
+        if (piece.loopSeparator) return Str{};
+        return yieldOf(piece.tree);
+    }
+
+    MaybeStr pieceStartWith(const Piece& piece, int t) const {
+        if (!piece.loopSeparator) return startWithTree(piece.tree, t);
+
+        MaybeStr best = concat(startWithTree(piece.loopSeparator, t), yieldOf(piece.tree));
+        if (nullable(piece.loopSeparator)) {
+            keepShorter(best, startWithTree(piece.tree, t));
+        }
+        return best;
+    }
+
+    MaybeStr piecesYield(const std::vector<Piece>& pieces) const {
+        MaybeStr result = Str{};
+        for (const auto& piece : pieces) {
+            result = concat(result, pieceYield(piece));
+            if (!result) break;
+        }
+        return result;
+    }
+
+    // Shortest string of the whole right context that begins with t
+    MaybeStr piecesStartWith(const std::vector<Piece>& pieces, int t) const {
+        // restYield[i] = shortest yield of pieces[i..]
+        std::vector<MaybeStr> restYield(pieces.size() + 1);
+        restYield[pieces.size()] = Str{};
+        for (size_t i = pieces.size(); i-- > 0;) {
+            restYield[i] = concat(pieceYield(pieces[i]), restYield[i + 1]);
+        }
+
+        MaybeStr best;
+        for (size_t i = 0; i < pieces.size(); ++i) {
+            keepShorter(best, concat(pieceStartWith(pieces[i], t), restYield[i + 1]));
+
+            // t may come from a later piece only if this one can vanish
+            MaybeStr y = pieceYield(pieces[i]);
+            if (!y || !y->empty()) break;
+        }
+        return best;
+    }
+
+    bool piecesNullable(const std::vector<Piece>& pieces) const {
+        MaybeStr y = piecesYield(pieces);
+        return y && y->empty();
+    }
+
+    // -----------------------------------------------------------------------
+    // Occurrences and context search
+    // -----------------------------------------------------------------------
+
+    void collectOccurrences(int owner, const RETree* tree, const Str& left,
+                            const std::vector<Piece>& right) {
+        if (!tree) return;
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = nt->getID();
+            if (id >= 0 && id < m_ntCount) {
+                m_occurrences.push_back({owner, id, left, right});
+            }
+            return;
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            collectOccurrences(owner, orNode->left(), left, right);
+            collectOccurrences(owner, orNode->right(), left, right);
+            return;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            std::vector<Piece> leftRight = {{andNode->right(), nullptr}};
+            leftRight.insert(leftRight.end(), right.begin(), right.end());
+            collectOccurrences(owner, andNode->left(), left, leftRight);
+
+            MaybeStr y = concat(left, yieldOf(andNode->left()));
+            if (y) collectOccurrences(owner, andNode->right(), *y, right);
+            return;
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            Piece loop = {iterNode->left(), iterNode->right()};
+
+            std::vector<Piece> bodyRight = {loop};
+            bodyRight.insert(bodyRight.end(), right.begin(), right.end());
+            collectOccurrences(owner, iterNode->left(), left, bodyRight);
+
+            std::vector<Piece> separatorRight = {{iterNode->left(), nullptr}, loop};
+            separatorRight.insert(separatorRight.end(), right.begin(), right.end());
+            MaybeStr y = concat(left, yieldOf(iterNode->left()));
+            if (y) collectOccurrences(owner, iterNode->right(), *y, separatorRight);
+        }
+    }
+
+    void collectAllOccurrences() {
+        for (int i = 0; i < m_ntCount; ++i) {
+            NTListItem* item = m_grammar->getNTItemByIndex(i);
+            if (!item || !item->hasRoot()) continue;
+            collectOccurrences(i, item->root(), Str{}, {});
+        }
+
+        m_byTarget.assign(m_ntCount, {});
+        for (size_t i = 0; i < m_occurrences.size(); ++i) {
+            m_byTarget[m_occurrences[i].target].push_back(static_cast<int>(i));
+        }
+    }
+
+    // Backward BFS over (NT, need) states, where need means the string
+    // right after the NT still has to begin with t
+    bool findContext(int target, bool need, int t, std::vector<std::string>& derivation,
+                     Str& prefix, Str& suffix) {
+        if (t >= 0) selectTerminal(t);
+
+        struct Step {
+            int next = -1;
+            int occurrence = -1;
+            Str right;
+        };
+
+        auto stateOf = [](int nt, bool n) { return nt * 2 + (n ? 1 : 0); };
+        auto isGoal = [&](int state) {
+            return state / 2 == 0 && (state % 2 == 0 || t == -1);
+        };
+
+        std::vector<bool> visited(static_cast<size_t>(m_ntCount) * 2, false);
+        std::vector<Step> parent(static_cast<size_t>(m_ntCount) * 2);
+        std::deque<int> queue;
+
+        int initial = stateOf(target, need);
+        visited[initial] = true;
+        queue.push_back(initial);
+
+        int goal = -1;
+        while (!queue.empty() && goal < 0) {
+            int state = queue.front();
+            queue.pop_front();
+            if (isGoal(state)) {
+                goal = state;
+                break;
+            }
+
+            bool stateNeed = state % 2 == 1;
+            for (int occIndex : m_byTarget[state / 2]) {
+                const Occurrence& occ = m_occurrences[occIndex];
+
+                auto visit = [&](bool predNeed, const Str& right) {
+                    int pred = stateOf(occ.owner, predNeed);
+                    if (visited[pred]) return;
+                    visited[pred] = true;
+                    parent[pred] = {state, occIndex, right};
+                    queue.push_back(pred);
+                };
+
+                if (!stateNeed) {
+                    MaybeStr right = piecesYield(occ.right);
+                    if (right) visit(false, *right);
+                    continue;
+                }
+
+                if (t >= 0) {
+                    MaybeStr right = piecesStartWith(occ.right, t);
+                    if (right) visit(false, *right);
+                }
+                if (piecesNullable(occ.right)) {
+                    visit(true, Str{});
+                }
+            }
+        }
+
+        if (goal < 0) return false;
+
+        std::vector<Str> rights;
+        int state = goal;
+        derivation.push_back(m_grammar->getNonTerminalName(state / 2));
+        while (state != initial) {
+            const Step& step = parent[state];
+            const Occurrence& occ = m_occurrences[step.occurrence];
+            prefix.insert(prefix.end(), occ.left.begin(), occ.left.end());
+            rights.push_back(step.right);
+            state = step.next;
+            derivation.push_back(m_grammar->getNonTerminalName(state / 2));
+        }
+
+        for (auto it = rights.rbegin(); it != rights.rend(); ++it) {
+            suffix.insert(suffix.end(), it->begin(), it->end());
+        }
+        return true;
+    }
+};
+
+std::string formatString(const Grammar* grammar, const std::vector<int>& str) {
+    std::string result;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (i > 0) result += " ";
+        if (str[i] == -1) {
+            result += "$";
+        } else {
+            result += "'" + grammar->terminals()->getString(str[i]) + "'";
+        }
+    }
+    return result.empty() ? "@" : result;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+std::vector<ConflictExplanation> ConflictExplainer::explain(Grammar* grammar, const ParsingTable& table) {
+    std::vector<ConflictExplanation> result;
+    if (!grammar) return result;
+
+    ExplainContext context(grammar);
+    for (const auto& conflict : table.getConflictDetails()) {
+        result.push_back(context.explain(conflict));
+    }
+    return result;
+}
+
+ConflictExplanation ConflictExplainer::explain(Grammar* grammar, const ParsingTable::Conflict& conflict) {
+    if (!grammar) return {};
+    ExplainContext context(grammar);
+    return context.explain(conflict);
+}
+
+std::string ConflictExplainer::format(const Grammar* grammar, const ConflictExplanation& explanation) {
+    if (!grammar) return "";
+
+    std::string result = "Conflict at M[" + explanation.nonTerminal + ", ";
+    result += explanation.terminal == -1 ? "$" : grammar->terminals()->getString(explanation.terminal);
+    result += "]\n";
+    result += "  alternative 1: " + explanation.firstAlternative + "\n";
+    result += "  alternative 2: " + explanation.secondAlternative + "\n";
+
+    if (!explanation.found) {
+        result += "  no counterexample found\n";
+        return result;
+    }
+
+    result += "  derivation: ";
+    for (size_t i = 0; i < explanation.derivation.size(); ++i) {
+        if (i > 0) result += " => ";
+        result += explanation.derivation[i];
+    }
+    result += "\n";
+    if (explanation.viaFollow) {
+        result += "  (lookahead comes from FOLLOW(" + explanation.nonTerminal + "))\n";
+    }
+    result += "  prefix:    " + formatString(grammar, explanation.prefix) + "\n";
+    result += "  witness 1: " + formatString(grammar, explanation.firstWitness) + "\n";
+    result += "  witness 2: " + formatString(grammar, explanation.secondWitness) + "\n";
+    return result;
+}
+
+}
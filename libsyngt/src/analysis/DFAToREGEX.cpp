@@ -1,5 +1,6 @@
 #include <syngt/analysis/DFAToREGEX.h>
 #include <syngt/core/Grammar.h>
+#include <syngt/core/SymbolSnapshot.h>
 #include <syngt/regex/RETree.h>
 #include <syngt/regex/RETerminal.h>
 #include <syngt/regex/RENonTerminal.h>
@@ -8,8 +9,10 @@
 #include <syngt/regex/REAnd.h>
 #include <syngt/regex/REIteration.h>
 #include <algorithm>
-#include <climits>
+#include <atomic>
 #include <stdexcept>
+#include <thread>
+#include <unordered_map>
 
 namespace {
 // Returns true if tree is an empty-string terminal (epsilon).
@@ -24,33 +27,44 @@ bool isEpsilonTree(const syngt::RETree* tree, const syngt::Grammar* grammar) {
     int epsilonId = grammar->findTerminal("");
     return epsilonId >= 0 && term->getID() == epsilonId;
 }
+
+// Smaller automata are not worth a thread per ordering
+constexpr int ParallelEliminationStates = 64;
 } // namespace
 
 namespace syngt {
 
+const char* eliminationOrderName(EliminationOrder order) {
+    switch (order) {
+        case eoGreedyCost:         return "greedy";
+        case eoMinDegree:          return "min-degree";
+        case eoWeight:             return "weight";
+        case eoReverseTopological: return "reverse-topological";
+    }
+    return "unknown";
+}
+
+DFAToRegex::DFAToRegex(Grammar* grammar) : m_grammar(grammar) {
+    m_epsilon = makeLeaf(std::make_unique<RETerminal>(m_grammar, 0));
+}
+
 std::unique_ptr<DFAToRegex> DFAToRegex::fromMinimizationTable(
     Grammar* grammar,
-    const MinimizationTable* table
+    const MinimizationTable* table,
+    const SymbolSnapshot* symbols
 ) {
     auto converter = std::make_unique<DFAToRegex>(grammar);
     
     int statesCount = table->getStatesCount();
     int symbolsCount = table->getSymbolsCount();
     
-    converter->m_states.reserve(statesCount + 2);
-    for (int i = 0; i < statesCount + 2; ++i) {
-        converter->m_states.push_back(i);
-    }
-    
-    converter->m_arcs.push_back(std::make_unique<Arc>(
-        0, 2, converter->createEpsilon()
-    ));
+    // State 2 always exists as the target of the start arc
+    converter->initStates(std::max(statesCount, 1) + 2);
+    converter->addArc(0, 2, converter->m_epsilon);
     
     for (int fromState = 0; fromState < statesCount; ++fromState) {
         if (table->getStateName(fromState) == "FinalState") {
-            converter->m_arcs.push_back(std::make_unique<Arc>(
-                fromState + 2, 1, converter->createEpsilon()
-            ));
+            converter->addArc(fromState + 2, 1, converter->m_epsilon);
             break;
         }
     }
@@ -69,29 +83,30 @@ std::unique_ptr<DFAToRegex> DFAToRegex::fromMinimizationTable(
             if (symbolName.size() >= 2 &&
                 (symbolName[0] == '"' || symbolName[0] == '\'')) {
                 std::string content = symbolName.substr(1, symbolName.size() - 2);
-                int termId = grammar->addTerminal(content);
+                int termId = symbols ? symbols->findTerminal(content) : grammar->addTerminal(content);
+                if (termId < 0) return nullptr;
                 tree = std::make_unique<RETerminal>(grammar, termId);
             } else if (!symbolName.empty() && symbolName[0] == '$') {
                 // Semantic action (name stored with '$' prefix, e.g. "$add")
-                int semId = grammar->findSemantic(symbolName);
+                int semId = symbols ? symbols->findSemantic(symbolName) : grammar->findSemantic(symbolName);
                 if (semId < 0) {
+                    if (symbols) return nullptr;
                     semId = grammar->addSemantic(symbolName);
                 }
                 tree = std::make_unique<RESemantic>(grammar, semId);
             } else {
-                int ntId = grammar->findNonTerminal(symbolName);
+                int ntId = symbols ? symbols->findNonTerminal(symbolName) : grammar->findNonTerminal(symbolName);
                 if (ntId < 0) {
+                    if (symbols) return nullptr;
                     ntId = grammar->addNonTerminal(symbolName);
                 }
                 tree = std::make_unique<RENonTerminal>(grammar, ntId);
             }
             
+            // One leaf shared by every target of the cell
+            ArcExprPtr leaf = converter->makeLeaf(std::move(tree));
             for (State toState : statesSet->getStates()) {
-                converter->m_arcs.push_back(std::make_unique<Arc>(
-                    fromState + 2,
-                    toState + 2,
-                    tree->copy()
-                ));
+                converter->addArc(fromState + 2, toState + 2, leaf);
             }
         }
     }
@@ -99,250 +114,493 @@ std::unique_ptr<DFAToRegex> DFAToRegex::fromMinimizationTable(
     return converter;
 }
 
-void DFAToRegex::mergeParallelArcs() {
-    size_t i = 0;
-    while (i < m_arcs.size()) {
-        Arc* arc1 = m_arcs[i].get();
+// ---------------------------------------------------------------------------
+// Arc bookkeeping
+// ---------------------------------------------------------------------------
+
+void DFAToRegex::initStates(int count) {
+    size_t n = static_cast<size_t>(count);
+    m_inArcs.assign(n, {});
+    m_outArcs.assign(n, {});
+    m_costs.assign(n, -1);
+    m_isDirty.assign(n, false);
+    m_needsMerge.assign(n, false);
+    m_removed.assign(n, false);
+    m_queue.clear();
+    m_dirtyStates.clear();
+    m_mergeStates.clear();
+    
+    for (State state = 0; state < count; ++state) {
+        markDirty(state);
+    }
+}
+
+void DFAToRegex::addArc(State from, State to, ArcExprPtr expr) {
+    size_t index = m_arcs.size();
+    m_arcs.emplace_back(from, to, std::move(expr));
+    m_outArcs[from].push_back(index);
+    m_inArcs[to].push_back(index);
+    
+    if (!m_needsMerge[from]) {
+        m_needsMerge[from] = true;
+        m_mergeStates.push_back(from);
+    }
+    markDirty(from);
+    markDirty(to);
+}
+
+void DFAToRegex::eraseArc(size_t arcIndex) {
+    // Lists are compacted lazily in updateCosts(); both endpoints are dirty
+    Arc& arc = m_arcs[arcIndex];
+    arc.expr.reset();
+    markDirty(arc.fromState);
+    markDirty(arc.toState);
+}
+
+void DFAToRegex::markDirty(State state) {
+    if (!m_isDirty[state]) {
+        m_isDirty[state] = true;
+        m_dirtyStates.push_back(state);
+    }
+}
+
+void DFAToRegex::updateCosts() {
+    auto isErased = [this](size_t index) { return !m_arcs[index].expr; };
+    
+    for (State state : m_dirtyStates) {
+        m_isDirty[state] = false;
         
-        for (size_t j = m_arcs.size() - 1; j > i; --j) {
-            Arc* arc2 = m_arcs[j].get();
-            
-            if (arc1->fromState == arc2->fromState &&
-                arc1->toState == arc2->toState) {
-                arc1->tree = createOr(std::move(arc1->tree), std::move(arc2->tree));
-                
-                m_arcs.erase(m_arcs.begin() + j);
-            }
+        auto& in = m_inArcs[state];
+        in.erase(std::remove_if(in.begin(), in.end(), isErased), in.end());
+        auto& out = m_outArcs[state];
+        out.erase(std::remove_if(out.begin(), out.end(), isErased), out.end());
+        
+        // The virtual start (0) and final (1) states are never removed
+        if (state < 2 || m_removed[state]) {
+            continue;
         }
         
-        ++i;
+        if (m_costs[state] >= 0) {
+            m_queue.erase({m_costs[state], -state});
+        }
+        m_costs[state] = getStateRemovalCost(state);
+        m_queue.insert({m_costs[state], -state});
     }
+    m_dirtyStates.clear();
 }
 
-void DFAToRegex::removeAllStates() {
-    while (m_states.size() > 2) {
-        mergeParallelArcs();
+// ---------------------------------------------------------------------------
+// State elimination
+// ---------------------------------------------------------------------------
+
+void DFAToRegex::mergeParallelArcs() {
+    // For each target keep the arcs in creation order; the lowest one absorbs
+    // the others from the newest down, as a scan over the whole list would.
+    std::unordered_map<State, std::vector<size_t>> byTarget;
+    
+    for (State from : m_mergeStates) {
+        m_needsMerge[from] = false;
+        if (m_removed[from]) {
+            continue;
+        }
         
-        size_t bestIndex = findBestStateToRemove();
-        removeState(bestIndex);
+        byTarget.clear();
+        std::vector<State> targets;
+        for (size_t index : m_outArcs[from]) {
+            if (!m_arcs[index].expr) {
+                continue;
+            }
+            auto& group = byTarget[m_arcs[index].toState];
+            if (group.empty()) {
+                targets.push_back(m_arcs[index].toState);
+            }
+            group.push_back(index);
+        }
+        
+        for (State to : targets) {
+            const auto& group = byTarget[to];
+            if (group.size() < 2) {
+                continue;
+            }
+            
+            ArcExprPtr merged = m_arcs[group.front()].expr;
+            for (size_t k = group.size() - 1; k > 0; --k) {
+                merged = makeNode(ArcExpr::Or, std::move(merged), m_arcs[group[k]].expr);
+                eraseArc(group[k]);
+            }
+            m_arcs[group.front()].expr = std::move(merged);
+        }
     }
-    
-    mergeParallelArcs();
+    m_mergeStates.clear();
 }
 
-void DFAToRegex::removeState(size_t stateIndex) {
-    State state = m_states[stateIndex];
-    
-    std::unique_ptr<RETree> loopTree;
+void DFAToRegex::removeAllStates(EliminationOrder order) {
+    m_order = order;
+    eliminate(false, std::chrono::steady_clock::time_point());
+}
+
+std::vector<EliminationStats> DFAToRegex::removeAllStates(const EliminationOptions& options) {
+    using Clock = std::chrono::steady_clock;
     
-    for (const auto& arc : m_arcs) {
-        if (arc->fromState == state && arc->toState == state) {
-            loopTree = arc->tree->copy();
-            break;
-        }
+    std::vector<EliminationOrder> orders = options.orders;
+    if (orders.empty()) {
+        orders.push_back(eoGreedyCost);
     }
     
-    std::unique_ptr<RETree> loopIteration;
-    if (loopTree) {
-        loopIteration = createUnaryIteration(std::move(loopTree));
-    } else {
-        loopIteration = createEpsilon();
-    }
+    Clock::time_point started = Clock::now();
+    Clock::time_point deadline = started + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(options.timeBudgetMs));
     
-    std::vector<std::unique_ptr<Arc>> newArcs;
+    // Copies share arc expressions, so each costs only the arc lists
+    std::vector<DFAToRegex> runs(orders.size(), *this);
+    std::vector<EliminationStats> stats(orders.size());
     
-    for (const auto& inArc : m_arcs) {
-        if (inArc->toState == state && inArc->fromState != state) {
-            
-            for (const auto& outArc : m_arcs) {
-                if (outArc->fromState == state && outArc->toState != state) {
-                    
-                    auto newTree = createAnd(
-                        createAnd(
-                            inArc->tree->copy(),
-                            loopIteration->copy()
-                        ),
-                        outArc->tree->copy()
-                    );
-                    
-                    newArcs.push_back(std::make_unique<Arc>(
-                        inArc->fromState,
-                        outArc->toState,
-                        std::move(newTree)
-                    ));
-                }
+    auto run = [&](size_t i) {
+        Clock::time_point runStarted = Clock::now();
+        DFAToRegex& converter = runs[i];
+        converter.m_order = orders[i];
+        
+        stats[i].order = orders[i];
+        stats[i].completed = converter.eliminate(i > 0 && options.timeBudgetMs > 0, deadline);
+        if (stats[i].completed) {
+            stats[i].operationCount = converter.resultExpression()->operationCount;
+        }
+        stats[i].milliseconds = std::chrono::duration<double, std::milli>(
+            Clock::now() - runStarted).count();
+    };
+    
+    unsigned threads = options.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(orders.size()));
+    if (static_cast<int>(m_inArcs.size()) < ParallelEliminationStates) threads = 1;
+    
+    if (threads <= 1) {
+        for (size_t i = 0; i < orders.size(); ++i) {
+            run(i);
+        }
+    } else {
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next++; i < orders.size(); i = next++) {
+                run(i);
             }
+        };
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t) {
+            pool.emplace_back(worker);
         }
+        worker();
+        for (auto& thread : pool) thread.join();
     }
     
-    m_arcs.erase(
-        std::remove_if(m_arcs.begin(), m_arcs.end(),
-            [state](const std::unique_ptr<Arc>& arc) {
-                return arc->fromState == state || arc->toState == state;
-            }),
-        m_arcs.end()
-    );
-    
-    for (auto& arc : newArcs) {
-        m_arcs.push_back(std::move(arc));
+    size_t best = 0;
+    for (size_t i = 1; i < orders.size(); ++i) {
+        if (stats[i].completed && stats[i].operationCount < stats[best].operationCount) {
+            best = i;
+        }
     }
+    *this = std::move(runs[best]);
     
-    m_states.erase(m_states.begin() + stateIndex);
+    return stats;
 }
 
-size_t DFAToRegex::findBestStateToRemove() {
-    size_t bestIndex = 2;
-    int bestCost = INT_MAX;
+bool DFAToRegex::eliminate(bool limited, std::chrono::steady_clock::time_point deadline) {
+    if (m_order == eoReverseTopological) {
+        computeReverseTopologicalRanks();
+    }
     
-    bool needRestart;
+    mergeParallelArcs();
+    updateCosts();
     
-    do {
-        needRestart = false;
-        bestIndex = m_states.size() - 1;
-        bestCost = INT_MAX;
+    while (!m_queue.empty()) {
+        if (limited && std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
         
-        for (size_t i = m_states.size() - 1; i >= 2; --i) {
-            State state = m_states[i];
-            int cost = getStateRemovalCost(state);
-            
-            if (cost < bestCost) {
-                if (cost < 0) {
-                    needRestart = true;
-                    break;
-                }
-                
-                if (cost == 0) {
-                    return i;
+        // Cheapest state; among equal costs the one with the highest number
+        State state = -m_queue.begin()->second;
+        
+        if (tryOptimizeBinaryIteration(state)) {
+            updateCosts();
+            continue;
+        }
+        
+        removeState(state);
+        mergeParallelArcs();
+        updateCosts();
+    }
+    
+    return true;
+}
+
+void DFAToRegex::computeReverseTopologicalRanks() {
+    // Iterative DFS from the start state; a state is ranked when all of its
+    // successors are finished, so states nearer the final state go first
+    size_t count = m_inArcs.size();
+    m_ranks.assign(count, -1);
+    std::vector<bool> visited(count, false);
+    std::vector<std::pair<State, size_t>> stack;
+    long long rank = 0;
+    
+    auto visit = [&](State root) {
+        if (visited[root]) return;
+        visited[root] = true;
+        stack.push_back({root, 0});
+        while (!stack.empty()) {
+            auto& [state, position] = stack.back();
+            const auto& out = m_outArcs[state];
+            if (position < out.size()) {
+                const Arc& arc = m_arcs[out[position++]];
+                if (arc.expr && !visited[arc.toState]) {
+                    visited[arc.toState] = true;
+                    stack.push_back({arc.toState, 0});
                 }
-                
-                bestCost = cost;
-                bestIndex = i;
+                continue;
             }
-            
-            if (i == 0) break;
+            m_ranks[state] = rank++;
+            stack.pop_back();
         }
-    } while (needRestart);
+    };
     
-    return bestIndex;
+    visit(0);
+    for (State state = 0; state < static_cast<State>(count); ++state) {
+        visit(state);
+    }
 }
 
-int DFAToRegex::getStateRemovalCost(State state) {
-    int inCount = 0, outCount = 0;
-    int inLength = 0, outLength = 0, loopLength = 0;
-    Arc* singleInArc = nullptr;
+void DFAToRegex::removeState(State state) {
+    ArcExprPtr loop;
+    std::vector<size_t> inArcs, outArcs;
     
-    for (const auto& arc : m_arcs) {
-        if (arc->fromState == state) {
-            if (arc->toState == state) {
-                loopLength += arc->tree->getOperationCount();
-            } else {
-                ++outCount;
-                outLength += arc->tree->getOperationCount();
+    for (size_t index : m_outArcs[state]) {
+        const Arc& arc = m_arcs[index];
+        if (!arc.expr) {
+            continue;
+        }
+        if (arc.toState == state) {
+            if (!loop) {
+                loop = arc.expr;
             }
-        } else if (arc->toState == state) {
-            ++inCount;
-            inLength += arc->tree->getOperationCount();
-            singleInArc = arc.get();
+        } else {
+            outArcs.push_back(index);
+        }
+    }
+    for (size_t index : m_inArcs[state]) {
+        const Arc& arc = m_arcs[index];
+        if (arc.expr && arc.fromState != state) {
+            inArcs.push_back(index);
         }
     }
     
-    if (inCount <= 1 && outCount <= 1) {
-        if (inCount == 1 && loopLength == 0 && singleInArc) {
-            if (tryOptimizeBinaryIteration(singleInArc)) {
-                return -1;
-            }
+    ArcExprPtr loopIteration = loop ? createUnaryIteration(loop) : m_epsilon;
+    
+    std::vector<Arc> newArcs;
+    newArcs.reserve(inArcs.size() * outArcs.size());
+    
+    for (size_t inIndex : inArcs) {
+        const Arc& inArc = m_arcs[inIndex];
+        ArcExprPtr prefix = createAnd(inArc.expr, loopIteration);
+        
+        for (size_t outIndex : outArcs) {
+            const Arc& outArc = m_arcs[outIndex];
+            newArcs.emplace_back(inArc.fromState, outArc.toState,
+                                 createAnd(prefix, outArc.expr));
         }
+    }
+    
+    for (size_t index : m_inArcs[state]) {
+        if (m_arcs[index].expr) {
+            eraseArc(index);
+        }
+    }
+    for (size_t index : m_outArcs[state]) {
+        if (m_arcs[index].expr) {
+            eraseArc(index);
+        }
+    }
+    
+    m_removed[state] = true;
+    m_queue.erase({m_costs[state], -state});
+    m_inArcs[state].clear();
+    m_outArcs[state].clear();
+    
+    for (auto& arc : newArcs) {
+        addArc(arc.fromState, arc.toState, std::move(arc.expr));
+    }
+}
+
+long long DFAToRegex::getStateRemovalCost(State state) const {
+    if (m_order == eoReverseTopological) {
+        return m_ranks[state];
+    }
+    
+    long long inCount = 0, outCount = 0;
+    long long inLength = 0, outLength = 0, loopLength = 0;
+    
+    for (size_t index : m_outArcs[state]) {
+        const Arc& arc = m_arcs[index];
+        if (!arc.expr) {
+            continue;
+        }
+        if (arc.toState == state) {
+            loopLength += arc.expr->operationCount;
+        } else {
+            ++outCount;
+            outLength += arc.expr->operationCount;
+        }
+    }
+    for (size_t index : m_inArcs[state]) {
+        const Arc& arc = m_arcs[index];
+        if (arc.expr && arc.fromState != state) {
+            ++inCount;
+            inLength += arc.expr->operationCount;
+        }
+    }
+    
+    // Removing a state without in or out arcs only drops arcs
+    if (inCount == 0 || outCount == 0) {
         return 0;
     }
     
-    int cost = inLength * (outCount - 1) + 
-               outLength * (inCount - 1) + 
-               inCount * outCount * loopLength;
+    switch (m_order) {
+        case eoMinDegree:
+            return inCount * outCount;
+        case eoWeight:
+            return inLength * (outCount - 1) + 
+                   outLength * (inCount - 1) + 
+                   loopLength * (inCount * outCount - 1);
+        default:
+            break;
+    }
+    
+    if (inCount <= 1 && outCount <= 1) {
+        return 0;
+    }
     
-    return cost;
+    return inLength * (outCount - 1) + 
+           outLength * (inCount - 1) + 
+           inCount * outCount * loopLength;
 }
 
-bool DFAToRegex::tryOptimizeBinaryIteration(Arc* inArc) {
-    State stateFrom = inArc->fromState;
-    State stateTo = inArc->toState;
+bool DFAToRegex::tryOptimizeBinaryIteration(State state) {
+    size_t inIndex = 0;
+    int inCount = 0, outCount = 0;
+    bool hasLoop = false;
     
-    bool foundOtherOut = false;
-    bool foundBackArc = false;
-    Arc* backArc = nullptr;
+    for (size_t index : m_inArcs[state]) {
+        const Arc& arc = m_arcs[index];
+        if (!arc.expr) {
+            continue;
+        }
+        if (arc.fromState == state) {
+            hasLoop = true;
+        } else {
+            ++inCount;
+            inIndex = index;
+        }
+    }
+    for (size_t index : m_outArcs[state]) {
+        const Arc& arc = m_arcs[index];
+        if (arc.expr && arc.toState != state) {
+            ++outCount;
+        }
+    }
     
-    for (const auto& arc : m_arcs) {
-        if (arc->fromState == stateFrom) {
-            if (arc->toState != stateTo) {
-                foundOtherOut = true;
-                break;
-            }
+    if (inCount != 1 || outCount > 1 || hasLoop) {
+        return false;
+    }
+    
+    State stateFrom = m_arcs[inIndex].fromState;
+    
+    for (size_t index : m_outArcs[stateFrom]) {
+        const Arc& arc = m_arcs[index];
+        if (arc.expr && arc.toState != state) {
+            return false;
         }
-        
-        if (arc->toState == stateFrom && arc->fromState == stateTo) {
+    }
+    
+    bool foundBackArc = false;
+    size_t backIndex = 0;
+    for (size_t index : m_outArcs[state]) {
+        const Arc& arc = m_arcs[index];
+        if (arc.expr && arc.toState == stateFrom) {
             foundBackArc = true;
-            backArc = arc.get();
+            backIndex = index;
         }
     }
     
-    if (foundBackArc && !foundOtherOut && backArc) {
-        inArc->tree = createIteration(
-            std::move(inArc->tree),
-            backArc->tree->copy()
-        );
-        
-        m_arcs.erase(
-            std::remove_if(m_arcs.begin(), m_arcs.end(),
-                [backArc](const std::unique_ptr<Arc>& arc) {
-                    return arc.get() == backArc;
-                }),
-            m_arcs.end()
-        );
-        
-        return true;
+    if (!foundBackArc) {
+        return false;
     }
     
-    return false;
+    m_arcs[inIndex].expr = makeNode(ArcExpr::Iteration,
+                                    m_arcs[inIndex].expr, m_arcs[backIndex].expr);
+    eraseArc(backIndex);
+    markDirty(stateFrom);
+    markDirty(state);
+    
+    return true;
 }
 
-std::unique_ptr<RETree> DFAToRegex::getRegularExpression() {
-    if (m_arcs.empty()) {
-        return createEpsilon();
+const ArcExpr* DFAToRegex::resultExpression() const {
+    for (const auto& arc : m_arcs) {
+        if (arc.expr) {
+            return arc.expr.get();
+        }
     }
     
-    return std::move(m_arcs.front()->tree);
+    return m_epsilon.get();
 }
 
-std::unique_ptr<RETree> DFAToRegex::createEpsilon() {
-    return std::make_unique<RETerminal>(m_grammar, 0);
+std::unique_ptr<RETree> DFAToRegex::getRegularExpression() {
+    return buildTree(resultExpression());
 }
 
-std::unique_ptr<RETree> DFAToRegex::createUnaryIteration(std::unique_ptr<RETree> tree) {
-    auto epsilon = createEpsilon();
-    return REIteration::make(std::move(epsilon), std::move(tree));
+// ---------------------------------------------------------------------------
+// Expressions
+// ---------------------------------------------------------------------------
+
+ArcExprPtr DFAToRegex::makeLeaf(std::unique_ptr<RETree> tree) const {
+    auto expr = std::make_shared<ArcExpr>();
+    expr->kind = ArcExpr::Leaf;
+    expr->epsilon = isEpsilonTree(tree.get(), m_grammar);
+    expr->operationCount = tree->getOperationCount();
+    expr->leaf = std::move(tree);
+    return expr;
 }
 
-std::unique_ptr<RETree> DFAToRegex::createAnd(
-    std::unique_ptr<RETree> left,
-    std::unique_ptr<RETree> right
-) {
-    // ε·X = X,  X·ε = X
-    if (isEpsilonTree(left.get(),  m_grammar)) return right;
-    if (isEpsilonTree(right.get(), m_grammar)) return left;
-    return REAnd::make(std::move(left), std::move(right));
+ArcExprPtr DFAToRegex::makeNode(ArcExpr::Kind kind, ArcExprPtr left, ArcExprPtr right) const {
+    auto expr = std::make_shared<ArcExpr>();
+    expr->kind = kind;
+    expr->operationCount = left->operationCount + right->operationCount;
+    expr->left = std::move(left);
+    expr->right = std::move(right);
+    return expr;
 }
 
-std::unique_ptr<RETree> DFAToRegex::createOr(
-    std::unique_ptr<RETree> left,
-    std::unique_ptr<RETree> right
-) {
-    return REOr::make(std::move(left), std::move(right));
+ArcExprPtr DFAToRegex::createUnaryIteration(ArcExprPtr expr) const {
+    return makeNode(ArcExpr::Iteration, m_epsilon, std::move(expr));
 }
 
-std::unique_ptr<RETree> DFAToRegex::createIteration(
-    std::unique_ptr<RETree> left,
-    std::unique_ptr<RETree> right
-) {
-    return REIteration::make(std::move(left), std::move(right));
+ArcExprPtr DFAToRegex::createAnd(ArcExprPtr left, ArcExprPtr right) const {
+    // ε·X = X,  X·ε = X
+    if (left->epsilon) return right;
+    if (right->epsilon) return left;
+    return makeNode(ArcExpr::And, std::move(left), std::move(right));
+}
+
+std::unique_ptr<RETree> DFAToRegex::buildTree(const ArcExpr* expr) const {
+    switch (expr->kind) {
+        case ArcExpr::Leaf:
+            return expr->leaf->copy();
+        case ArcExpr::And:
+            return REAnd::make(buildTree(expr->left.get()), buildTree(expr->right.get()));
+        case ArcExpr::Or:
+            return REOr::make(buildTree(expr->left.get()), buildTree(expr->right.get()));
+        case ArcExpr::Iteration:
+            return REIteration::make(buildTree(expr->left.get()), buildTree(expr->right.get()));
+    }
+    throw std::runtime_error("DFAToRegex: unknown expression kind");
 }
 
-} // namespace syngt
\ No newline at end of file
+} // namespace syngt
@@ -0,0 +1,420 @@
+#include <syngt/analysis/LLkAnalyzer.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+namespace syngt {
+
+// ---------------------------------------------------------------------------
+// Lookahead computation
+// ---------------------------------------------------------------------------
+
+namespace {
+
+struct BudgetExceeded {};
+
+// Result of one choice point at a fixed k
+struct DecisionState {
+    std::string nonTerminal;
+    std::string kind;
+    const RETree* node = nullptr;
+    bool conflict = false;
+    std::vector<std::string> alternatives;
+    TokenTrie prefixes;
+};
+
+class LookaheadContext {
+public:
+    LookaheadContext(Grammar* grammar, int k, size_t limit,
+                     std::chrono::steady_clock::time_point deadline, bool timed)
+        : m_grammar(grammar), m_k(k), m_limit(limit), m_deadline(deadline), m_timed(timed) {
+        m_ntCount = static_cast<int>(grammar->getNonTerminals().size());
+        m_first.assign(m_ntCount, makeSet());
+        m_follow.assign(m_ntCount, makeSet());
+    }
+
+    const std::vector<TokenTrie>& first() const { return m_first; }
+    const std::vector<TokenTrie>& follow() const { return m_follow; }
+
+    TokenTrie makeSet() const {
+        TokenTrie set;
+        set.setLimit(m_limit);
+        return set;
+    }
+
+    TokenTrie emptySequence() const {
+        TokenTrie set = makeSet();
+        set.insert({});
+        return set;
+    }
+
+    // FIRST_k(tree · F)
+    TokenTrie firstOf(const RETree* tree, const TokenTrie& follow) {
+        checkTime();
+        if (!tree) return follow;
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            if (m_grammar->terminals()->getRawString(term->getID()).empty()) {
+                return follow;
+            }
+            TokenTrie head = makeSet();
+            head.insert({term->getID()});
+            return head.concat(follow, m_k);
+        }
+
+        if (dynamic_cast<const RESemantic*>(tree)) {
+            return follow;
+        }
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = nt->getID();
+            if (id < 0 || id >= m_ntCount) return makeSet();
+            return m_first[id].concat(follow, m_k);
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            TokenTrie result = firstOf(orNode->left(), follow);
+            result.unite(firstOf(orNode->right(), follow));
+            return result;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            return firstOf(andNode->left(), firstOf(andNode->right(), follow));
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            return iterationStart(iterNode, follow);
+        }
+
+        return makeSet();
+    }
+
+    // A#B = A(BA)*: least S with S = FIRST_k(A · (F ∪ FIRST_k(B · S)))
+    TokenTrie iterationStart(const REIteration* iterNode, const TokenTrie& follow) {
+        TokenTrie start = makeSet();
+        bool changed = true;
+        while (changed) {
+            TokenTrie afterA = follow;
+            afterA.unite(firstOf(iterNode->right(), start));
+            changed = start.unite(firstOf(iterNode->left(), afterA));
+        }
+        return start;
+    }
+
+    void computeFirst() {
+        TokenTrie eps = emptySequence();
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = 0; i < m_ntCount; ++i) {
+                NTListItem* item = m_grammar->getNTItemByIndex(i);
+                if (!item || !item->hasRoot()) continue;
+                if (m_first[i].unite(firstOf(item->root(), eps))) {
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    void computeFollow() {
+        if (m_ntCount == 0) return;
+        m_follow[0].insert({TokenTrie::EndOfInput});
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = 0; i < m_ntCount; ++i) {
+                NTListItem* item = m_grammar->getNTItemByIndex(i);
+                if (!item || !item->hasRoot()) continue;
+                TokenTrie context = m_follow[i];
+                walkFollow(item->root(), context, changed);
+            }
+        }
+    }
+
+    // Collect every choice point of every rule in a fixed traversal order
+    std::vector<DecisionState> collectDecisions() {
+        std::vector<DecisionState> decisions;
+        for (int i = 0; i < m_ntCount; ++i) {
+            NTListItem* item = m_grammar->getNTItemByIndex(i);
+            if (!item || !item->hasRoot()) continue;
+            TokenTrie context = m_follow[i];
+            walkDecisions(item->root(), context, item->name(), decisions);
+        }
+        return decisions;
+    }
+
+private:
+    Grammar* m_grammar;
+    int m_k;
+    int m_ntCount = 0;
+    size_t m_limit;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_timed;
+    std::vector<TokenTrie> m_first;
+    std::vector<TokenTrie> m_follow;
+
+    void checkTime() const {
+        if (m_timed && std::chrono::steady_clock::now() > m_deadline) {
+            throw BudgetExceeded();
+        }
+    }
+
+    void walkFollow(const RETree* tree, const TokenTrie& follow, bool& changed) {
+        if (!tree) return;
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = nt->getID();
+            if (id >= 0 && id < m_ntCount && m_follow[id].unite(follow)) {
+                changed = true;
+            }
+            return;
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            walkFollow(orNode->left(), follow, changed);
+            walkFollow(orNode->right(), follow, changed);
+            return;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            walkFollow(andNode->right(), follow, changed);
+            walkFollow(andNode->left(), firstOf(andNode->right(), follow), changed);
+            return;
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            TokenTrie start = iterationStart(iterNode, follow);
+            TokenTrie afterA = follow;
+            afterA.unite(firstOf(iterNode->right(), start));
+            walkFollow(iterNode->left(), afterA, changed);
+            walkFollow(iterNode->right(), start, changed);
+        }
+    }
+
+    static void flattenOr(const RETree* tree, std::vector<const RETree*>& out) {
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            flattenOr(orNode->left(), out);
+            flattenOr(orNode->right(), out);
+        } else {
+            out.push_back(tree);
+        }
+    }
+
+    static std::string describe(const RETree* tree) {
+        if (!tree) return "@";
+        SelectionMask emptyMask;
+        return tree->toString(emptyMask, false);
+    }
+
+    void recordConflicts(DecisionState& decision,
+                         const std::vector<const RETree*>& branches,
+                         const std::vector<std::string>& names,
+                         const std::vector<TokenTrie>& lookahead) {
+        std::vector<bool> involved(branches.size(), false);
+        for (size_t i = 0; i < lookahead.size(); ++i) {
+            for (size_t j = i + 1; j < lookahead.size(); ++j) {
+                if (!lookahead[i].intersects(lookahead[j])) continue;
+                decision.conflict = true;
+                involved[i] = involved[j] = true;
+                decision.prefixes.unite(lookahead[i].intersect(lookahead[j]));
+            }
+        }
+        for (size_t i = 0; i < branches.size(); ++i) {
+            if (involved[i]) decision.alternatives.push_back(names[i]);
+        }
+    }
+
+    void walkDecisions(const RETree* tree, const TokenTrie& follow,
+                       const std::string& ntName, std::vector<DecisionState>& out) {
+        if (!tree) return;
+
+        if (dynamic_cast<const REOr*>(tree)) {
+            std::vector<const RETree*> branches;
+            flattenOr(tree, branches);
+
+            std::vector<std::string> names;
+            std::vector<TokenTrie> lookahead;
+            for (const RETree* branch : branches) {
+                names.push_back(describe(branch));
+                lookahead.push_back(firstOf(branch, follow));
+            }
+
+            DecisionState decision;
+            decision.nonTerminal = ntName;
+            decision.kind = "alternative";
+            decision.node = tree;
+            recordConflicts(decision, branches, names, lookahead);
+            out.push_back(std::move(decision));
+
+            for (const RETree* branch : branches) {
+                walkDecisions(branch, follow, ntName, out);
+            }
+            return;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            walkDecisions(andNode->left(), firstOf(andNode->right(), follow), ntName, out);
+            walkDecisions(andNode->right(), follow, ntName, out);
+            return;
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            TokenTrie start = iterationStart(iterNode, follow);
+            TokenTrie repeat = firstOf(iterNode->right(), start);
+
+            DecisionState decision;
+            decision.nonTerminal = ntName;
+            decision.kind = "iteration";
+            decision.node = tree;
+            recordConflicts(decision, {iterNode->right(), nullptr},
+                            {"continue", "exit"}, {repeat, follow});
+            out.push_back(std::move(decision));
+
+            TokenTrie afterA = follow;
+            afterA.unite(repeat);
+            walkDecisions(iterNode->left(), afterA, ntName, out);
+            walkDecisions(iterNode->right(), start, ntName, out);
+        }
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+std::vector<TokenTrie> LLkAnalyzer::computeFirstK(Grammar* grammar, int k) {
+    if (!grammar || k < 1) return {};
+    LookaheadContext context(grammar, k, std::numeric_limits<size_t>::max(), {}, false);
+    context.computeFirst();
+    return context.first();
+}
+
+std::vector<TokenTrie> LLkAnalyzer::computeFollowK(Grammar* grammar, int k) {
+    if (!grammar || k < 1) return {};
+    LookaheadContext context(grammar, k, std::numeric_limits<size_t>::max(), {}, false);
+    context.computeFirst();
+    context.computeFollow();
+    return context.follow();
+}
+
+LLkReport LLkAnalyzer::analyze(Grammar* grammar, const LLkOptions& options) {
+    LLkReport report;
+    if (!grammar) return report;
+
+    bool timed = options.timeLimitMs > 0;
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(options.timeLimitMs);
+
+    // Indices (in traversal order) of decisions that conflict at k = 1
+    std::vector<size_t> tracked;
+
+    auto storePrefixes = [&](LLkDecision& decision, const TokenTrie& prefixes) {
+        decision.conflictingPrefixes = prefixes.sequences();
+        if (decision.conflictingPrefixes.size() > options.maxReportedPrefixes) {
+            decision.conflictingPrefixes.resize(options.maxReportedPrefixes);
+        }
+    };
+
+    // k = 1 is always checked, so an empty report really means LL(1)
+    const int maxK = std::max(options.maxK, 1);
+    for (int k = 1; k <= maxK; ++k) {
+        std::vector<DecisionState> states;
+        try {
+            LookaheadContext context(grammar, k, options.maxSetSize, deadline, timed);
+            context.computeFirst();
+            context.computeFollow();
+            states = context.collectDecisions();
+        } catch (const BudgetExceeded&) {
+            report.budgetExceeded = true;
+        } catch (const std::length_error&) {
+            report.budgetExceeded = true;
+        }
+
+        if (report.budgetExceeded) {
+            for (auto& decision : report.decisions) {
+                if (decision.minimalK == 0) decision.budgetExceeded = true;
+            }
+            break;
+        }
+
+        report.checkedK = k;
+
+        if (k == 1) {
+            for (size_t i = 0; i < states.size(); ++i) {
+                if (!states[i].conflict) continue;
+                LLkDecision decision;
+                decision.nonTerminal = states[i].nonTerminal;
+                decision.kind = states[i].kind;
+                SelectionMask emptyMask;
+                decision.location = states[i].node->toString(emptyMask, false);
+                decision.alternatives = states[i].alternatives;
+                storePrefixes(decision, states[i].prefixes);
+                report.decisions.push_back(std::move(decision));
+                tracked.push_back(i);
+            }
+        } else {
+            for (size_t d = 0; d < report.decisions.size(); ++d) {
+                LLkDecision& decision = report.decisions[d];
+                if (decision.minimalK != 0) continue;
+                const DecisionState& state = states[tracked[d]];
+                if (state.conflict) {
+                    storePrefixes(decision, state.prefixes);
+                } else {
+                    decision.minimalK = k;
+                }
+            }
+        }
+
+        bool pending = false;
+        for (const auto& decision : report.decisions) {
+            if (decision.minimalK == 0) pending = true;
+        }
+        if (!pending) break;
+    }
+
+    report.grammarK = 1;
+    for (const auto& decision : report.decisions) {
+        if (decision.minimalK == 0) {
+            report.grammarK = 0;
+            break;
+        }
+        if (decision.minimalK > report.grammarK) {
+            report.grammarK = decision.minimalK;
+        }
+    }
+    if (report.checkedK == 0) report.grammarK = 0;
+
+    return report;
+}
+
+std::string LLkAnalyzer::formatSequence(const Grammar* grammar, const std::vector<int>& sequence) {
+    std::string result;
+    for (size_t i = 0; i < sequence.size(); ++i) {
+        if (i > 0) result += " ";
+        int id = sequence[i];
+        if (id == TokenTrie::EndOfInput) {
+            result += "$";
+        } else if (grammar && id >= 0 && id < grammar->terminals()->getCount()) {
+            result += "'" + grammar->terminals()->getString(id) + "'";
+        } else {
+            result += "?";
+        }
+    }
+    return result.empty() ? "@" : result;
+}
+
+}
@@ -3,6 +3,7 @@
 #include <sstream>
 #include <algorithm>
 #include <iomanip>
+#include <cstdint>
 
 namespace syngt {
 
@@ -17,42 +18,45 @@ State MinimizationTable::createState() {
 }
 
 void MinimizationTable::linkStates(State from, State to, const std::string& symbol) {
-    findOrAddSymbol(symbol);
+    int symbolIndex = findOrAddSymbol(symbol);
     
-    auto key = std::make_pair(from, symbol);
-    auto it = m_table.find(key);
+    size_t needed = static_cast<size_t>(std::max(from, to)) + 1;
+    if (m_rows.size() < needed) {
+        m_rows.resize(needed);
+    }
     
-    if (it == m_table.end()) {
-        m_table[key] = std::make_unique<StatesSet>();
+    auto& row = m_rows[from];
+    if (static_cast<int>(row.size()) <= symbolIndex) {
+        row.resize(symbolIndex + 1);
     }
     
-    m_table[key]->addState(to);
+    row[symbolIndex].addState(to);
 }
 
 int MinimizationTable::findOrAddSymbol(const std::string& symbol) {
-    auto it = std::find(m_symbols.begin(), m_symbols.end(), symbol);
+    auto it = m_symbolIds.find(symbol);
     
-    if (it != m_symbols.end()) {
-        return static_cast<int>(std::distance(m_symbols.begin(), it));
+    if (it != m_symbolIds.end()) {
+        return it->second;
     }
     
+    int index = static_cast<int>(m_symbols.size());
     m_symbols.push_back(symbol);
-    return static_cast<int>(m_symbols.size() - 1);
+    m_symbolIds.emplace(symbol, index);
+    return index;
 }
 
 const StatesSet* MinimizationTable::getTableElement(State state, int symbolIndex) const {
-    if (symbolIndex < 0 || symbolIndex >= static_cast<int>(m_symbols.size())) {
+    if (state < 0 || state >= static_cast<State>(m_rows.size())) {
         return nullptr;
     }
     
-    auto key = std::make_pair(state, m_symbols[symbolIndex]);
-    auto it = m_table.find(key);
-    
-    if (it != m_table.end()) {
-        return it->second.get();
+    const auto& row = m_rows[state];
+    if (symbolIndex < 0 || symbolIndex >= static_cast<int>(row.size()) || row[symbolIndex].empty()) {
+        return nullptr;
     }
     
-    return nullptr;
+    return &row[symbolIndex];
 }
 
 const std::string& MinimizationTable::getSymbol(int index) const {
@@ -88,119 +92,397 @@ void MinimizationTable::setStateName(State state, const std::string& name) {
     m_stateNames[state] = name;
 }
 
-void MinimizationTable::minimize() {
-    // Port of Pascal TMinimizationTable.minimize() algorithm:
-    // Repeatedly find pairs of states with identical transitions and merge them.
-    // Two states can be merged if, for every symbol, their target state sets
-    // are equal (treating the two candidates as interchangeable).
-    // The FinalState is never merged with other states.
-
-    // Collect all states that appear in the table
-    std::set<State> allStates;
-    allStates.insert(StartState);
-    allStates.insert(FinalState);
-    for (const auto& entry : m_table) {
-        allStates.insert(entry.first.first);
-        for (State s : entry.second->getStates()) {
-            allStates.insert(s);
+int MinimizationTable::getUsedStatesCount() const {
+    std::set<State> used{StartState, FinalState};
+    for (State state = 0; state < static_cast<State>(m_rows.size()); ++state) {
+        for (const auto& cell : m_rows[state]) {
+            if (cell.empty()) continue;
+            used.insert(state);
+            used.insert(cell.getStates().begin(), cell.getStates().end());
         }
     }
+    return static_cast<int>(used.size());
+}
 
-    // Helper: normalize state (treat s1 == s2 as the same)
-    auto normalize = [](State s, State s1, State s2) -> State {
-        return (s == s2) ? s1 : s;
-    };
+// ---------------------------------------------------------------------------
+// Partition refinement
+// ---------------------------------------------------------------------------
 
-    // Helper: check if transition sets of s1 and s2 are equal (treating s1 ≡ s2)
-    auto setsEqual = [&](const StatesSet* ss1, const StatesSet* ss2,
-                         State s1, State s2) -> bool {
-        for (State t : ss1->getStates()) {
-            State nt = normalize(t, s1, s2);
-            bool found = false;
-            for (State t2 : ss2->getStates()) {
-                if (normalize(t2, s1, s2) == nt) { found = true; break; }
-            }
-            if (!found) return false;
+namespace {
+
+// Refinable partition of 0..size-1. Elements of a block are contiguous;
+// marking moves an element to the front of its block, and split() cuts the
+// marked prefix off as a new block.
+class Partition {
+public:
+    explicit Partition(int size)
+        : m_elements(size), m_location(size), m_blockOf(size, 0),
+          m_first{0}, m_end{size}, m_marked{0} {
+        for (int i = 0; i < size; ++i) {
+            m_elements[i] = i;
+            m_location[i] = i;
         }
-        for (State t : ss2->getStates()) {
-            State nt = normalize(t, s1, s2);
-            bool found = false;
-            for (State t1 : ss1->getStates()) {
-                if (normalize(t1, s1, s2) == nt) { found = true; break; }
+    }
+
+    int blockCount() const { return static_cast<int>(m_first.size()); }
+    int blockOf(int element) const { return m_blockOf[element]; }
+    int size(int block) const { return m_end[block] - m_first[block]; }
+
+    std::vector<int> members(int block) const {
+        return std::vector<int>(m_elements.begin() + m_first[block], m_elements.begin() + m_end[block]);
+    }
+
+    void mark(int element) {
+        int block = m_blockOf[element];
+        int position = m_location[element];
+        int boundary = m_first[block] + m_marked[block];
+        if (position < boundary) return;
+
+        std::swap(m_elements[position], m_elements[boundary]);
+        m_location[m_elements[position]] = position;
+        m_location[m_elements[boundary]] = boundary;
+        if (m_marked[block]++ == 0) m_touched.push_back(block);
+    }
+
+    // onSplit(oldBlock, newBlock) is called for every block actually split
+    template <typename Callback>
+    void split(Callback onSplit) {
+        for (int block : m_touched) {
+            int marked = m_marked[block];
+            m_marked[block] = 0;
+            if (marked == size(block)) continue;
+
+            int created = blockCount();
+            m_first.push_back(m_first[block]);
+            m_end.push_back(m_first[block] + marked);
+            m_marked.push_back(0);
+            m_first[block] += marked;
+            for (int i = m_first[created]; i < m_end[created]; ++i) {
+                m_blockOf[m_elements[i]] = created;
             }
-            if (!found) return false;
+            onSplit(block, created);
+        }
+        m_touched.clear();
+    }
+
+private:
+    std::vector<int> m_elements;
+    std::vector<int> m_location;
+    std::vector<int> m_blockOf;
+    std::vector<int> m_first;
+    std::vector<int> m_end;
+    std::vector<int> m_marked;
+    std::vector<int> m_touched;
+};
+
+} // namespace
+
+bool MinimizationTable::isDeterministic() const {
+    for (const auto& row : m_rows) {
+        for (const auto& cell : row) {
+            if (cell.count() > 1) return false;
+        }
+    }
+    return true;
+}
+
+std::vector<State> MinimizationTable::computeEquivalence() const {
+    int stateCount = std::max(static_cast<int>(m_rows.size()), static_cast<int>(m_nextState));
+    int symbolCount = getSymbolsCount();
+
+    // Only states that occur in the table take part (as the Pascal version did)
+    std::vector<int> index(stateCount, -1);
+    std::vector<State> states;
+    auto activate = [&](State state) {
+        if (index[state] < 0) {
+            index[state] = static_cast<int>(states.size());
+            states.push_back(state);
         }
-        return true;
     };
+    activate(StartState);
+    activate(FinalState);
+    for (State state = 0; state < static_cast<State>(m_rows.size()); ++state) {
+        for (const auto& cell : m_rows[state]) {
+            if (cell.empty()) continue;
+            activate(state);
+            for (State target : cell.getStates()) activate(target);
+        }
+    }
 
-    // Helper: can we merge s2 into s1?
-    auto canJoin = [&](State s1, State s2) -> bool {
-        if (s1 == FinalState || s2 == FinalState) return false;
-        for (const auto& sym : m_symbols) {
-            auto it1 = m_table.find({s1, sym});
-            auto it2 = m_table.find({s2, sym});
-            bool has1 = (it1 != m_table.end() && !it1->second->empty());
-            bool has2 = (it2 != m_table.end() && !it2->second->empty());
-            if (has1 != has2) return false;
-            if (!has1) continue;
-            if (!setsEqual(it1->second.get(), it2->second.get(), s1, s2)) return false;
+    // reverse[t] = (symbol, source) pairs sorted by symbol
+    int count = static_cast<int>(states.size());
+    std::vector<std::vector<std::pair<int, int>>> reverse(count);
+    for (int source = 0; source < count; ++source) {
+        State state = states[source];
+        if (state >= static_cast<State>(m_rows.size())) continue;
+        const auto& row = m_rows[state];
+        for (int symbol = 0; symbol < static_cast<int>(row.size()); ++symbol) {
+            for (State target : row[symbol].getStates()) {
+                reverse[index[target]].push_back({symbol, source});
+            }
         }
-        return true;
+    }
+    for (auto& list : reverse) std::sort(list.begin(), list.end());
+
+    // Initial partition: FinalState alone, everything else together
+    Partition partition(count);
+    partition.mark(index[FinalState]);
+    partition.split([](int, int) {});
+
+    // In a deterministic table a state has at most one successor per symbol,
+    // so stability against B and one half of B implies stability against the
+    // other half (Hopcroft). In an NFA both halves must be processed.
+    bool deterministic = isDeterministic();
+
+    std::vector<char> queued;
+    std::vector<std::pair<int, int>> worklist;
+    auto enqueue = [&](int block, int symbol) {
+        size_t key = static_cast<size_t>(block) * symbolCount + symbol;
+        if (queued.size() <= key) queued.resize((block + 1) * static_cast<size_t>(symbolCount), 0);
+        if (queued[key]) return;
+        queued[key] = 1;
+        worklist.push_back({block, symbol});
+    };
+    auto isQueued = [&](int block, int symbol) {
+        size_t key = static_cast<size_t>(block) * symbolCount + symbol;
+        return key < queued.size() && queued[key];
     };
 
-    // Helper: merge s2 into s1 — replace all s2 → s1 in the table, remove s2's rows
-    auto joinStates = [&](State s1, State s2) {
-        // Replace s2 with s1 in all target sets
-        for (auto& entry : m_table) {
-            if (entry.second->findState(s2)) {
-                auto newSS = std::make_unique<StatesSet>();
-                for (State t : entry.second->getStates()) {
-                    newSS->addState(t == s2 ? s1 : t);
+    for (int block = 0; block < partition.blockCount(); ++block) {
+        for (int symbol = 0; symbol < symbolCount; ++symbol) enqueue(block, symbol);
+    }
+
+    while (!worklist.empty()) {
+        auto [splitter, symbol] = worklist.back();
+        worklist.pop_back();
+        queued[static_cast<size_t>(splitter) * symbolCount + symbol] = 0;
+
+        for (int target : partition.members(splitter)) {
+            const auto& list = reverse[target];
+            auto it = std::lower_bound(list.begin(), list.end(), std::make_pair(symbol, 0));
+            for (; it != list.end() && it->first == symbol; ++it) {
+                partition.mark(it->second);
+            }
+        }
+
+        partition.split([&](int block, int created) {
+            for (int s = 0; s < symbolCount; ++s) {
+                if (isQueued(block, s) || !deterministic) {
+                    enqueue(block, s);
+                    enqueue(created, s);
+                } else {
+                    enqueue(partition.size(created) < partition.size(block) ? created : block, s);
                 }
-                entry.second = std::move(newSS);
+            }
+        });
+    }
+
+    // Representative of a class is its smallest state
+    std::vector<State> smallest(partition.blockCount(), -1);
+    for (int i = 0; i < count; ++i) {
+        State& best = smallest[partition.blockOf(i)];
+        if (best < 0 || states[i] < best) best = states[i];
+    }
+
+    std::vector<State> representative(stateCount);
+    for (State state = 0; state < stateCount; ++state) {
+        representative[state] = index[state] < 0 ? state : smallest[partition.blockOf(index[state])];
+    }
+    return representative;
+}
+
+void MinimizationTable::minimize() {
+    std::vector<State> representative = computeEquivalence();
+
+    // Keep rows of representatives only, redirecting targets to representatives
+    std::vector<std::vector<StatesSet>> rows(m_rows.size());
+    for (State state = 0; state < static_cast<State>(m_rows.size()); ++state) {
+        if (representative[state] != state) continue;
+        rows[state].resize(m_rows[state].size());
+        for (size_t symbol = 0; symbol < m_rows[state].size(); ++symbol) {
+            for (State target : m_rows[state][symbol].getStates()) {
+                rows[state][symbol].addState(representative[target]);
             }
         }
-        // Move s2's outgoing transitions to s1 (if s1 doesn't already have them)
-        for (const auto& sym : m_symbols) {
-            auto k2 = std::make_pair(s2, sym);
-            auto it2 = m_table.find(k2);
-            if (it2 != m_table.end()) {
-                auto k1 = std::make_pair(s1, sym);
-                if (m_table.find(k1) == m_table.end()) {
-                    auto newSS = std::make_unique<StatesSet>();
-                    for (State t : it2->second->getStates()) {
-                        newSS->addState(t == s2 ? s1 : t);
-                    }
-                    m_table[k1] = std::move(newSS);
+    }
+    m_rows = std::move(rows);
+}
+
+// ---------------------------------------------------------------------------
+// Subset construction
+// ---------------------------------------------------------------------------
+
+namespace {
+
+using StateBits = std::vector<uint64_t>;
+
+struct StateBitsHash {
+    size_t operator()(const StateBits& bits) const {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (uint64_t word : bits) {
+            hash ^= word;
+            hash *= 0x100000001b3ull;
+            hash ^= hash >> 29;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+bool testBit(const StateBits& bits, State state) {
+    return (bits[state / 64] >> (state % 64)) & 1;
+}
+
+bool setBit(StateBits& bits, State state) {
+    uint64_t mask = uint64_t{1} << (state % 64);
+    if (bits[state / 64] & mask) return false;
+    bits[state / 64] |= mask;
+    return true;
+}
+
+template <typename Visit>
+void forEachBit(const StateBits& bits, Visit visit) {
+    for (size_t w = 0; w < bits.size(); ++w) {
+        uint64_t word = bits[w];
+        for (int bit = 0; word; ++bit, word >>= 1) {
+            if (word & 1) visit(static_cast<State>(w * 64 + bit));
+        }
+    }
+}
+
+} // namespace
+
+bool MinimizationTable::determinize(size_t maxStates) {
+    int stateCount = std::max(static_cast<int>(m_rows.size()), static_cast<int>(m_nextState));
+    int symbolCount = getSymbolsCount();
+    size_t words = (static_cast<size_t>(stateCount) + 63) / 64;
+
+    auto epsilonIt = m_symbolIds.find(EpsilonSymbol);
+    int epsilon = epsilonIt == m_symbolIds.end() ? -1 : epsilonIt->second;
+
+    auto cell = [&](State state, int symbol) -> const StatesSet* {
+        if (state >= static_cast<State>(m_rows.size())) return nullptr;
+        const auto& row = m_rows[state];
+        return symbol < static_cast<int>(row.size()) ? &row[symbol] : nullptr;
+    };
+
+    std::vector<State> stack;
+    auto close = [&](StateBits& bits) {
+        if (epsilon < 0) return;
+        forEachBit(bits, [&](State state) { stack.push_back(state); });
+        while (!stack.empty()) {
+            State state = stack.back();
+            stack.pop_back();
+            if (const StatesSet* targets = cell(state, epsilon)) {
+                for (State target : targets->getStates()) {
+                    if (setBit(bits, target)) stack.push_back(target);
                 }
-                m_table.erase(k2);
             }
         }
     };
 
-    // Main loop: restart whenever a merge is performed (Pascal goto startLoop)
-    bool changed = true;
-    while (changed) {
-        changed = false;
-        std::vector<State> stateVec(allStates.begin(), allStates.end());
-        for (size_t i = 0; i < stateVec.size() && !changed; ++i) {
-            for (size_t j = i + 1; j < stateVec.size() && !changed; ++j) {
-                if (canJoin(stateVec[i], stateVec[j])) {
-                    joinStates(stateVec[i], stateVec[j]);
-                    allStates.erase(stateVec[j]);
-                    changed = true;
+    // Reachable subsets, numbered in discovery order (the start subset is 0)
+    std::vector<StateBits> subsets;
+    std::unordered_map<StateBits, int, StateBitsHash> index;
+    std::vector<std::vector<std::pair<int, int>>> moves;
+
+    StateBits start(words, 0);
+    setBit(start, StartState);
+    close(start);
+    index.emplace(start, 0);
+    subsets.push_back(std::move(start));
+    moves.emplace_back();
+
+    for (size_t current = 0; current < subsets.size(); ++current) {
+        for (int symbol = 0; symbol < symbolCount; ++symbol) {
+            if (symbol == epsilon) continue;
+
+            StateBits next(words, 0);
+            bool any = false;
+            forEachBit(subsets[current], [&](State state) {
+                if (const StatesSet* targets = cell(state, symbol)) {
+                    for (State target : targets->getStates()) any |= setBit(next, target);
                 }
+            });
+            if (!any) continue;
+            close(next);
+
+            auto found = index.find(next);
+            int target;
+            if (found != index.end()) {
+                target = found->second;
+            } else {
+                if (subsets.size() >= maxStates) return false;
+                target = static_cast<int>(subsets.size());
+                index.emplace(next, target);
+                subsets.push_back(std::move(next));
+                moves.emplace_back();
             }
+            moves[current].push_back({symbol, target});
         }
     }
-}
 
-void MinimizationTable::determinize() {
-    // Not needed: DFAToRegex handles NFA directly via state elimination
-}
+    // Drop subsets from which FinalState cannot be reached
+    int count = static_cast<int>(subsets.size());
+    std::vector<std::vector<int>> predecessors(count);
+    for (int from = 0; from < count; ++from) {
+        for (const auto& move : moves[from]) predecessors[move.second].push_back(from);
+    }
+    std::vector<bool> alive(count, false);
+    std::vector<int> queue;
+    for (int i = 0; i < count; ++i) {
+        if (testBit(subsets[i], FinalState)) {
+            alive[i] = true;
+            queue.push_back(i);
+        }
+    }
+    while (!queue.empty()) {
+        int current = queue.back();
+        queue.pop_back();
+        for (int from : predecessors[current]) {
+            if (!alive[from]) {
+                alive[from] = true;
+                queue.push_back(from);
+            }
+        }
+    }
+
+    // {FinalState} alone is FinalState itself unless FinalState has own moves
+    bool finalHasMoves = false;
+    for (int symbol = 0; symbol < symbolCount; ++symbol) {
+        const StatesSet* targets = cell(FinalState, symbol);
+        if (targets && !targets->empty()) finalHasMoves = true;
+    }
+    StateBits finalOnly(words, 0);
+    setBit(finalOnly, FinalState);
 
-void MinimizationTable::minimizeByEquivalence() {
-    // Implemented above in minimize()
+    std::vector<State> number(count, -1);
+    State next = 2;
+    number[0] = StartState;
+    for (int i = 1; i < count; ++i) {
+        if (!alive[i]) continue;
+        number[i] = (!finalHasMoves && subsets[i] == finalOnly) ? FinalState : next++;
+    }
+
+    int epsilonSymbol = findOrAddSymbol(EpsilonSymbol);
+    std::vector<std::vector<StatesSet>> rows(next);
+    for (int i = 0; i < count; ++i) {
+        State state = number[i];
+        if (state < 0 || state == FinalState) continue;
+        auto& row = rows[state];
+        row.resize(getSymbolsCount());
+        for (const auto& [symbol, target] : moves[i]) {
+            if (number[target] >= 0) row[symbol].addState(number[target]);
+        }
+        if (testBit(subsets[i], FinalState)) row[epsilonSymbol].addState(FinalState);
+    }
+
+    m_rows = std::move(rows);
+    m_nextState = next;
+    m_stateNames.clear();
+    for (State state = 2; state < next; ++state) {
+        m_stateNames[state] = "State" + std::to_string(state);
+    }
+    return true;
 }
 
 void MinimizationTable::writeToFile(const std::string& filename) const {
@@ -3,6 +3,7 @@
 #include <syngt/analysis/DFAToREGEX.h>
 #include <syngt/core/Grammar.h>
 #include <syngt/core/NTListItem.h>
+#include <syngt/core/SymbolSnapshot.h>
 #include <syngt/regex/RETree.h>
 #include <syngt/regex/REOr.h>
 #include <syngt/regex/REAnd.h>
@@ -10,9 +11,52 @@
 #include <syngt/regex/RETerminal.h>
 #include <syngt/regex/RESemantic.h>
 #include <syngt/regex/RENonTerminal.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace syngt {
 
+// ---------------------------------------------------------------------------
+// Table symbol of a leaf; epsilon is "\"\"" as fromMinimizationTable expects
+// ---------------------------------------------------------------------------
+
+static std::string leafSymbol(const RETree* node, Grammar* grammar) {
+    // --- RETerminal: the terminal symbol ---
+    if (auto termNode = dynamic_cast<const RETerminal*>(node)) {
+        // TerminalList::getString(0) returns "@" when m_items[0]="" — but we must
+        // store epsilon as "\"\"" in the table so fromMinimizationTable recognises it.
+        int epsilonId = grammar->findTerminal("");
+        bool isEpsilon = (epsilonId >= 0 && termNode->getID() == epsilonId);
+        return isEpsilon
+            ? EpsilonSymbol
+            : "\"" + grammar->getTerminalName(termNode->getID()) + "\"";
+    }
+
+    // --- RESemantic: epsilon ("@") or named semantic action ---
+    if (auto semNode = dynamic_cast<const RESemantic*>(node)) {
+        std::string name = grammar->getSemanticName(semNode->id());
+        if (name == "@") {
+            // epsilon — same as empty terminal
+            return EpsilonSymbol;
+        }
+        // Store with $ prefix so DFAToRegex recognises it as a semantic.
+        // name already contains '$' (e.g. "$add"), store as-is.
+        return name;
+    }
+
+    // --- RENonTerminal: the nonterminal name ---
+    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
+        return grammar->getNonTerminalName(ntNode->getID());
+    }
+
+    // Unknown node: treat as epsilon
+    return EpsilonSymbol;
+}
+
 // ---------------------------------------------------------------------------
 // buildMinimizationTable — external recursive visitor
 // (analog of TRE_Tree.buildMinimizationTable virtual method from Pascal)
@@ -45,96 +89,367 @@ static void buildMinimizationTable(const RETree* node,
     // --- REIteration(L, R): L#R = L(RL)* ---
     // Pascal algorithm:
     //   newState → finish (epsilon)
-    //   L: start → newState
-    //   R: newState → start  (loop back)
+    //   L: entry → newState
+    //   R: newState → entry  (loop back)
+    // The loop returns to a fresh entry state rather than to rec.start:
+    // rec.start may be shared with sibling alternatives, and looping back
+    // into it would let R be followed by those alternatives.
     if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
         const RETree* L = iterNode->left();
         const RETree* R = iterNode->right();
         if (!L || !R) return;
 
         State savedFinish = rec.finish;
+        State entry       = table.createState();
         State newState    = table.createState();
 
+        table.linkStates(rec.start, entry, "\"\"");
+
         // epsilon transition: newState → savedFinish
         table.linkStates(newState, savedFinish, "\"\"");
 
-        // Left operand: rec.start → newState
-        buildMinimizationTable(L, table, MinRecord{rec.start, newState}, grammar);
+        // Left operand: entry → newState
+        buildMinimizationTable(L, table, MinRecord{entry, newState}, grammar);
 
-        // Right operand: newState → rec.start (reversed — loop back)
-        buildMinimizationTable(R, table, MinRecord{newState, rec.start}, grammar);
+        // Right operand: newState → entry (reversed — loop back)
+        buildMinimizationTable(R, table, MinRecord{newState, entry}, grammar);
         return;
     }
 
-    // --- RETerminal: single transition on the terminal symbol ---
-    if (auto termNode = dynamic_cast<const RETerminal*>(node)) {
-        // TerminalList::getString(0) returns "@" when m_items[0]="" — but we must
-        // store epsilon as "\"\"" in the table so fromMinimizationTable recognises it.
-        int epsilonId = grammar->findTerminal("");
-        bool isEpsilon = (epsilonId >= 0 && termNode->getID() == epsilonId);
-        std::string sym = isEpsilon
-            ? "\"\""
-            : "\"" + grammar->getTerminalName(termNode->getID()) + "\"";
-        table.linkStates(rec.start, rec.finish, sym);
-        return;
+    // --- Leaves: single transition on the leaf symbol ---
+    table.linkStates(rec.start, rec.finish, leafSymbol(node, grammar));
+}
+
+// ---------------------------------------------------------------------------
+// buildGlushkovTable — position automaton
+//
+// Every symbol leaf is a position. One pass over the tree computes for each
+// node whether it is nullable and its first/last position sets, and fills
+// the follow set of every position. The automaton has StartState plus one
+// state per position, entered on that position's symbol; the only epsilon
+// arcs lead into FinalState.
+// ---------------------------------------------------------------------------
+
+namespace {
+
+using PositionSet = std::vector<uint64_t>;
+
+void addPosition(PositionSet& set, int position) {
+    size_t word = static_cast<size_t>(position) / 64;
+    if (set.size() <= word) set.resize(word + 1, 0);
+    set[word] |= uint64_t(1) << (position % 64);
+}
+
+void unite(PositionSet& target, const PositionSet& source) {
+    if (target.size() < source.size()) target.resize(source.size(), 0);
+    for (size_t i = 0; i < source.size(); ++i) {
+        target[i] |= source[i];
     }
+}
 
-    // --- RESemantic: epsilon ("@") or named semantic action ---
-    if (auto semNode = dynamic_cast<const RESemantic*>(node)) {
-        std::string name = grammar->getSemanticName(semNode->id());
-        if (name == "@") {
-            // epsilon — same as empty terminal
-            table.linkStates(rec.start, rec.finish, "\"\"");
-        } else {
-            // Store with $ prefix so DFAToRegex recognises it as a semantic.
-            // name already contains '$' (e.g. "$add"), store as-is.
-            table.linkStates(rec.start, rec.finish, name);
+template <typename Visit>
+void forEachPosition(const PositionSet& set, Visit visit) {
+    for (size_t word = 0; word < set.size(); ++word) {
+        uint64_t bits = set[word];
+        for (int bit = 0; bits != 0; ++bit, bits >>= 1) {
+            if (bits & 1) visit(static_cast<int>(word * 64 + bit));
         }
-        return;
     }
+}
 
-    // --- RENonTerminal: single transition on the nonterminal name ---
-    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
-        std::string sym = grammar->getNonTerminalName(ntNode->getID());
-        table.linkStates(rec.start, rec.finish, sym);
-        return;
+struct GlushkovNode {
+    bool nullable = true;
+    PositionSet first;
+    PositionSet last;
+};
+
+class GlushkovBuilder {
+public:
+    explicit GlushkovBuilder(Grammar* grammar) : m_grammar(grammar) {}
+
+    void build(const RETree* root, MinimizationTable& table) {
+        GlushkovNode result = visit(root);
+
+        std::vector<State> states(m_symbols.size());
+        for (State& state : states) {
+            state = table.createState();
+        }
+
+        forEachPosition(result.first, [&](int p) {
+            table.linkStates(StartState, states[p], m_symbols[p]);
+        });
+        for (size_t q = 0; q < m_follow.size(); ++q) {
+            forEachPosition(m_follow[q], [&](int p) {
+                table.linkStates(states[q], states[p], m_symbols[p]);
+            });
+        }
+        forEachPosition(result.last, [&](int p) {
+            table.linkStates(states[p], FinalState, EpsilonSymbol);
+        });
+        if (result.nullable) {
+            table.linkStates(StartState, FinalState, EpsilonSymbol);
+        }
     }
 
-    // Unknown node: treat as epsilon
-    table.linkStates(rec.start, rec.finish, "\"\"");
+private:
+    Grammar* m_grammar;
+    std::vector<std::string> m_symbols;     // Symbol of each position
+    std::vector<PositionSet> m_follow;      // Positions that may follow each position
+
+    // follow(p) |= to for every p in from
+    void link(const PositionSet& from, const PositionSet& to) {
+        forEachPosition(from, [&](int p) { unite(m_follow[p], to); });
+    }
+
+    GlushkovNode visit(const RETree* node) {
+        GlushkovNode result;
+        if (!node) return result;
+
+        if (auto orNode = dynamic_cast<const REOr*>(node)) {
+            GlushkovNode left = visit(orNode->left());
+            GlushkovNode right = visit(orNode->right());
+            result.nullable = left.nullable || right.nullable;
+            result.first = std::move(left.first);
+            unite(result.first, right.first);
+            result.last = std::move(left.last);
+            unite(result.last, right.last);
+            return result;
+        }
+
+        if (auto andNode = dynamic_cast<const REAnd*>(node)) {
+            GlushkovNode left = visit(andNode->left());
+            GlushkovNode right = visit(andNode->right());
+            link(left.last, right.first);
+            result.nullable = left.nullable && right.nullable;
+            result.first = left.first;
+            if (left.nullable) unite(result.first, right.first);
+            result.last = right.last;
+            if (right.nullable) unite(result.last, left.last);
+            return result;
+        }
+
+        // L#R = L(RL)*: L may be followed by R, R by L; a nullable part
+        // lets the other one follow itself
+        if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
+            const RETree* L = iterNode->left();
+            const RETree* R = iterNode->right();
+            if (!L || !R) {
+                result.nullable = false;    // No transitions, as in buildMinimizationTable
+                return result;
+            }
+
+            GlushkovNode left = visit(L);
+            GlushkovNode right = visit(R);
+            link(left.last, right.first);
+            link(right.last, left.first);
+            if (right.nullable) link(left.last, left.first);
+            if (left.nullable) link(right.last, right.first);
+
+            result.nullable = left.nullable;
+            result.first = left.first;
+            if (left.nullable) unite(result.first, right.first);
+            result.last = left.last;
+            if (left.nullable) unite(result.last, right.last);
+            return result;
+        }
+
+        std::string symbol = leafSymbol(node, m_grammar);
+        if (symbol == EpsilonSymbol) {
+            return result;
+        }
+
+        int position = static_cast<int>(m_symbols.size());
+        m_symbols.push_back(symbol);
+        m_follow.emplace_back();
+        result.nullable = false;
+        addPosition(result.first, position);
+        addPosition(result.last, position);
+        return result;
+    }
+};
+
+} // namespace
+
+static void buildGlushkovTable(const RETree* root, MinimizationTable& table, Grammar* grammar) {
+    GlushkovBuilder(grammar).build(root, table);
 }
 
 // ---------------------------------------------------------------------------
 // Public API
 // ---------------------------------------------------------------------------
 
-void Minimize::minimize(Grammar* grammar) {
-    if (!grammar) return;
+void Minimize::buildTable(const RETree* root, MinimizationTable& table, Grammar* grammar,
+                          MinimizeConstruction construction) {
+    if (construction == mcGlushkov) {
+        buildGlushkovTable(root, table, grammar);
+    } else {
+        MinRecord rec;  // {start: StartState=0, finish: FinalState=1}
+        buildMinimizationTable(root, table, rec, grammar);
+    }
+}
 
-    int count = static_cast<int>(grammar->getNonTerminals().size());
+// Minimize one automaton and convert it back to an RE; nullptr when a
+// symbol is missing from 'symbols'
+static std::unique_ptr<RETree> toRegex(MinimizationTable& table, Grammar* grammar,
+                                       const SymbolSnapshot* symbols, int& states,
+                                       const MinimizeOptions& options, MinimizeStats& stats) {
+    table.minimize();
+    states = table.getUsedStatesCount();
+
+    // State elimination (Arden's method), several orderings
+    auto converter = DFAToRegex::fromMinimizationTable(grammar, &table, symbols);
+    if (!converter) return nullptr;
+    auto orders = converter->removeAllStates(options.elimination);
+
+    size_t best = 0;
+    for (size_t i = 0; i < orders.size(); ++i) {
+        if (!orders[i].completed) {
+            ++stats.eliminationTimeouts;
+        } else if (orders[i].operationCount < orders[best].operationCount) {
+            best = i;
+        }
+    }
+    if (!orders.empty()) {
+        ++stats.orderWins[orders[best].order];
+    }
+    return converter->getRegularExpression();
+}
 
+namespace {
+
+struct RuleResult {
+    std::unique_ptr<RETree> root;
+    MinimizeStats stats;
+    bool missingSymbols = false;    // Needs a sequential rerun that adds symbols
+};
+
+}
+
+// The whole pipeline for one rule. With a snapshot the grammar is only read.
+static RuleResult minimizeRule(const RETree* root, Grammar* grammar,
+                               const SymbolSnapshot* symbols, const MinimizeOptions& options) {
+    RuleResult rule;
+    MinimizeStats& stats = rule.stats;
+
+    // 1. Build NFA from the RE tree
+    MinimizationTable table;
+    Minimize::buildTable(root, table, grammar, options.construction);
+    ++stats.rules;
+    stats.nfaStates += table.getUsedStatesCount();
+
+    std::unique_ptr<RETree> result;
+    int resultStates = 0;
+
+    // 2. Merge equivalent NFA states
+    if (options.automaton != maDFA) {
+        MinimizationTable nfa = table;
+        result = toRegex(nfa, grammar, symbols, resultStates, options, stats);
+        if (!result) {
+            rule.missingSymbols = true;
+            return rule;
+        }
+    }
+
+    // 3. Subset construction and DFA minimization
+    if (options.automaton != maNFA) {
+        if (table.determinize(options.maxDfaStates)) {
+            stats.dfaStates += table.getUsedStatesCount();
+            int states = 0;
+            auto dfaResult = toRegex(table, grammar, symbols, states, options, stats);
+            if (!dfaResult) {
+                rule.missingSymbols = true;
+                return rule;
+            }
+            if (!result || dfaResult->getOperationCount() < result->getOperationCount()) {
+                result = std::move(dfaResult);
+                resultStates = states;
+                ++stats.dfaChosen;
+            }
+        } else {
+            ++stats.budgetExceeded;
+            if (!result) {
+                result = toRegex(table, grammar, symbols, resultStates, options, stats);
+                if (!result) {
+                    rule.missingSymbols = true;
+                    return rule;
+                }
+            }
+        }
+    }
+    stats.minimizedStates += resultStates;
+
+    rule.root = std::move(result);
+    return rule;
+}
+
+static void accumulate(MinimizeStats& total, const MinimizeStats& rule) {
+    total.rules += rule.rules;
+    total.nfaStates += rule.nfaStates;
+    total.dfaStates += rule.dfaStates;
+    total.minimizedStates += rule.minimizedStates;
+    total.dfaChosen += rule.dfaChosen;
+    total.budgetExceeded += rule.budgetExceeded;
+    for (int order = 0; order < EliminationOrderCount; ++order) {
+        total.orderWins[order] += rule.orderWins[order];
+    }
+    total.eliminationTimeouts += rule.eliminationTimeouts;
+}
+
+MinimizeStats Minimize::minimize(Grammar* grammar, const MinimizeOptions& options) {
+    MinimizeStats stats;
+    if (!grammar) return stats;
+
+    std::vector<NTListItem*> rules;
+    int count = static_cast<int>(grammar->getNonTerminals().size());
     for (int i = 0; i < count; ++i) {
         NTListItem* nt = grammar->getNTItemByIndex(i);
-        if (!nt || !nt->root()) continue;
+        if (nt && nt->root()) rules.push_back(nt);
+    }
 
-        // 1. Build NFA from the RE tree
-        MinimizationTable table;
-        MinRecord rec;  // {start: StartState=0, finish: FinalState=1}
-        buildMinimizationTable(nt->root(), table, rec, grammar);
+    unsigned threads = options.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(rules.size()));
 
-        // 2. Minimize (merge equivalent states)
-        table.minimize();
+    if (threads <= 1) {
+        for (NTListItem* nt : rules) {
+            RuleResult rule = minimizeRule(nt->root(), grammar, nullptr, options);
+            accumulate(stats, rule.stats);
+            if (rule.root) nt->setRoot(std::move(rule.root));
+        }
+        return stats;
+    }
 
-        // 3. Convert minimized NFA back to RE using state elimination (Arden's method)
-        auto converter = DFAToRegex::fromMinimizationTable(grammar, &table);
-        converter->removeAllStates();
+    // Rules are independent; workers only read the grammar and resolve
+    // symbols against a snapshot. Rules are committed in order afterwards.
+    SymbolSnapshot symbols(grammar);
+    MinimizeOptions ruleOptions = options;
+    ruleOptions.elimination.threads = 1;
 
-        // 4. Set the resulting RE as the new rule
-        auto result = converter->getRegularExpression();
-        if (result) {
-            nt->setRoot(std::move(result));
+    std::vector<RuleResult> results(rules.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < rules.size(); i = next++) {
+            results[i] = minimizeRule(rules[i]->root(), grammar, &symbols, ruleOptions);
         }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
     }
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    for (size_t i = 0; i < rules.size(); ++i) {
+        // A symbol not yet in the grammar: redo this rule sequentially, adding
+        // it at the same point a sequential run would
+        if (results[i].missingSymbols) {
+            results[i] = minimizeRule(rules[i]->root(), grammar, nullptr, ruleOptions);
+        }
+        accumulate(stats, results[i].stats);
+        if (results[i].root) rules[i]->setRoot(std::move(results[i].root));
+    }
+
+    return stats;
 }
 
 } // namespace syngt
@@ -202,6 +202,7 @@ void ParsingTable::addRule(
         }
         conflict += "]";
         m_conflicts.push_back(conflict);
+        m_conflictDetails.push_back({nonTerminal, terminal, m_table[key], rule});
     }
     
     m_table[key] = rule;
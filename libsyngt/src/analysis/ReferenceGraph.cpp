@@ -0,0 +1,176 @@
+#include <syngt/analysis/ReferenceGraph.h>
+#include <syngt/analysis/YieldAnalysis.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+
+#include <algorithm>
+
+namespace syngt {
+
+namespace {
+
+class ReferenceCollector {
+public:
+    ReferenceCollector(const Grammar* grammar, ReferencePosition position,
+                       const std::vector<bool>& nullable)
+        : m_grammar(grammar), m_position(position), m_nullable(nullable) {}
+
+    // Collects references in the requested position while 'collecting';
+    // returns whether the subtree derives the empty string. Every node is
+    // visited once, so long ',' chains stay linear.
+    bool visit(const RETree* node, bool collecting, std::vector<int>& out) const {
+        if (!node) return false;
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(node)) {
+            int id = nt->getID();
+            if (collecting) out.push_back(id);
+            return id >= 0 && id < static_cast<int>(m_nullable.size()) && m_nullable[id];
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(node)) {
+            bool left = visit(orNode->left(), collecting, out);
+            bool right = visit(orNode->right(), collecting, out);
+            return left || right;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(node)) {
+            if (m_position == rpRightmost) {
+                bool right = visit(andNode->right(), collecting, out);
+                bool left = visit(andNode->left(), collecting && right, out);
+                return left && right;
+            }
+            bool left = visit(andNode->left(), collecting, out);
+            bool right = visit(andNode->right(), collecting && (left || m_position == rpAnywhere), out);
+            return left && right;
+        }
+
+        // A#B = A(BA)*: A is both first and last; B is reachable at either end
+        // only through an empty A
+        if (auto* iterNode = dynamic_cast<const REIteration*>(node)) {
+            bool left = visit(iterNode->left(), collecting, out);
+            visit(iterNode->right(), collecting && (left || m_position == rpAnywhere), out);
+            return left;
+        }
+
+        if (auto* term = dynamic_cast<const RETerminal*>(node)) {
+            return m_grammar->terminals()->getRawString(term->getID()).empty();
+        }
+
+        // Semantic actions consume no input
+        return dynamic_cast<const RESemantic*>(node) != nullptr;
+    }
+
+private:
+    const Grammar* m_grammar;
+    ReferencePosition m_position;
+    const std::vector<bool>& m_nullable;
+};
+
+}
+
+ReferenceGraph ReferenceGraph::build(const Grammar* grammar, ReferencePosition position) {
+    ReferenceGraph graph;
+    if (!grammar) return graph;
+
+    int count = static_cast<int>(grammar->getNonTerminals().size());
+    graph.m_successors.resize(count);
+
+    std::vector<bool> nullable(count, false);
+    if (position != rpAnywhere) {
+        auto yields = YieldAnalysis::analyze(grammar);
+        for (int i = 0; i < count && i < static_cast<int>(yields->size()); ++i) {
+            nullable[i] = (*yields)[i].productive && (*yields)[i].minLength == 0;
+        }
+    }
+
+    ReferenceCollector collector(grammar, position, nullable);
+    for (int i = 0; i < count; ++i) {
+        NTListItem* item = grammar->getNTItemByIndex(i);
+        if (!item || !item->root()) continue;
+
+        std::vector<int>& successors = graph.m_successors[i];
+        collector.visit(item->root(), true, successors);
+        successors.erase(std::remove_if(successors.begin(), successors.end(),
+                                        [count](int id) { return id < 0 || id >= count; }),
+                         successors.end());
+        std::sort(successors.begin(), successors.end());
+        successors.erase(std::unique(successors.begin(), successors.end()), successors.end());
+    }
+
+    return graph;
+}
+
+bool ReferenceGraph::hasSelfLoop(int nt) const {
+    const auto& successors = m_successors[nt];
+    return std::binary_search(successors.begin(), successors.end(), nt);
+}
+
+std::vector<std::vector<int>> ReferenceGraph::stronglyConnectedComponents() const {
+    return stronglyConnectedComponents(m_successors);
+}
+
+// Iterative Tarjan; components come out successors-first
+std::vector<std::vector<int>> ReferenceGraph::stronglyConnectedComponents(
+    const std::vector<std::vector<int>>& successors) {
+    int count = static_cast<int>(successors.size());
+    std::vector<std::vector<int>> components;
+    std::vector<int> index(count, -1), low(count, 0);
+    std::vector<bool> onStack(count, false);
+    std::vector<int> stack;
+    int counter = 0;
+
+    for (int root = 0; root < count; ++root) {
+        if (index[root] >= 0) continue;
+
+        std::vector<std::pair<int, size_t>> work = {{root, 0}};
+        index[root] = low[root] = counter++;
+        stack.push_back(root);
+        onStack[root] = true;
+
+        while (!work.empty()) {
+            auto& [v, next] = work.back();
+            if (next < successors[v].size()) {
+                int w = successors[v][next++];
+                if (index[w] < 0) {
+                    index[w] = low[w] = counter++;
+                    stack.push_back(w);
+                    onStack[w] = true;
+                    work.push_back({w, 0});
+                } else if (onStack[w]) {
+                    low[v] = std::min(low[v], index[w]);
+                }
+                continue;
+            }
+
+            if (low[v] == index[v]) {
+                std::vector<int> component;
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    component.push_back(w);
+                } while (w != v);
+                components.push_back(std::move(component));
+            }
+
+            int finished = v;
+            work.pop_back();
+            if (!work.empty()) {
+                int parent = work.back().first;
+                low[parent] = std::min(low[parent], low[finished]);
+            }
+        }
+    }
+
+    return components;
+}
+
+}
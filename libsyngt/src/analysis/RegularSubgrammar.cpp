@@ -0,0 +1,345 @@
+#include <syngt/analysis/RegularSubgrammar.h>
+#include <syngt/analysis/ReferenceGraph.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <syngt/regex/REStructure.h>
+#include <map>
+#include <utility>
+
+namespace syngt {
+
+// ---------------------------------------------------------------------------
+// RE construction helpers; nullptr stands for the empty language
+// ---------------------------------------------------------------------------
+
+static bool isEpsilonNode(const RETree* node) {
+    auto term = dynamic_cast<const RETerminal*>(node);
+    return term && term->getID() == 0;
+}
+
+static std::unique_ptr<RETree> makeEpsilon(Grammar* grammar) {
+    return std::make_unique<RETerminal>(grammar, 0);
+}
+
+static std::unique_ptr<RETree> createOr(std::unique_ptr<RETree> a, std::unique_ptr<RETree> b) {
+    if (!a) return b;
+    if (!b) return a;
+    return REOr::make(std::move(a), std::move(b));
+}
+
+static std::unique_ptr<RETree> createAnd(std::unique_ptr<RETree> a, std::unique_ptr<RETree> b) {
+    if (!a || !b) return nullptr;
+    if (isEpsilonNode(a.get())) return b;
+    if (isEpsilonNode(b.get())) return a;
+    return REAnd::make(std::move(a), std::move(b));
+}
+
+// left # right = left (right left)*; right = nullptr leaves left alone
+static std::unique_ptr<RETree> createIteration(std::unique_ptr<RETree> left,
+                                                std::unique_ptr<RETree> right) {
+    if (!left) return nullptr;
+    if (!right) return left;
+    return REIteration::make(std::move(left), std::move(right));
+}
+
+namespace {
+
+// Which end of a rule the references to its own component may occupy
+enum Linearity {
+    lnRight,    // X = constant ; b , Y ; ...
+    lnLeft      // X = constant ; Y , b ; ...
+};
+
+// One member of a component: X = constant ; Σ coefficient[Y] · Y, where
+// Y is a position in the component and '·' is taken from the linearity
+struct Equation {
+    std::unique_ptr<RETree> constant;
+    std::map<int, std::unique_ptr<RETree>> coefficients;
+};
+
+class ComponentSolver {
+public:
+    ComponentSolver(Grammar* grammar, const std::vector<int>& position,
+                    const std::vector<std::unique_ptr<RETree>>& regexes,
+                    const std::vector<int>& sizes, size_t maxNodes)
+        : m_grammar(grammar), m_position(position), m_regexes(regexes),
+          m_sizes(sizes), m_maxNodes(maxNodes) {}
+
+    // Every reference to the component lies at the given end of its rule
+    // and outside iterations
+    bool atEdgeOnly(const RETree* node, Linearity side, bool atEdge = true) const {
+        if (!node) return true;
+        if (auto orNode = dynamic_cast<const REOr*>(node)) {
+            return atEdgeOnly(orNode->left(), side, atEdge) &&
+                   atEdgeOnly(orNode->right(), side, atEdge);
+        }
+        if (auto andNode = dynamic_cast<const REAnd*>(node)) {
+            return atEdgeOnly(andNode->left(), side, atEdge && side == lnLeft) &&
+                   atEdgeOnly(andNode->right(), side, atEdge && side == lnRight);
+        }
+        if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
+            return atEdgeOnly(iterNode->left(), side, false) &&
+                   atEdgeOnly(iterNode->right(), side, false);
+        }
+        if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
+            return m_position[ntNode->getID()] < 0 || atEdge;
+        }
+        return true;
+    }
+
+    // Closed RE of every member, in component order; false over budget
+    bool solve(const std::vector<const RETree*>& rules, Linearity side,
+               std::vector<std::unique_ptr<RETree>>& closed) {
+        m_side = side;
+        m_nodes = 0;
+        std::vector<Equation> equations;
+        for (const RETree* rule : rules) {
+            equations.push_back(split(rule));
+            if (m_nodes > m_maxNodes) return false;
+        }
+
+        // Forward elimination: afterwards equation i refers only to members > i
+        int count = static_cast<int>(equations.size());
+        for (int i = 0; i < count; ++i) {
+            Equation& current = equations[i];
+            auto self = current.coefficients.find(i);
+            if (self != current.coefficients.end()) {
+                // Arden: X = b X ; rest  =>  X = b* rest
+                auto star = createIteration(makeEpsilon(m_grammar), std::move(self->second));
+                current.coefficients.erase(self);
+                current.constant = scaled(star.get(), std::move(current.constant));
+                for (auto& [member, coefficient] : current.coefficients) {
+                    coefficient = scaled(star.get(), std::move(coefficient));
+                }
+            }
+
+            for (int j = i + 1; j < count; ++j) {
+                auto found = equations[j].coefficients.find(i);
+                if (found == equations[j].coefficients.end()) continue;
+                auto factor = std::move(found->second);
+                equations[j].coefficients.erase(found);
+                substitute(equations[j], current, factor.get());
+            }
+            if (m_nodes > m_maxNodes) return false;
+        }
+
+        // Back substitution
+        closed.resize(count);
+        for (int i = count - 1; i >= 0; --i) {
+            auto result = std::move(equations[i].constant);
+            for (auto& [member, coefficient] : equations[i].coefficients) {
+                result = createOr(std::move(result),
+                                  scaled(coefficient.get(), copyOf(closed[member].get())));
+            }
+            if (result && static_cast<size_t>(nodeCount(result.get())) > m_maxNodes) return false;
+            closed[i] = std::move(result);
+        }
+        return true;
+    }
+
+private:
+    Grammar* m_grammar;
+    const std::vector<int>& m_position;                     // NT -> position in the component, or -1
+    const std::vector<std::unique_ptr<RETree>>& m_regexes;  // Closed REs of the solved NTs
+    const std::vector<int>& m_sizes;
+    size_t m_maxNodes;
+    Linearity m_side = lnRight;
+    size_t m_nodes = 0;                                     // Nodes copied from solved NTs
+
+    static std::unique_ptr<RETree> copyOf(const RETree* tree) {
+        return tree ? tree->copy() : nullptr;
+    }
+
+    // factor · term on the side where the component references stand
+    std::unique_ptr<RETree> scaled(const RETree* factor, std::unique_ptr<RETree> term) {
+        if (!factor || !term) return nullptr;
+        m_nodes += static_cast<size_t>(nodeCount(factor));
+        return m_side == lnRight ? createAnd(factor->copy(), std::move(term))
+                                 : createAnd(std::move(term), factor->copy());
+    }
+
+    // target += factor · source
+    void substitute(Equation& target, const Equation& source, const RETree* factor) {
+        target.constant = createOr(std::move(target.constant),
+                                   scaled(factor, copyOf(source.constant.get())));
+        for (const auto& [member, coefficient] : source.coefficients) {
+            auto& slot = target.coefficients[member];
+            slot = createOr(std::move(slot), scaled(factor, copyOf(coefficient.get())));
+            if (!slot) target.coefficients.erase(member);
+        }
+    }
+
+    // Right-hand side of a rule as an equation; solved NTs are substituted,
+    // semantics become epsilon, NTs without rules stay as symbols
+    Equation split(const RETree* node) {
+        Equation result;
+        if (!node || m_nodes > m_maxNodes) return result;
+
+        if (auto orNode = dynamic_cast<const REOr*>(node)) {
+            result = split(orNode->left());
+            Equation right = split(orNode->right());
+            result.constant = createOr(std::move(result.constant), std::move(right.constant));
+            for (auto& [member, coefficient] : right.coefficients) {
+                auto& slot = result.coefficients[member];
+                slot = createOr(std::move(slot), std::move(coefficient));
+            }
+            return result;
+        }
+
+        if (auto andNode = dynamic_cast<const REAnd*>(node)) {
+            // Only the edge operand may refer to the component
+            Equation edge = split(m_side == lnRight ? andNode->right() : andNode->left());
+            auto other = split(m_side == lnRight ? andNode->left() : andNode->right()).constant;
+            if (!other) return result;
+            result.constant = scaled(other.get(), std::move(edge.constant));
+            for (auto& [member, coefficient] : edge.coefficients) {
+                auto term = scaled(other.get(), std::move(coefficient));
+                if (term) result.coefficients.emplace(member, std::move(term));
+            }
+            return result;
+        }
+
+        if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
+            if (!iterNode->left() || !iterNode->right()) return result;
+            result.constant = createIteration(split(iterNode->left()).constant,
+                                              split(iterNode->right()).constant);
+            return result;
+        }
+
+        if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
+            int id = ntNode->getID();
+            if (m_position[id] >= 0) {
+                result.coefficients.emplace(m_position[id], makeEpsilon(m_grammar));
+            } else if (m_sizes[id] >= 0) {
+                m_nodes += static_cast<size_t>(m_sizes[id]);
+                result.constant = copyOf(m_regexes[id].get());
+            } else {
+                result.constant = node->copy();
+            }
+            return result;
+        }
+
+        if (dynamic_cast<const RESemantic*>(node)) {
+            result.constant = makeEpsilon(m_grammar);
+            return result;
+        }
+
+        result.constant = node->copy();
+        return result;
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+RegularSubgrammar RegularSubgrammar::analyze(Grammar* grammar, const RegularSubgrammarOptions& options) {
+    RegularSubgrammar result;
+    if (!grammar) return result;
+
+    int count = static_cast<int>(grammar->getNonTerminals().size());
+    result.m_entries.resize(count);
+    std::vector<std::unique_ptr<RETree>> regexes(count);
+    std::vector<int> sizes(count, -1);      // Node count of a solved NT's RE, -1 for NTs without rules
+    std::vector<int> position(count, -1);
+
+    ReferenceGraph graph = ReferenceGraph::build(grammar);
+    ComponentSolver solver(grammar, position, regexes, sizes, options.maxNodes);
+
+    // Components come after everything they reach
+    for (const auto& component : graph.stronglyConnectedComponents()) {
+        std::vector<const RETree*> rules;
+        for (int nt : component) {
+            NTListItem* item = grammar->getNTItemByIndex(nt);
+            if (item && item->root()) rules.push_back(item->root());
+        }
+        if (rules.size() != component.size()) continue;     // A single NT without a rule
+
+        for (size_t i = 0; i < component.size(); ++i) {
+            position[component[i]] = static_cast<int>(i);
+        }
+        auto setStatus = [&](RegularStatus status) {
+            for (int nt : component) result.m_entries[nt].status = status;
+        };
+
+        // Self-embedding check for recursive components
+        Linearity side = lnRight;
+        bool recursive = component.size() > 1 || graph.hasSelfLoop(component[0]);
+        bool linear = true;
+        if (recursive) {
+            auto allAtEdge = [&](Linearity edge) {
+                for (const RETree* rule : rules) {
+                    if (!solver.atEdgeOnly(rule, edge)) return false;
+                }
+                return true;
+            };
+            if (!allAtEdge(lnRight)) {
+                side = lnLeft;
+                linear = allAtEdge(lnLeft);
+            }
+        }
+
+        // The worst status among the referenced components
+        RegularStatus status = linear ? rsRegular : rsSelfEmbedding;
+        for (int nt : component) {
+            if (status != rsRegular) break;
+            for (int successor : graph.successors(nt)) {
+                if (position[successor] >= 0) continue;
+                RegularStatus referenced = result.m_entries[successor].status;
+                if (referenced == rsSelfEmbedding || referenced == rsNonRegularReference) {
+                    status = rsNonRegularReference;
+                    break;
+                }
+                if (referenced == rsTooLarge) status = rsTooLarge;
+            }
+        }
+
+        std::vector<std::unique_ptr<RETree>> closed;
+        if (status == rsRegular && !solver.solve(rules, side, closed)) {
+            status = rsTooLarge;
+        }
+        setStatus(status);
+        for (int nt : component) position[nt] = -1;
+        if (status != rsRegular) continue;
+
+        for (size_t i = 0; i < component.size(); ++i) {
+            int nt = component[i];
+            Entry& entry = result.m_entries[nt];
+            MinimizationTable table;
+            if (closed[i]) {
+                Minimize::buildTable(closed[i].get(), table, grammar, options.construction);
+            }
+            if (table.determinize(options.maxDfaStates)) {
+                table.minimize();
+                entry.dfa = std::make_unique<TokenDFA>(TokenDFA::fromMinimizationTable(table));
+            } else {
+                entry.status = rsTooLarge;
+            }
+            sizes[nt] = closed[i] ? nodeCount(closed[i].get()) : 0;
+            regexes[nt] = std::move(closed[i]);
+        }
+    }
+
+    for (int nt = 0; nt < count; ++nt) {
+        result.m_entries[nt].regex = std::move(regexes[nt]);
+    }
+    return result;
+}
+
+std::vector<int> RegularSubgrammar::regularNonTerminals() const {
+    std::vector<int> result;
+    for (int nt = 0; nt < size(); ++nt) {
+        if (m_entries[nt].status == rsRegular) result.push_back(nt);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,410 @@
+#include <syngt/analysis/RuleEquivalence.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace syngt {
+
+namespace {
+
+using Positions = std::vector<int>;     // Sorted
+
+Positions unite(const Positions& a, const Positions& b) {
+    Positions result;
+    result.reserve(a.size() + b.size());
+    std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Position automaton over symbol names
+//
+// Position 0 is the initial state; every symbol leaf is one more position.
+// ---------------------------------------------------------------------------
+
+struct PositionAutomaton {
+    std::vector<std::string> symbols{""};       // Symbol of each position
+    std::vector<Positions> follow{{}};          // Positions that may follow each position
+    std::vector<char> accepting{0};
+    bool overflow = false;                      // Position limit reached
+};
+
+struct PositionNode {
+    bool nullable = true;
+    Positions first;
+    Positions last;
+};
+
+class PositionBuilder {
+public:
+    PositionBuilder(const Grammar* grammar, const std::unordered_set<std::string>* inlined, int limit)
+        : m_grammar(grammar), m_inlined(inlined), m_limit(limit) {}
+
+    PositionAutomaton build(const RETree* root) {
+        PositionNode result = visit(root);
+        m_automaton.follow[0] = result.first;
+        m_automaton.accepting[0] = result.nullable;
+        for (int p : result.last) m_automaton.accepting[p] = 1;
+        for (Positions& follow : m_automaton.follow) {
+            std::sort(follow.begin(), follow.end());
+            follow.erase(std::unique(follow.begin(), follow.end()), follow.end());
+        }
+        return std::move(m_automaton);
+    }
+
+private:
+    const Grammar* m_grammar;
+    const std::unordered_set<std::string>* m_inlined;
+    int m_limit;
+    PositionAutomaton m_automaton;
+    std::vector<std::string> m_inlining;        // Stack of rules being substituted
+
+    void link(const Positions& from, const Positions& to) {
+        for (int p : from) {
+            auto& follow = m_automaton.follow[p];
+            follow.insert(follow.end(), to.begin(), to.end());
+        }
+    }
+
+    // Empty string for epsilon
+    std::string symbolOf(const RETree* node) const {
+        if (auto term = dynamic_cast<const RETerminal*>(node)) {
+            if (m_grammar->terminals()->getRawString(term->getID()).empty()) return "";
+            return "'" + m_grammar->getTerminalName(term->getID()) + "'";
+        }
+        if (auto sem = dynamic_cast<const RESemantic*>(node)) {
+            std::string name = m_grammar->getSemanticName(sem->id());
+            return name == "@" ? "" : name;
+        }
+        if (auto nt = dynamic_cast<const RENonTerminal*>(node)) {
+            return m_grammar->getNonTerminalName(nt->getID());
+        }
+        return "";
+    }
+
+    PositionNode visit(const RETree* node) {
+        PositionNode result;
+        if (!node) return result;
+
+        if (auto orNode = dynamic_cast<const REOr*>(node)) {
+            PositionNode left = visit(orNode->left());
+            PositionNode right = visit(orNode->right());
+            result.nullable = left.nullable || right.nullable;
+            result.first = unite(left.first, right.first);
+            result.last = unite(left.last, right.last);
+            return result;
+        }
+
+        if (auto andNode = dynamic_cast<const REAnd*>(node)) {
+            PositionNode left = visit(andNode->left());
+            PositionNode right = visit(andNode->right());
+            link(left.last, right.first);
+            result.nullable = left.nullable && right.nullable;
+            result.first = left.nullable ? unite(left.first, right.first) : left.first;
+            result.last = right.nullable ? unite(left.last, right.last) : right.last;
+            return result;
+        }
+
+        // L#R = L(RL)*, as in Minimize
+        if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
+            if (!iterNode->left() || !iterNode->right()) {
+                result.nullable = false;
+                return result;
+            }
+            PositionNode left = visit(iterNode->left());
+            PositionNode right = visit(iterNode->right());
+            link(left.last, right.first);
+            link(right.last, left.first);
+            if (right.nullable) link(left.last, left.first);
+            if (left.nullable) link(right.last, right.first);
+
+            result.nullable = left.nullable;
+            result.first = left.nullable ? unite(left.first, right.first) : left.first;
+            result.last = left.nullable ? unite(left.last, right.last) : left.last;
+            return result;
+        }
+
+        std::string symbol = symbolOf(node);
+        if (symbol.empty()) return result;
+
+        // Auxiliary rule of the transformed grammar: substitute its body
+        if (m_inlined && m_inlined->count(symbol) &&
+            std::find(m_inlining.begin(), m_inlining.end(), symbol) == m_inlining.end()) {
+            NTListItem* item = m_grammar->getNTItem(symbol);
+            if (item && item->root()) {
+                m_inlining.push_back(symbol);
+                result = visit(item->root());
+                m_inlining.pop_back();
+                return result;
+            }
+        }
+
+        if (static_cast<int>(m_automaton.symbols.size()) > m_limit) {
+            m_automaton.overflow = true;
+        }
+        int position = static_cast<int>(m_automaton.symbols.size());
+        m_automaton.symbols.push_back(symbol);
+        m_automaton.follow.emplace_back();
+        m_automaton.accepting.push_back(0);
+        result.nullable = false;
+        result.first = {position};
+        result.last = {position};
+        return result;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Hopcroft–Karp on the subset automata, built on the fly
+// ---------------------------------------------------------------------------
+
+struct PositionsHash {
+    size_t operator()(const Positions& positions) const {
+        size_t hash = positions.size();
+        for (int p : positions) {
+            hash ^= static_cast<size_t>(p) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+class EquivalenceChecker {
+public:
+    EquivalenceChecker(const PositionAutomaton& first, const PositionAutomaton& second, int limit)
+        : m_limit(limit) {
+        m_sides[0].automaton = &first;
+        m_sides[1].automaton = &second;
+
+        // Shared alphabet
+        std::unordered_map<std::string, int> alphabet;
+        for (Side& side : m_sides) {
+            for (const std::string& symbol : side.automaton->symbols) {
+                auto it = alphabet.emplace(symbol, static_cast<int>(m_alphabet.size()));
+                if (it.second) m_alphabet.push_back(symbol);
+                side.symbolIds.push_back(it.first->second);
+            }
+        }
+    }
+
+    EquivalenceResult run() {
+        EquivalenceResult result;
+        if (m_sides[0].automaton->overflow || m_sides[1].automaton->overflow) {
+            result.complete = false;
+            return result;
+        }
+
+        std::vector<Pair> pairs;
+        int start0 = state(0, {0});
+        int start1 = state(1, {0});
+        unite(start0, start1);
+        pairs.push_back({start0, start1, -1, -1});
+
+        for (size_t head = 0; head < pairs.size(); ++head) {
+            Pair pair = pairs[head];
+            bool accepted0 = accepting(0, pair.first);
+            bool accepted1 = accepting(1, pair.second);
+            if (accepted0 != accepted1) {
+                result.equivalent = false;
+                result.acceptedByFirst = accepted0;
+                for (int i = static_cast<int>(head); pairs[i].parent >= 0; i = pairs[i].parent) {
+                    result.counterexample.push_back(m_alphabet[pairs[i].symbol]);
+                }
+                std::reverse(result.counterexample.begin(), result.counterexample.end());
+                result.pairsExplored = static_cast<int>(head) + 1;
+                return result;
+            }
+
+            auto next0 = successors(0, pair.first);
+            auto next1 = successors(1, pair.second);
+            std::vector<int> symbols;
+            for (const auto& entry : next0) symbols.push_back(entry.first);
+            for (const auto& entry : next1) symbols.push_back(entry.first);
+            std::sort(symbols.begin(), symbols.end());
+            symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+
+            for (int symbol : symbols) {
+                auto it0 = next0.find(symbol);
+                auto it1 = next1.find(symbol);
+                int target0 = state(0, it0 != next0.end() ? it0->second : Positions());
+                int target1 = state(1, it1 != next1.end() ? it1->second : Positions());
+                if (unite(target0, target1)) {
+                    pairs.push_back({target0, target1, static_cast<int>(head), symbol});
+                }
+            }
+
+            if (static_cast<int>(m_parent.size()) > m_limit) {
+                result.complete = false;
+                result.pairsExplored = static_cast<int>(head) + 1;
+                return result;
+            }
+        }
+
+        result.pairsExplored = static_cast<int>(pairs.size());
+        return result;
+    }
+
+private:
+    struct Side {
+        const PositionAutomaton* automaton = nullptr;
+        std::vector<int> symbolIds;                                 // Per position
+        std::unordered_map<Positions, int, PositionsHash> ids;      // Subset -> union-find node
+        std::vector<const Positions*> subsets;                      // Union-find node -> subset
+    };
+
+    struct Pair {
+        int first;
+        int second;
+        int parent;
+        int symbol;
+    };
+
+    Side m_sides[2];
+    std::vector<std::string> m_alphabet;
+    std::vector<int> m_parent;          // Union-find over the states of both sides
+    int m_limit;
+
+    int state(int side, Positions positions) {
+        Side& s = m_sides[side];
+        auto it = s.ids.find(positions);
+        if (it != s.ids.end()) return it->second;
+
+        int node = static_cast<int>(m_parent.size());
+        m_parent.push_back(node);
+        auto inserted = s.ids.emplace(std::move(positions), node).first;
+        s.subsets.resize(node + 1, nullptr);
+        s.subsets[node] = &inserted->first;
+        return node;
+    }
+
+    int find(int node) {
+        while (m_parent[node] != node) {
+            m_parent[node] = m_parent[m_parent[node]];
+            node = m_parent[node];
+        }
+        return node;
+    }
+
+    // false if already in one class
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        m_parent[b] = a;
+        return true;
+    }
+
+    bool accepting(int side, int node) const {
+        const Side& s = m_sides[side];
+        for (int p : *s.subsets[node]) {
+            if (s.automaton->accepting[p]) return true;
+        }
+        return false;
+    }
+
+    std::map<int, Positions> successors(int side, int node) const {
+        const Side& s = m_sides[side];
+        std::map<int, Positions> result;
+        for (int p : *s.subsets[node]) {
+            for (int q : s.automaton->follow[p]) {
+                result[s.symbolIds[q]].push_back(q);
+            }
+        }
+        for (auto& entry : result) {
+            std::sort(entry.second.begin(), entry.second.end());
+            entry.second.erase(std::unique(entry.second.begin(), entry.second.end()), entry.second.end());
+        }
+        return result;
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+EquivalenceResult RuleEquivalence::check(const RETree* first, const Grammar* firstGrammar,
+                                         const RETree* second, const Grammar* secondGrammar,
+                                         int stateLimit) {
+    PositionAutomaton a = PositionBuilder(firstGrammar, nullptr, stateLimit).build(first);
+    PositionAutomaton b = PositionBuilder(secondGrammar, nullptr, stateLimit).build(second);
+    return EquivalenceChecker(a, b, stateLimit).run();
+}
+
+std::vector<RuleVerification> RuleEquivalence::verify(const Grammar* original, const Grammar* transformed,
+                                                      unsigned threads, int stateLimit) {
+    std::vector<RuleVerification> results;
+    if (!original || !transformed) return results;
+
+    std::vector<std::string> originalNames = original->getNonTerminals();
+    std::unordered_set<std::string> known(originalNames.begin(), originalNames.end());
+    std::unordered_set<std::string> auxiliary;
+    for (const std::string& name : transformed->getNonTerminals()) {
+        if (!known.count(name)) auxiliary.insert(name);
+    }
+
+    // Automata are built sequentially: only this part touches the grammars
+    std::vector<PositionAutomaton> left, right;
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < originalNames.size(); ++i) {
+        NTListItem* item = original->getNTItemByIndex(static_cast<int>(i));
+        if (!item || !item->root()) continue;
+
+        RuleVerification verification;
+        verification.name = originalNames[i];
+        NTListItem* counterpart = transformed->getNTItem(originalNames[i]);
+        if (!counterpart || !counterpart->root()) {
+            verification.missing = true;
+            verification.result.equivalent = false;
+            results.push_back(verification);
+            continue;
+        }
+
+        left.push_back(PositionBuilder(original, nullptr, stateLimit).build(item->root()));
+        right.push_back(PositionBuilder(transformed, &auxiliary, stateLimit).build(counterpart->root()));
+        pending.push_back(results.size());
+        results.push_back(verification);
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(pending.size()));
+
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < pending.size(); i = next++) {
+            results[pending[i]].result = EquivalenceChecker(left[i], right[i], stateLimit).run();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    return results;
+}
+
+std::string RuleEquivalence::wordToString(const std::vector<std::string>& word) {
+    if (word.empty()) return "@";
+    std::string result;
+    for (const std::string& symbol : word) {
+        if (!result.empty()) result += ' ';
+        result += symbol;
+    }
+    return result;
+}
+
+}
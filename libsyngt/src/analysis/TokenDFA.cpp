@@ -0,0 +1,106 @@
+#include <syngt/analysis/TokenDFA.h>
+#include <syngt/analysis/Minimization.h>
+#include <stdexcept>
+
+namespace syngt {
+
+TokenDFA TokenDFA::fromMinimizationTable(const MinimizationTable& table) {
+    TokenDFA dfa;
+
+    // Alphabet: every table symbol except the empty one
+    int tableSymbols = table.getSymbolsCount();
+    int epsilon = -1;
+    std::vector<int> column(tableSymbols, -1);
+    for (int s = 0; s < tableSymbols; ++s) {
+        const std::string& name = table.getSymbol(s);
+        if (name == EpsilonSymbol) {
+            epsilon = s;
+            continue;
+        }
+        column[s] = static_cast<int>(dfa.m_symbols.size());
+        dfa.m_symbolIds.emplace(name, column[s]);
+        dfa.m_symbols.push_back(name);
+    }
+    size_t width = dfa.m_symbols.size();
+
+    // Number the states reachable from StartState breadth-first
+    std::vector<int> number(table.getStatesCount(), DeadState);
+    std::vector<State> order{StartState};
+    number[StartState] = 0;
+    for (size_t i = 0; i < order.size(); ++i) {
+        State state = order[i];
+        dfa.m_next.resize((i + 1) * width, DeadState);
+        dfa.m_accepting.push_back(state == FinalState);
+
+        for (int s = 0; s < tableSymbols; ++s) {
+            const StatesSet* targets = table.getTableElement(state, s);
+            if (!targets) continue;
+            if (targets->count() != 1) {
+                throw std::invalid_argument("TokenDFA: the table is not deterministic");
+            }
+            State target = *targets->getStates().begin();
+            if (s == epsilon) {
+                if (target != FinalState) {
+                    throw std::invalid_argument("TokenDFA: the table is not deterministic");
+                }
+                dfa.m_accepting[i] = 1;
+                continue;
+            }
+            if (number[target] == DeadState) {
+                number[target] = static_cast<int>(order.size());
+                order.push_back(target);
+            }
+            dfa.m_next[i * width + column[s]] = number[target];
+        }
+    }
+
+    return dfa;
+}
+
+int TokenDFA::symbolIndex(const std::string& symbol) const {
+    auto it = m_symbolIds.find(symbol);
+    return it == m_symbolIds.end() ? -1 : it->second;
+}
+
+int TokenDFA::terminalIndex(const std::string& terminal) const {
+    return symbolIndex("\"" + terminal + "\"");
+}
+
+bool TokenDFA::matches(const std::vector<int>& symbols) const {
+    if (m_accepting.empty()) return false;
+    int state = startState();
+    for (int symbol : symbols) {
+        if (symbol < 0 || symbol >= symbolCount()) return false;
+        state = next(state, symbol);
+        if (state == DeadState) return false;
+    }
+    return accepting(state);
+}
+
+bool TokenDFA::matches(const std::vector<std::string>& tokens) const {
+    std::vector<int> symbols;
+    symbols.reserve(tokens.size());
+    for (const auto& token : tokens) {
+        int symbol = terminalIndex(token);
+        if (symbol < 0) symbol = symbolIndex(token);
+        if (symbol < 0) return false;
+        symbols.push_back(symbol);
+    }
+    return matches(symbols);
+}
+
+size_t TokenDFA::longestMatch(const std::vector<int>& symbols, size_t from) const {
+    if (m_accepting.empty()) return NoMatch;
+    int state = startState();
+    size_t longest = accepting(state) ? 0 : NoMatch;
+    for (size_t i = from; i < symbols.size(); ++i) {
+        int symbol = symbols[i];
+        if (symbol < 0 || symbol >= symbolCount()) break;
+        state = next(state, symbol);
+        if (state == DeadState) break;
+        if (accepting(state)) longest = i - from + 1;
+    }
+    return longest;
+}
+
+}
@@ -0,0 +1,181 @@
+#include <syngt/analysis/TokenTrie.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace syngt {
+
+TokenTrie::TokenTrie() {
+    m_nodes.emplace_back();
+}
+
+int TokenTrie::findChild(int node, int symbol) const {
+    const auto& children = m_nodes[node].children;
+    auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(symbol, 0),
+                               [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                                   return a.first < b.first;
+                               });
+    if (it != children.end() && it->first == symbol) {
+        return it->second;
+    }
+    return -1;
+}
+
+int TokenTrie::findOrAddChild(int node, int symbol) {
+    int existing = findChild(node, symbol);
+    if (existing >= 0) {
+        return existing;
+    }
+
+    int created = static_cast<int>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    auto& children = m_nodes[node].children;
+    auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(symbol, 0),
+                               [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+                                   return a.first < b.first;
+                               });
+    children.insert(it, {symbol, created});
+    return created;
+}
+
+void TokenTrie::markTerminal(int node) {
+    if (m_nodes[node].terminal) return;
+    if (m_size >= m_limit) {
+        throw std::length_error("TokenTrie: sequence limit exceeded");
+    }
+    m_nodes[node].terminal = true;
+    ++m_size;
+}
+
+bool TokenTrie::insert(const std::vector<int>& sequence) {
+    int node = 0;
+    for (int symbol : sequence) {
+        node = findOrAddChild(node, symbol);
+    }
+    if (m_nodes[node].terminal) return false;
+    markTerminal(node);
+    return true;
+}
+
+bool TokenTrie::contains(const std::vector<int>& sequence) const {
+    int node = 0;
+    for (int symbol : sequence) {
+        node = findChild(node, symbol);
+        if (node < 0) return false;
+    }
+    return m_nodes[node].terminal;
+}
+
+bool TokenTrie::unite(const TokenTrie& other) {
+    size_t before = m_size;
+
+    // Parallel walk over both tries; (other node, this node) pairs
+    std::vector<std::pair<int, int>> stack = {{0, 0}};
+    while (!stack.empty()) {
+        auto [from, to] = stack.back();
+        stack.pop_back();
+
+        if (other.m_nodes[from].terminal) {
+            markTerminal(to);
+        }
+        for (const auto& [symbol, child] : other.m_nodes[from].children) {
+            stack.push_back({child, findOrAddChild(to, symbol)});
+        }
+    }
+
+    return m_size != before;
+}
+
+TokenTrie TokenTrie::concat(const TokenTrie& tail, int k) const {
+    TokenTrie result;
+    result.m_limit = m_limit;
+
+    // Tail sequences truncated to each possible remaining length, built on demand
+    std::vector<std::vector<std::vector<int>>> truncatedTail(static_cast<size_t>(k) + 1);
+    std::vector<bool> truncatedReady(static_cast<size_t>(k) + 1, false);
+    auto tailFor = [&](int remaining) -> const std::vector<std::vector<int>>& {
+        if (!truncatedReady[remaining]) {
+            TokenTrie cut;
+            for (auto seq : tail.sequences()) {
+                if (static_cast<int>(seq.size()) > remaining) seq.resize(remaining);
+                cut.insert(seq);
+            }
+            truncatedTail[remaining] = cut.sequences();
+            truncatedReady[remaining] = true;
+        }
+        return truncatedTail[remaining];
+    };
+
+    for (const auto& head : sequences()) {
+        int length = static_cast<int>(head.size());
+        bool closed = length >= k || (!head.empty() && head.back() == EndOfInput);
+        if (closed) {
+            result.insert(head);
+            continue;
+        }
+        for (const auto& rest : tailFor(k - length)) {
+            std::vector<int> joined = head;
+            joined.insert(joined.end(), rest.begin(), rest.end());
+            result.insert(joined);
+        }
+    }
+
+    return result;
+}
+
+TokenTrie TokenTrie::intersect(const TokenTrie& other) const {
+    TokenTrie result;
+    const TokenTrie& smaller = m_size <= other.m_size ? *this : other;
+    const TokenTrie& larger = m_size <= other.m_size ? other : *this;
+    for (const auto& seq : smaller.sequences()) {
+        if (larger.contains(seq)) {
+            result.insert(seq);
+        }
+    }
+    return result;
+}
+
+bool TokenTrie::intersects(const TokenTrie& other) const {
+    std::vector<std::pair<int, int>> stack = {{0, 0}};
+    while (!stack.empty()) {
+        auto [a, b] = stack.back();
+        stack.pop_back();
+
+        if (m_nodes[a].terminal && other.m_nodes[b].terminal) return true;
+
+        for (const auto& [symbol, child] : m_nodes[a].children) {
+            int otherChild = other.findChild(b, symbol);
+            if (otherChild >= 0) {
+                stack.push_back({child, otherChild});
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<std::vector<int>> TokenTrie::sequences() const {
+    std::vector<std::vector<int>> result;
+    result.reserve(m_size);
+
+    std::vector<int> path;
+    // Iterative DFS: (node, index of next child to visit)
+    std::vector<std::pair<int, size_t>> stack = {{0, 0}};
+    if (m_nodes[0].terminal) result.push_back(path);
+
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        if (next < m_nodes[node].children.size()) {
+            auto [symbol, child] = m_nodes[node].children[next++];
+            path.push_back(symbol);
+            if (m_nodes[child].terminal) result.push_back(path);
+            stack.push_back({child, 0});
+        } else {
+            stack.pop_back();
+            if (!path.empty()) path.pop_back();
+        }
+    }
+
+    return result;
+}
+
+}
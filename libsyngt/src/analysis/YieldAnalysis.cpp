@@ -0,0 +1,535 @@
+#include <syngt/analysis/YieldAnalysis.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <tuple>
+
+namespace syngt {
+
+namespace {
+
+// Priority of a derivation: shortest yield first, then lowest derivation tree
+struct Cost {
+    size_t length = 0;
+    size_t height = 0;
+
+    bool operator<(const Cost& other) const {
+        return std::tie(length, height) < std::tie(other.length, other.height);
+    }
+};
+
+size_t addLengths(size_t a, size_t b) {
+    if (a == YieldAnalysis::Infinite || b == YieldAnalysis::Infinite) return YieldAnalysis::Infinite;
+    return a + b;
+}
+
+class YieldComputation {
+public:
+    explicit YieldComputation(const Grammar* grammar) : m_grammar(grammar) {
+        auto names = grammar->getNonTerminals();
+        m_ntCount = static_cast<int>(names.size());
+        m_table.resize(m_ntCount);
+        m_roots.assign(m_ntCount, nullptr);
+        for (int i = 0; i < m_ntCount; ++i) {
+            m_table[i].name = names[i];
+            NTListItem* item = grammar->getNTItemByIndex(i);
+            if (item && item->hasRoot()) m_roots[i] = item->root();
+        }
+    }
+
+    YieldAnalysis::Table run() {
+        computeShortest();
+        computeNonEmpty();
+        computeMaxLengths();
+        return std::move(m_table);
+    }
+
+private:
+    const Grammar* m_grammar;
+    int m_ntCount = 0;
+    YieldAnalysis::Table m_table;
+    std::vector<const RETree*> m_roots;
+    std::vector<bool> m_finalized;
+    std::vector<Cost> m_cost;
+    std::vector<bool> m_nonEmpty;
+
+    bool isEpsilon(const RETerminal* term) const {
+        return m_grammar->terminals()->getRawString(term->getID()).empty();
+    }
+
+    int ntIndex(const RENonTerminal* nt) const {
+        int id = nt->getID();
+        return (id >= 0 && id < m_ntCount) ? id : -1;
+    }
+
+    bool productive(int nt) const { return m_table[nt].productive; }
+
+    // -----------------------------------------------------------------------
+    // Shortest yields (Knuth)
+    // -----------------------------------------------------------------------
+
+    // Cost of the subtree using finalized nonterminals only
+    std::optional<Cost> eval(const RETree* tree) const {
+        if (!tree) return Cost{};
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            return Cost{isEpsilon(term) ? 0u : 1u, 0};
+        }
+
+        if (dynamic_cast<const RESemantic*>(tree)) return Cost{};
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ntIndex(nt);
+            if (id < 0 || !m_finalized[id]) return std::nullopt;
+            return m_cost[id];
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            auto left = eval(orNode->left());
+            auto right = eval(orNode->right());
+            if (!left) return right;
+            if (!right) return left;
+            return *right < *left ? right : left;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            auto left = eval(andNode->left());
+            if (!left) return std::nullopt;
+            auto right = eval(andNode->right());
+            if (!right) return std::nullopt;
+            return Cost{left->length + right->length, std::max(left->height, right->height)};
+        }
+
+        // A#B = A(BA)*: zero repetitions is always the cheapest
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            return eval(iterNode->left());
+        }
+
+        return std::nullopt;
+    }
+
+    // Materialize the string chosen by eval()
+    void build(const RETree* tree, std::vector<int>& out) const {
+        if (!tree) return;
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            if (!isEpsilon(term)) out.push_back(term->getID());
+            return;
+        }
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            const auto& yield = m_table[ntIndex(nt)].minYield;
+            out.insert(out.end(), yield.begin(), yield.end());
+            return;
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            auto left = eval(orNode->left());
+            auto right = eval(orNode->right());
+            bool takeRight = !left || (right && *right < *left);
+            build(takeRight ? orNode->right() : orNode->left(), out);
+            return;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            build(andNode->left(), out);
+            build(andNode->right(), out);
+            return;
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            build(iterNode->left(), out);
+        }
+    }
+
+    static void collectReferences(const RETree* tree, std::set<int>& out, int ntCount) {
+        if (!tree) return;
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            if (nt->getID() >= 0 && nt->getID() < ntCount) out.insert(nt->getID());
+            return;
+        }
+        collectReferences(tree->left(), out, ntCount);
+        collectReferences(tree->right(), out, ntCount);
+    }
+
+    void computeShortest() {
+        m_finalized.assign(m_ntCount, false);
+        m_cost.assign(m_ntCount, Cost{});
+
+        // users[X] = nonterminals whose rules mention X
+        std::vector<std::vector<int>> users(m_ntCount);
+        for (int i = 0; i < m_ntCount; ++i) {
+            std::set<int> refs;
+            collectReferences(m_roots[i], refs, m_ntCount);
+            for (int r : refs) users[r].push_back(i);
+        }
+
+        using Entry = std::tuple<size_t, size_t, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        std::vector<std::optional<Cost>> tentative(m_ntCount);
+
+        auto relax = [&](int nt) {
+            if (!m_roots[nt] || m_finalized[nt]) return;
+            auto value = eval(m_roots[nt]);
+            if (!value) return;
+            Cost cost{value->length, value->height + 1};
+            if (!tentative[nt] || cost < *tentative[nt]) {
+                tentative[nt] = cost;
+                queue.push({cost.length, cost.height, nt});
+            }
+        };
+
+        for (int i = 0; i < m_ntCount; ++i) relax(i);
+
+        while (!queue.empty()) {
+            auto [length, height, nt] = queue.top();
+            queue.pop();
+            if (m_finalized[nt]) continue;
+            if (tentative[nt]->length != length || tentative[nt]->height != height) continue;
+
+            m_finalized[nt] = true;
+            m_cost[nt] = *tentative[nt];
+
+            NTYield& entry = m_table[nt];
+            entry.productive = true;
+            build(m_roots[nt], entry.minYield);
+            entry.minLength = entry.minYield.size();
+            entry.minHeight = m_cost[nt].height;
+
+            for (int user : users[nt]) relax(user);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Maximum lengths
+    // -----------------------------------------------------------------------
+
+    // Productive subtree (treating nonterminals by the Knuth result)
+    bool productiveTree(const RETree* tree) const {
+        return eval(tree).has_value();
+    }
+
+    bool nonEmptyTree(const RETree* tree) const {
+        if (!tree) return false;
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) return !isEpsilon(term);
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ntIndex(nt);
+            return id >= 0 && m_nonEmpty[id];
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            return (productiveTree(orNode->left()) && nonEmptyTree(orNode->left())) ||
+                   (productiveTree(orNode->right()) && nonEmptyTree(orNode->right()));
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            return productiveTree(andNode->left()) && productiveTree(andNode->right()) &&
+                   (nonEmptyTree(andNode->left()) || nonEmptyTree(andNode->right()));
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            if (!productiveTree(iterNode->left())) return false;
+            return nonEmptyTree(iterNode->left()) ||
+                   (productiveTree(iterNode->right()) && nonEmptyTree(iterNode->right()));
+        }
+
+        return false;
+    }
+
+    void computeNonEmpty() {
+        m_nonEmpty.assign(m_ntCount, false);
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = 0; i < m_ntCount; ++i) {
+                if (m_nonEmpty[i] || !productive(i)) continue;
+                if (nonEmptyTree(m_roots[i])) {
+                    m_nonEmpty[i] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // Does the body of A#B contribute a non-empty string when repeated
+    bool pumpingIteration(const REIteration* iterNode) const {
+        return productiveTree(iterNode->right()) &&
+               (nonEmptyTree(iterNode->left()) || nonEmptyTree(iterNode->right()));
+    }
+
+    struct Edge {
+        int to;
+        bool nonEmptyContext;
+    };
+
+    void collectEdges(const RETree* tree, bool context, std::vector<Edge>& out) const {
+        if (!tree) return;
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ntIndex(nt);
+            if (id >= 0 && productive(id)) out.push_back({id, context});
+            return;
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            collectEdges(orNode->left(), context, out);
+            collectEdges(orNode->right(), context, out);
+            return;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            if (!productiveTree(andNode->left()) || !productiveTree(andNode->right())) return;
+            collectEdges(andNode->left(), context || nonEmptyTree(andNode->right()), out);
+            collectEdges(andNode->right(), context || nonEmptyTree(andNode->left()), out);
+            return;
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            if (!productiveTree(iterNode->left())) return;
+            bool loop = pumpingIteration(iterNode);
+            collectEdges(iterNode->left(), context || loop, out);
+            if (productiveTree(iterNode->right())) {
+                collectEdges(iterNode->right(), context || loop, out);
+            }
+        }
+    }
+
+    size_t maxLengthOf(const RETree* tree) const {
+        if (!tree) return 0;
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) return isEpsilon(term) ? 0 : 1;
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ntIndex(nt);
+            return id >= 0 ? m_table[id].maxLength : 0;
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            size_t result = 0;
+            if (productiveTree(orNode->left())) result = maxLengthOf(orNode->left());
+            if (productiveTree(orNode->right())) result = std::max(result, maxLengthOf(orNode->right()));
+            return result;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            return addLengths(maxLengthOf(andNode->left()), maxLengthOf(andNode->right()));
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            if (pumpingIteration(iterNode)) return YieldAnalysis::Infinite;
+            return maxLengthOf(iterNode->left());
+        }
+
+        return 0;
+    }
+
+    // Iterative Tarjan; components come out successors-first
+    std::vector<std::vector<int>> stronglyConnected(const std::vector<std::vector<Edge>>& graph) const {
+        std::vector<std::vector<int>> components;
+        std::vector<int> index(m_ntCount, -1), low(m_ntCount, 0);
+        std::vector<bool> onStack(m_ntCount, false);
+        std::vector<int> stack;
+        int counter = 0;
+
+        for (int root = 0; root < m_ntCount; ++root) {
+            if (index[root] >= 0) continue;
+
+            std::vector<std::pair<int, size_t>> work = {{root, 0}};
+            index[root] = low[root] = counter++;
+            stack.push_back(root);
+            onStack[root] = true;
+
+            while (!work.empty()) {
+                auto& [v, next] = work.back();
+                if (next < graph[v].size()) {
+                    int w = graph[v][next++].to;
+                    if (index[w] < 0) {
+                        index[w] = low[w] = counter++;
+                        stack.push_back(w);
+                        onStack[w] = true;
+                        work.push_back({w, 0});
+                    } else if (onStack[w]) {
+                        low[v] = std::min(low[v], index[w]);
+                    }
+                    continue;
+                }
+
+                if (low[v] == index[v]) {
+                    std::vector<int> component;
+                    int w;
+                    do {
+                        w = stack.back();
+                        stack.pop_back();
+                        onStack[w] = false;
+                        component.push_back(w);
+                    } while (w != v);
+                    components.push_back(std::move(component));
+                }
+
+                int finished = v;
+                work.pop_back();
+                if (!work.empty()) {
+                    int parent = work.back().first;
+                    low[parent] = std::min(low[parent], low[finished]);
+                }
+            }
+        }
+
+        return components;
+    }
+
+    void computeMaxLengths() {
+        std::vector<std::vector<Edge>> graph(m_ntCount);
+        for (int i = 0; i < m_ntCount; ++i) {
+            if (productive(i)) collectEdges(m_roots[i], false, graph[i]);
+        }
+
+        std::vector<int> componentOf(m_ntCount, -1);
+        auto components = stronglyConnected(graph);
+        for (size_t c = 0; c < components.size(); ++c) {
+            for (int nt : components[c]) componentOf[nt] = static_cast<int>(c);
+        }
+
+        for (size_t c = 0; c < components.size(); ++c) {
+            const auto& members = components[c];
+
+            bool pumping = false;
+            for (int nt : members) {
+                for (const Edge& edge : graph[nt]) {
+                    if (componentOf[edge.to] == static_cast<int>(c) && edge.nonEmptyContext) {
+                        pumping = true;
+                    }
+                }
+            }
+
+            if (pumping) {
+                for (int nt : members) {
+                    if (productive(nt)) m_table[nt].maxLength = YieldAnalysis::Infinite;
+                }
+                continue;
+            }
+
+            // No pumping cycle: lengths inside the component are bounded
+            bool changed = true;
+            while (changed) {
+                changed = false;
+                for (int nt : members) {
+                    if (!productive(nt)) continue;
+                    size_t length = maxLengthOf(m_roots[nt]);
+                    if (length > m_table[nt].maxLength) {
+                        m_table[nt].maxLength = length;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+};
+
+struct CacheEntry {
+    uint64_t revision;
+    std::shared_ptr<const YieldAnalysis::Table> table;
+};
+
+std::mutex s_cacheMutex;
+std::map<const Grammar*, CacheEntry> s_cache;
+const size_t MaxCacheEntries = 16;
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+YieldAnalysis::Table YieldAnalysis::compute(const Grammar* grammar) {
+    if (!grammar) return {};
+    return YieldComputation(grammar).run();
+}
+
+std::shared_ptr<const YieldAnalysis::Table> YieldAnalysis::analyze(const Grammar* grammar) {
+    if (!grammar) return std::make_shared<const Table>();
+
+    size_t ntCount = grammar->getNonTerminals().size();
+    {
+        std::lock_guard<std::mutex> lock(s_cacheMutex);
+        auto it = s_cache.find(grammar);
+        if (it != s_cache.end() && it->second.revision == grammar->revision() &&
+            it->second.table->size() == ntCount) {
+            return it->second.table;
+        }
+    }
+
+    auto table = std::make_shared<const Table>(compute(grammar));
+
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    if (s_cache.size() >= MaxCacheEntries && s_cache.count(grammar) == 0) {
+        s_cache.erase(s_cache.begin());
+    }
+    s_cache[grammar] = {grammar->revision(), table};
+    return table;
+}
+
+void YieldAnalysis::clearCache() {
+    std::lock_guard<std::mutex> lock(s_cacheMutex);
+    s_cache.clear();
+}
+
+std::optional<std::vector<int>> YieldAnalysis::minYieldOf(const RETree* tree,
+                                                          const Table& table,
+                                                          const Grammar* grammar) {
+    if (!tree) return std::vector<int>{};
+
+    if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+        if (grammar->terminals()->getRawString(term->getID()).empty()) return std::vector<int>{};
+        return std::vector<int>{term->getID()};
+    }
+
+    if (dynamic_cast<const RESemantic*>(tree)) return std::vector<int>{};
+
+    if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+        int id = nt->getID();
+        if (id < 0 || id >= static_cast<int>(table.size()) || !table[id].productive) {
+            return std::nullopt;
+        }
+        return table[id].minYield;
+    }
+
+    if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+        auto left = minYieldOf(orNode->left(), table, grammar);
+        auto right = minYieldOf(orNode->right(), table, grammar);
+        if (!left) return right;
+        if (!right) return left;
+        return right->size() < left->size() ? right : left;
+    }
+
+    if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+        auto left = minYieldOf(andNode->left(), table, grammar);
+        if (!left) return std::nullopt;
+        auto right = minYieldOf(andNode->right(), table, grammar);
+        if (!right) return std::nullopt;
+        left->insert(left->end(), right->begin(), right->end());
+        return left;
+    }
+
+    if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+        return minYieldOf(iterNode->left(), table, grammar);
+    }
+
+    return std::nullopt;
+}
+
+}
@@ -9,9 +9,12 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 
 namespace syngt {
 
+static std::atomic<uint64_t> s_revisionCounter{0};
+
 Grammar::Grammar() 
     : m_terminals(std::make_unique<TerminalList>())
     , m_semantics(std::make_unique<SemanticList>())
@@ -19,6 +22,11 @@ Grammar::Grammar()
     , m_macros(std::make_unique<MacroList>())
 {
     m_nonTerminals->setGrammar(this);
+    touch();
+}
+
+void Grammar::touch() {
+    m_revision = ++s_revisionCounter;
 }
 
 void Grammar::fillNew() {
@@ -31,6 +39,8 @@ void Grammar::fillNew() {
     m_nonTerminals->setGrammar(this);
     
     m_macros = std::make_unique<MacroList>();
+    
+    touch();
 }
 
 void Grammar::load(const std::string& filename) {
@@ -300,6 +310,15 @@ bool Grammar::hasRule(const std::string& name) const {
     return item && item->hasRoot();
 }
 
+std::string Grammar::freshNonTerminalName(const std::string& prefix) const {
+    int suffix = m_nonTerminals->getCount();
+    std::string name = prefix + "_" + std::to_string(suffix);
+    while (findNonTerminal(name) >= 0) {
+        name = prefix + "_" + std::to_string(++suffix);
+    }
+    return name;
+}
+
 void Grammar::regularize() {
     Regularize::regularize(this);
 }
@@ -0,0 +1,174 @@
+#include <syngt/core/GrammarSlice.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <stdexcept>
+
+namespace syngt {
+
+namespace {
+
+// Copies trees between grammars; symbols are matched by name once per id
+class SymbolTranslator {
+public:
+    SymbolTranslator(const Grammar* from, Grammar* to, std::vector<int> nonTerminals)
+        : m_from(from), m_to(to), m_nonTerminals(std::move(nonTerminals)),
+          m_terminals(from->terminals()->getCount(), -1),
+          m_semantics(from->semantics()->getCount(), -1) {}
+
+    std::unique_ptr<RETree> copy(const RETree* node) {
+        if (!node) return nullptr;
+
+        if (auto nt = dynamic_cast<const RENonTerminal*>(node)) {
+            return std::make_unique<RENonTerminal>(m_to, nonTerminal(nt->getID()), nt->isOpen());
+        }
+        if (auto term = dynamic_cast<const RETerminal*>(node)) {
+            return std::make_unique<RETerminal>(m_to, terminal(term->getID()));
+        }
+        if (auto sem = dynamic_cast<const RESemantic*>(node)) {
+            return std::make_unique<RESemantic>(m_to, semantic(sem->id()));
+        }
+
+        if (dynamic_cast<const REOr*>(node)) return REOr::make(copy(node->left()), copy(node->right()));
+        if (dynamic_cast<const REAnd*>(node)) return REAnd::make(copy(node->left()), copy(node->right()));
+        if (dynamic_cast<const REIteration*>(node)) {
+            return REIteration::make(copy(node->left()), copy(node->right()));
+        }
+        return node->copy();
+    }
+
+private:
+    template <typename Add>
+    static int lookup(std::vector<int>& cache, int id, Add add) {
+        if (id < 0) return id;
+        if (id >= static_cast<int>(cache.size())) cache.resize(id + 1, -1);
+        if (cache[id] < 0) cache[id] = add();
+        return cache[id];
+    }
+
+    int nonTerminal(int id) {
+        return lookup(m_nonTerminals, id, [&] { return m_to->addNonTerminal(m_from->getNonTerminalName(id)); });
+    }
+
+    int terminal(int id) {
+        return lookup(m_terminals, id, [&] { return m_to->addTerminal(m_from->terminals()->getRawString(id)); });
+    }
+
+    int semantic(int id) {
+        return lookup(m_semantics, id, [&] { return m_to->addSemantic(m_from->getSemanticName(id)); });
+    }
+
+    const Grammar* m_from;
+    Grammar* m_to;
+    std::vector<int> m_nonTerminals;
+    std::vector<int> m_terminals;
+    std::vector<int> m_semantics;
+};
+
+void collectReferences(const RETree* tree, std::vector<int>& out) {
+    std::vector<const RETree*> pending{tree};
+    while (!pending.empty()) {
+        const RETree* node = pending.back();
+        pending.pop_back();
+        if (!node) continue;
+        if (auto nt = dynamic_cast<const RENonTerminal*>(node)) {
+            out.push_back(nt->getID());
+            continue;
+        }
+        pending.push_back(node->right());
+        pending.push_back(node->left());
+    }
+}
+
+}
+
+GrammarSlice GrammarSlice::extract(const Grammar* grammar, const std::vector<int>& roots) {
+    GrammarSlice slice;
+    slice.m_grammar = std::make_unique<Grammar>();
+    slice.m_grammar->fillNew();
+    if (!grammar) return slice;
+
+    const int count = grammar->nonTerminals()->getCount();
+    slice.m_toSliced.assign(count, -1);
+
+    // BFS over nonterminal ids; the queue doubles as the slice order
+    auto visit = [&](int id) {
+        if (id < 0 || id >= count || slice.m_toSliced[id] >= 0) return;
+        slice.m_toSliced[id] = static_cast<int>(slice.m_toOriginal.size());
+        slice.m_toOriginal.push_back(id);
+    };
+    for (int root : roots) {
+        visit(root);
+    }
+    std::vector<int> referenced;
+    for (size_t head = 0; head < slice.m_toOriginal.size(); ++head) {
+        referenced.clear();
+        collectReferences(grammar->getNTItemByIndex(slice.m_toOriginal[head])->root(), referenced);
+        for (int id : referenced) {
+            visit(id);
+        }
+    }
+
+    Grammar* target = slice.m_grammar.get();
+    for (int id : slice.m_toOriginal) {
+        target->addNonTerminal(grammar->getNonTerminalName(id));
+    }
+    SymbolTranslator translator(grammar, target, slice.m_toSliced);
+    for (size_t i = 0; i < slice.m_toOriginal.size(); ++i) {
+        NTListItem* source = grammar->getNTItemByIndex(slice.m_toOriginal[i]);
+        NTListItem* item = target->getNTItemByIndex(static_cast<int>(i));
+        item->setMark(source->mark());
+        if (source->hasRoot()) item->setRoot(translator.copy(source->root()));
+    }
+    return slice;
+}
+
+GrammarSlice GrammarSlice::extract(const Grammar* grammar, const std::vector<std::string>& roots) {
+    std::vector<int> ids;
+    for (const auto& name : roots) {
+        int id = grammar ? grammar->findNonTerminal(name) : -1;
+        if (id < 0) throw std::invalid_argument("Unknown nonterminal: " + name);
+        ids.push_back(id);
+    }
+    return extract(grammar, ids);
+}
+
+int GrammarSlice::originalNonTerminal(int slicedId) const {
+    if (slicedId < 0 || slicedId >= static_cast<int>(m_toOriginal.size())) return -1;
+    return m_toOriginal[slicedId];
+}
+
+int GrammarSlice::slicedNonTerminal(int originalId) const {
+    if (originalId < 0 || originalId >= static_cast<int>(m_toSliced.size())) return -1;
+    return m_toSliced[originalId];
+}
+
+int GrammarSlice::writeBack(Grammar* original) const {
+    if (!original || !m_grammar) return 0;
+
+    const int count = m_grammar->nonTerminals()->getCount();
+    std::vector<int> toOriginal(m_toOriginal);
+    for (int i = static_cast<int>(m_toOriginal.size()); i < count; ++i) {
+        std::string base = m_grammar->getNonTerminalName(i);
+        std::string name = base;
+        for (int suffix = 1; original->findNonTerminal(name) >= 0; ++suffix) {
+            name = base + "_" + std::to_string(suffix);
+        }
+        toOriginal.push_back(original->addNonTerminal(name));
+    }
+
+    SymbolTranslator translator(m_grammar.get(), original, toOriginal);
+    for (int i = 0; i < count; ++i) {
+        NTListItem* item = m_grammar->getNTItemByIndex(i);
+        original->getNTItemByIndex(toOriginal[i])->setRoot(translator.copy(item->root()));
+    }
+    return count;
+}
+
+}
@@ -21,11 +21,13 @@ NTListItem& NTListItem::operator=(NTListItem&&) noexcept = default;
 void NTListItem::setValue(const std::string& value) {
     m_value = value;
     setRootFromValue();
+    if (m_grammar) m_grammar->touch();
 }
 
 void NTListItem::setRoot(std::unique_ptr<RETree> root) {
     m_root = std::move(root);
     setValueFromRoot();
+    if (m_grammar) m_grammar->touch();
 }
 
 void NTListItem::setValueFromRoot() {
@@ -59,6 +61,7 @@ void NTListItem::setRootFromValue() {
 
 void NTListItem::updateValueFromRoot() {
     setValueFromRoot();
+    if (m_grammar) m_grammar->touch();
 }
 
 std::unique_ptr<RETree> NTListItem::copyRETree() const {
@@ -7,7 +7,9 @@ namespace syngt {
 void NonTerminalList::fillNew() {
     m_list.clear();
     m_items.clear();
+    m_index.clear();
     
+    m_index["S"] = 0;
     m_list.push_back("S");
     
     auto item = std::make_unique<NTListItem>(m_grammar, "S");
@@ -20,6 +22,7 @@ int NonTerminalList::add(const std::string& s) {
         return existingIndex;
     }
     
+    m_index[s] = static_cast<int>(m_list.size());
     m_list.push_back(s);
     
     auto item = std::make_unique<NTListItem>(m_grammar, s);
@@ -31,6 +34,7 @@ int NonTerminalList::add(const std::string& s) {
 void NonTerminalList::clear() {
     m_list.clear();
     m_items.clear();
+    m_index.clear();
 }
 
 void NonTerminalList::setGrammar(Grammar* grammar) {
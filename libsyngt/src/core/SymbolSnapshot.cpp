@@ -0,0 +1,41 @@
+#include <syngt/core/SymbolSnapshot.h>
+#include <syngt/core/Grammar.h>
+
+namespace syngt {
+
+namespace {
+
+// First occurrence wins, as in the list find() methods
+void index(std::unordered_map<std::string, int>& map, const std::vector<std::string>& names) {
+    map.reserve(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        map.emplace(names[i], static_cast<int>(i));
+    }
+}
+
+int lookup(const std::unordered_map<std::string, int>& map, const std::string& name) {
+    auto it = map.find(name);
+    return it != map.end() ? it->second : -1;
+}
+
+}
+
+SymbolSnapshot::SymbolSnapshot(const Grammar* grammar) {
+    index(m_terminals, grammar->getTerminals());
+    index(m_nonTerminals, grammar->getNonTerminals());
+    index(m_semantics, grammar->getSemantics());
+}
+
+int SymbolSnapshot::findTerminal(const std::string& name) const {
+    return lookup(m_terminals, name);
+}
+
+int SymbolSnapshot::findNonTerminal(const std::string& name) const {
+    return lookup(m_nonTerminals, name);
+}
+
+int SymbolSnapshot::findSemantic(const std::string& name) const {
+    return lookup(m_semantics, name);
+}
+
+}
@@ -0,0 +1,526 @@
+#include <syngt/generate/CoverageSuite.h>
+#include <syngt/analysis/YieldAnalysis.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+namespace syngt {
+
+namespace {
+
+using GoalSet = std::vector<uint64_t>;
+
+struct Cost {
+    size_t length = 0;
+    size_t height = 0;
+
+    bool operator<(const Cost& other) const {
+        return std::tie(length, height) < std::tie(other.length, other.height);
+    }
+};
+
+// Terminal string of a partial derivation and the goals it passes through
+struct Witness {
+    std::vector<int> tokens;
+    GoalSet goals;
+};
+
+// Derivation around a node of a rule: before <node> after
+struct Context {
+    std::vector<int> before;
+    std::vector<int> after;
+    GoalSet goals;
+};
+
+void unite(GoalSet& target, const GoalSet& source) {
+    for (size_t i = 0; i < target.size(); ++i) target[i] |= source[i];
+}
+
+void mark(GoalSet& set, size_t goal) {
+    set[goal / 64] |= uint64_t{1} << (goal % 64);
+}
+
+bool contains(const GoalSet& set, size_t goal) {
+    return (set[goal / 64] >> (goal % 64)) & 1;
+}
+
+size_t countNew(const GoalSet& set, const GoalSet& uncovered) {
+    size_t result = 0;
+    for (size_t i = 0; i < set.size(); ++i) {
+        uint64_t bits = set[i] & uncovered[i];
+        while (bits) {
+            bits &= bits - 1;
+            ++result;
+        }
+    }
+    return result;
+}
+
+class CoverageBuilder {
+public:
+    explicit CoverageBuilder(const Grammar* grammar)
+        : m_grammar(grammar), m_yields(YieldAnalysis::analyze(grammar)) {
+        auto names = grammar->getNonTerminals();
+        m_ntCount = static_cast<int>(names.size());
+        m_names = names;
+        m_roots.assign(m_ntCount, nullptr);
+        m_occurrences.resize(m_ntCount);
+        for (int i = 0; i < m_ntCount; ++i) {
+            NTListItem* item = grammar->getNTItemByIndex(i);
+            if (item && item->hasRoot()) m_roots[i] = item->root();
+        }
+    }
+
+    CoverageReport run() {
+        for (int i = 0; i < m_ntCount; ++i) collectGoals(m_roots[i], nullptr, i);
+        m_words = (m_goals.size() + 63) / 64;
+
+        m_ntWitness.resize(m_ntCount);
+        m_ntWitnessDone.assign(m_ntCount, false);
+        computeContexts();
+
+        CoverageReport report;
+        report.goals = m_goals;
+        selectSentences(report);
+        return report;
+    }
+
+private:
+    enum class GoalKind { Alternative, Iteration, EmptyIteration, Semantic };
+
+    struct Occurrence {
+        const RETree* node;
+        int target;
+    };
+
+    const Grammar* m_grammar;
+    std::shared_ptr<const YieldAnalysis::Table> m_yields;
+    int m_ntCount = 0;
+    size_t m_words = 0;
+    std::vector<std::string> m_names;
+    std::vector<const RETree*> m_roots;
+
+    std::vector<CoverageGoal> m_goals;
+    std::vector<const RETree*> m_goalNodes;
+    std::vector<GoalKind> m_goalKinds;
+    std::vector<int> m_goalOwners;
+    std::unordered_map<const RETree*, std::vector<size_t>> m_nodeGoals;   // Alternatives, semantics
+    std::unordered_map<const RETree*, std::pair<size_t, size_t>> m_iterationGoals;
+    std::unordered_map<const RETree*, const RETree*> m_parent;
+    std::vector<std::vector<Occurrence>> m_occurrences;
+
+    std::vector<std::optional<Witness>> m_ntWitness;
+    std::vector<bool> m_ntWitnessDone;
+    std::vector<std::optional<Context>> m_contexts;
+
+    bool isEpsilon(const RETerminal* term) const {
+        return m_grammar->terminals()->getRawString(term->getID()).empty();
+    }
+
+    int ntIndex(const RENonTerminal* nt) const {
+        int id = nt->getID();
+        return (id >= 0 && id < m_ntCount) ? id : -1;
+    }
+
+    Witness emptyWitness() const { return Witness{{}, GoalSet(m_words, 0)}; }
+
+    // -----------------------------------------------------------------------
+    // Goals
+    // -----------------------------------------------------------------------
+
+    size_t addGoal(const RETree* node, GoalKind kind, int owner) {
+        static const char* kindNames[] = {"alternative", "iteration", "empty iteration", "semantic"};
+        SelectionMask emptyMask;
+
+        CoverageGoal goal;
+        goal.nonTerminal = m_names[owner];
+        goal.kind = kindNames[static_cast<int>(kind)];
+        goal.location = node->toString(emptyMask, false);
+
+        m_goals.push_back(goal);
+        m_goalNodes.push_back(node);
+        m_goalKinds.push_back(kind);
+        m_goalOwners.push_back(owner);
+        return m_goals.size() - 1;
+    }
+
+    static void collectAlternatives(const RETree* tree, std::vector<const RETree*>& out) {
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            collectAlternatives(orNode->left(), out);
+            collectAlternatives(orNode->right(), out);
+            return;
+        }
+        if (tree) out.push_back(tree);
+    }
+
+    void collectGoals(const RETree* tree, const RETree* parent, int owner) {
+        if (!tree) return;
+        m_parent[tree] = parent;
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ntIndex(nt);
+            if (id >= 0) m_occurrences[owner].push_back({tree, id});
+            return;
+        }
+
+        if (dynamic_cast<const RESemantic*>(tree)) {
+            m_nodeGoals[tree].push_back(addGoal(tree, GoalKind::Semantic, owner));
+            return;
+        }
+
+        // A chain of ';' is one choice between its flattened alternatives
+        if (dynamic_cast<const REOr*>(tree) && !dynamic_cast<const REOr*>(parent)) {
+            std::vector<const RETree*> alternatives;
+            collectAlternatives(tree, alternatives);
+            for (const RETree* alternative : alternatives) {
+                m_nodeGoals[alternative].push_back(addGoal(alternative, GoalKind::Alternative, owner));
+            }
+        }
+
+        if (dynamic_cast<const REIteration*>(tree)) {
+            size_t repeat = addGoal(tree, GoalKind::Iteration, owner);
+            size_t skip = addGoal(tree, GoalKind::EmptyIteration, owner);
+            m_iterationGoals[tree] = {repeat, skip};
+        }
+
+        collectGoals(tree->left(), tree, owner);
+        collectGoals(tree->right(), tree, owner);
+    }
+
+    void markNode(const RETree* node, GoalSet& goals) const {
+        auto it = m_nodeGoals.find(node);
+        if (it == m_nodeGoals.end()) return;
+        for (size_t goal : it->second) mark(goals, goal);
+    }
+
+    // -----------------------------------------------------------------------
+    // Shortest derivations
+    //
+    // Choices follow YieldAnalysis: with its (length, height) costs every NT
+    // in the shortest derivation of X is strictly lower than X, so witness
+    // expansion is well-founded and yields minYield of each NT.
+    // -----------------------------------------------------------------------
+
+    std::optional<Cost> eval(const RETree* tree) const {
+        if (!tree) return Cost{};
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            return Cost{isEpsilon(term) ? 0u : 1u, 0};
+        }
+
+        if (dynamic_cast<const RESemantic*>(tree)) return Cost{};
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ntIndex(nt);
+            if (id < 0 || !(*m_yields)[id].productive) return std::nullopt;
+            return Cost{(*m_yields)[id].minLength, (*m_yields)[id].minHeight};
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            auto left = eval(orNode->left());
+            auto right = eval(orNode->right());
+            if (!left) return right;
+            if (!right) return left;
+            return *right < *left ? right : left;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            auto left = eval(andNode->left());
+            if (!left) return std::nullopt;
+            auto right = eval(andNode->right());
+            if (!right) return std::nullopt;
+            return Cost{left->length + right->length, std::max(left->height, right->height)};
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            return eval(iterNode->left());
+        }
+
+        return std::nullopt;
+    }
+
+    const std::optional<Witness>& ntWitness(int id) {
+        if (!m_ntWitnessDone[id]) {
+            m_ntWitnessDone[id] = true;
+            if ((*m_yields)[id].productive) m_ntWitness[id] = minWitness(m_roots[id]);
+        }
+        return m_ntWitness[id];
+    }
+
+    std::optional<Witness> minWitness(const RETree* tree) {
+        Witness result = emptyWitness();
+        if (!tree) return result;
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            if (!isEpsilon(term)) result.tokens.push_back(term->getID());
+        } else if (dynamic_cast<const RESemantic*>(tree)) {
+            // Contributes nothing but its own goal
+        } else if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            int id = ntIndex(nt);
+            if (id < 0) return std::nullopt;
+            const auto& witness = ntWitness(id);
+            if (!witness) return std::nullopt;
+            result = *witness;
+        } else if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            auto left = eval(orNode->left());
+            auto right = eval(orNode->right());
+            if (!left && !right) return std::nullopt;
+            bool takeRight = !left || (right && *right < *left);
+            auto chosen = minWitness(takeRight ? orNode->right() : orNode->left());
+            if (!chosen) return std::nullopt;
+            result = std::move(*chosen);
+        } else if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            auto left = minWitness(andNode->left());
+            if (!left) return std::nullopt;
+            auto right = minWitness(andNode->right());
+            if (!right) return std::nullopt;
+            result = std::move(*left);
+            result.tokens.insert(result.tokens.end(), right->tokens.begin(), right->tokens.end());
+            unite(result.goals, right->goals);
+        } else if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            auto body = minWitness(iterNode->left());
+            if (!body) return std::nullopt;
+            result = std::move(*body);
+            mark(result.goals, m_iterationGoals.at(tree).second);
+        } else {
+            return std::nullopt;
+        }
+
+        markNode(tree, result.goals);
+        return result;
+    }
+
+    // Shortest derivation of the rule around the node, walking up to the root
+    std::optional<Context> around(const RETree* node) {
+        Context context{{}, {}, GoalSet(m_words, 0)};
+        std::vector<int> beforeReversed;   // Filled outward, reversed at the end
+
+        auto prepend = [&](const std::vector<int>& tokens) {
+            beforeReversed.insert(beforeReversed.end(), tokens.rbegin(), tokens.rend());
+        };
+
+        const RETree* child = node;
+        markNode(child, context.goals);
+        for (const RETree* parent = m_parent.at(child); parent; parent = m_parent.at(child)) {
+            if (auto* andNode = dynamic_cast<const REAnd*>(parent)) {
+                bool isLeft = andNode->left() == child;
+                auto sibling = minWitness(isLeft ? andNode->right() : andNode->left());
+                if (!sibling) return std::nullopt;
+                if (isLeft) {
+                    context.after.insert(context.after.end(), sibling->tokens.begin(), sibling->tokens.end());
+                } else {
+                    prepend(sibling->tokens);
+                }
+                unite(context.goals, sibling->goals);
+            } else if (auto* iterNode = dynamic_cast<const REIteration*>(parent)) {
+                const auto& goals = m_iterationGoals.at(parent);
+                if (iterNode->left() == child) {
+                    mark(context.goals, goals.second);
+                } else {
+                    // One repetition: A <B> A
+                    auto body = minWitness(iterNode->left());
+                    if (!body) return std::nullopt;
+                    prepend(body->tokens);
+                    context.after.insert(context.after.end(), body->tokens.begin(), body->tokens.end());
+                    unite(context.goals, body->goals);
+                    mark(context.goals, goals.first);
+                }
+            }
+            child = parent;
+            markNode(child, context.goals);
+        }
+
+        context.before.assign(beforeReversed.rbegin(), beforeReversed.rend());
+        return context;
+    }
+
+    std::optional<Witness> goalWitness(size_t goal) {
+        const RETree* node = m_goalNodes[goal];
+        if (m_goalKinds[goal] != GoalKind::Iteration) return minWitness(node);
+
+        auto* iterNode = static_cast<const REIteration*>(node);
+        auto body = minWitness(iterNode->left());
+        if (!body) return std::nullopt;
+        auto separator = minWitness(iterNode->right());
+        if (!separator) return std::nullopt;
+
+        Witness result = *body;
+        result.tokens.insert(result.tokens.end(), separator->tokens.begin(), separator->tokens.end());
+        result.tokens.insert(result.tokens.end(), body->tokens.begin(), body->tokens.end());
+        unite(result.goals, separator->goals);
+        mark(result.goals, goal);
+        markNode(node, result.goals);
+        return result;
+    }
+
+    // -----------------------------------------------------------------------
+    // Shortest contexts from the start symbol (Dijkstra over occurrences)
+    // -----------------------------------------------------------------------
+
+    void computeContexts() {
+        m_contexts.assign(m_ntCount, std::nullopt);
+        if (m_ntCount == 0 || !m_roots[0]) return;
+
+        std::vector<std::vector<std::optional<Context>>> arounds(m_ntCount);
+        for (int i = 0; i < m_ntCount; ++i) {
+            for (const auto& occurrence : m_occurrences[i]) {
+                arounds[i].push_back(around(occurrence.node));
+            }
+        }
+
+        const size_t unset = static_cast<size_t>(-1);
+        std::vector<size_t> distance(m_ntCount, unset);
+        std::vector<std::pair<int, size_t>> via(m_ntCount, {-1, 0});
+        std::vector<bool> done(m_ntCount, false);
+        std::vector<int> order;
+
+        using Entry = std::pair<size_t, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        distance[0] = 0;
+        queue.push({0, 0});
+
+        while (!queue.empty()) {
+            auto [dist, nt] = queue.top();
+            queue.pop();
+            if (done[nt] || dist != distance[nt]) continue;
+            done[nt] = true;
+            order.push_back(nt);
+
+            for (size_t k = 0; k < m_occurrences[nt].size(); ++k) {
+                const auto& context = arounds[nt][k];
+                if (!context) continue;
+                int target = m_occurrences[nt][k].target;
+                size_t candidate = dist + context->before.size() + context->after.size();
+                if (distance[target] == unset || candidate < distance[target]) {
+                    distance[target] = candidate;
+                    via[target] = {nt, k};
+                    queue.push({candidate, target});
+                }
+            }
+        }
+
+        for (int nt : order) {
+            if (nt == 0) {
+                m_contexts[0] = Context{{}, {}, GoalSet(m_words, 0)};
+                continue;
+            }
+            auto [from, k] = via[nt];
+            const Context& outer = *m_contexts[from];
+            const Context& inner = *arounds[from][k];
+
+            Context context = outer;
+            context.before.insert(context.before.end(), inner.before.begin(), inner.before.end());
+            context.after.insert(context.after.begin(), inner.after.begin(), inner.after.end());
+            unite(context.goals, inner.goals);
+            m_contexts[nt] = std::move(context);
+        }
+    }
+
+    // -----------------------------------------------------------------------
+    // Greedy set cover
+    // -----------------------------------------------------------------------
+
+    void selectSentences(CoverageReport& report) {
+        std::vector<Witness> candidates;
+        GoalSet coverable(m_words, 0);
+
+        for (size_t goal = 0; goal < m_goals.size(); ++goal) {
+            const auto& outer = m_contexts[m_goalOwners[goal]];
+            if (!outer) continue;
+            auto inner = around(m_goalNodes[goal]);
+            if (!inner) continue;
+            auto own = goalWitness(goal);
+            if (!own) continue;
+
+            Witness sentence{outer->before, outer->goals};
+            auto append = [&](const std::vector<int>& tokens) {
+                sentence.tokens.insert(sentence.tokens.end(), tokens.begin(), tokens.end());
+            };
+            append(inner->before);
+            append(own->tokens);
+            append(inner->after);
+            append(outer->after);
+            unite(sentence.goals, inner->goals);
+            unite(sentence.goals, own->goals);
+            mark(sentence.goals, goal);
+
+            unite(coverable, sentence.goals);
+            candidates.push_back(std::move(sentence));
+        }
+
+        for (size_t goal = 0; goal < m_goals.size(); ++goal) {
+            if (contains(coverable, goal)) {
+                report.goals[goal].covered = true;
+                ++report.coveredGoals;
+            }
+        }
+
+        // Lazy greedy: a candidate's gain only shrinks as goals get covered
+        using Entry = std::tuple<size_t, size_t, size_t>;  // gain, -length, -index
+        std::priority_queue<Entry> queue;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            queue.push({countNew(candidates[i].goals, coverable),
+                        ~candidates[i].tokens.size(), ~i});
+        }
+
+        GoalSet uncovered = coverable;
+        while (!queue.empty()) {
+            auto [gain, length, index] = queue.top();
+            queue.pop();
+            const Witness& candidate = candidates[~index];
+            size_t actual = countNew(candidate.goals, uncovered);
+            if (actual != gain) {
+                queue.push({actual, length, index});
+                continue;
+            }
+            if (actual == 0) break;
+
+            CoverageSentence sentence;
+            sentence.tokens = candidate.tokens;
+            for (size_t goal = 0; goal < m_goals.size(); ++goal) {
+                if (contains(candidate.goals, goal) && contains(uncovered, goal)) {
+                    sentence.newGoals.push_back(goal);
+                }
+            }
+            for (size_t w = 0; w < m_words; ++w) uncovered[w] &= ~candidate.goals[w];
+            report.sentences.push_back(std::move(sentence));
+        }
+    }
+};
+
+}
+
+// ---------------------------------------------------------------------------
+// CoverageSuite
+// ---------------------------------------------------------------------------
+
+CoverageReport CoverageSuite::build(const Grammar* grammar) {
+    if (!grammar) return {};
+    return CoverageBuilder(grammar).run();
+}
+
+std::string CoverageSuite::formatSentence(const Grammar* grammar, const std::vector<int>& tokens,
+                                          const std::string& separator) {
+    std::string result;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        if (i > 0) result += separator;
+        result += grammar->terminals()->getRawString(tokens[i]);
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,435 @@
+#include <syngt/generate/SentenceGenerator.h>
+#include <syngt/analysis/YieldAnalysis.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace syngt {
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Uniform double in [0, 1); independent of the standard library's distributions
+static double uniform01(std::mt19937_64& rng) {
+    return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Pick i in [first, last] with probability weight(i) / sum of weights
+template <typename Weight>
+static size_t choose(std::mt19937_64& rng, size_t first, size_t last, Weight weight) {
+    double total = 0.0;
+    for (size_t i = first; i <= last; ++i) total += weight(i);
+
+    double target = uniform01(rng) * total;
+    size_t chosen = last;
+    for (size_t i = first; i <= last; ++i) {
+        double w = weight(i);
+        if (w <= 0.0) continue;
+        chosen = i;
+        if (target < w) break;
+        target -= w;
+    }
+    return chosen;
+}
+
+static bool isEpsilonTerminal(const Grammar* grammar, const RETerminal* term) {
+    return grammar->terminals()->getRawString(term->getID()).empty();
+}
+
+static void collectReferences(const RETree* tree, std::vector<int>& out) {
+    if (!tree) return;
+    if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+        out.push_back(nt->getID());
+        return;
+    }
+    collectReferences(tree->left(), out);
+    collectReferences(tree->right(), out);
+}
+
+static void collectPostOrder(const RETree* tree, std::vector<const RETree*>& out) {
+    if (!tree || dynamic_cast<const RENonTerminal*>(tree)) return;
+    collectPostOrder(tree->left(), out);
+    collectPostOrder(tree->right(), out);
+    out.push_back(tree);
+}
+
+// References whose surrounding context may derive the empty string: counts
+// for a length n then depend on the referenced NT's count for the same n
+static void collectSameLengthEdges(const RETree* tree, bool emptyContext,
+                                   const YieldAnalysis::Table& yields, const Grammar* grammar,
+                                   std::vector<int>& out) {
+    if (!tree) return;
+
+    auto nullable = [&](const RETree* t) {
+        auto y = YieldAnalysis::minYieldOf(t, yields, grammar);
+        return y && y->empty();
+    };
+
+    if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+        if (emptyContext) out.push_back(nt->getID());
+        return;
+    }
+
+    if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+        collectSameLengthEdges(orNode->left(), emptyContext, yields, grammar, out);
+        collectSameLengthEdges(orNode->right(), emptyContext, yields, grammar, out);
+        return;
+    }
+
+    if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+        collectSameLengthEdges(andNode->left(), emptyContext && nullable(andNode->right()),
+                               yields, grammar, out);
+        collectSameLengthEdges(andNode->right(), emptyContext && nullable(andNode->left()),
+                               yields, grammar, out);
+        return;
+    }
+
+    if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+        collectSameLengthEdges(iterNode->left(), emptyContext, yields, grammar, out);
+        collectSameLengthEdges(iterNode->right(), emptyContext && nullable(iterNode->left()),
+                               yields, grammar, out);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Counting
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<SentenceGenerator> SentenceGenerator::build(const Grammar* grammar, size_t maxLength) {
+    if (!grammar) return nullptr;
+
+    auto generator = std::unique_ptr<SentenceGenerator>(new SentenceGenerator());
+    generator->m_grammar = grammar;
+    generator->m_maxLength = maxLength;
+
+    int ntCount = static_cast<int>(grammar->getNonTerminals().size());
+    if (ntCount == 0) {
+        throw std::runtime_error("SentenceGenerator: grammar has no nonterminals");
+    }
+
+    generator->m_roots.assign(ntCount, nullptr);
+    for (int i = 0; i < ntCount; ++i) {
+        NTListItem* item = grammar->getNTItemByIndex(i);
+        if (item && item->hasRoot()) generator->m_roots[i] = item->root();
+    }
+    generator->m_ntCounts.assign(ntCount, std::vector<double>(maxLength + 1, 0.0));
+
+    for (int t = 0; t < grammar->terminals()->getCount(); ++t) {
+        generator->m_terminalNames.push_back(grammar->terminals()->getRawString(t));
+    }
+
+    // Nonterminals reachable from the start symbol
+    std::vector<bool> reachable(ntCount, false);
+    std::vector<int> stack = {0};
+    reachable[0] = true;
+    while (!stack.empty()) {
+        int nt = stack.back();
+        stack.pop_back();
+        std::vector<int> refs;
+        collectReferences(generator->m_roots[nt], refs);
+        for (int r : refs) {
+            if (r >= 0 && r < ntCount && !reachable[r]) {
+                reachable[r] = true;
+                stack.push_back(r);
+            }
+        }
+    }
+
+    // Order nonterminals so that same-length dependencies come first
+    auto yields = YieldAnalysis::analyze(grammar);
+    std::vector<std::vector<int>> dependsOn(ntCount);
+    for (int i = 0; i < ntCount; ++i) {
+        if (!reachable[i] || !(*yields)[i].productive) continue;
+        std::vector<int> edges;
+        collectSameLengthEdges(generator->m_roots[i], true, *yields, grammar, edges);
+        for (int e : edges) {
+            if (e >= 0 && e < ntCount && (*yields)[e].productive) dependsOn[i].push_back(e);
+        }
+    }
+
+    std::vector<int> order;
+    std::vector<int> state(ntCount, 0);  // 0 - new, 1 - in progress, 2 - done
+    for (int start = 0; start < ntCount; ++start) {
+        if (!reachable[start] || state[start] != 0) continue;
+
+        std::vector<std::pair<int, size_t>> work = {{start, 0}};
+        state[start] = 1;
+        while (!work.empty()) {
+            auto& [nt, next] = work.back();
+            if (next < dependsOn[nt].size()) {
+                int dep = dependsOn[nt][next++];
+                if (state[dep] == 1) {
+                    throw std::runtime_error(
+                        "SentenceGenerator: infinitely many derivations through empty cycle at '" +
+                        grammar->getNonTerminalName(dep) + "'");
+                }
+                if (state[dep] == 0) {
+                    state[dep] = 1;
+                    work.push_back({dep, 0});
+                }
+                continue;
+            }
+            state[nt] = 2;
+            order.push_back(nt);
+            work.pop_back();
+        }
+    }
+
+    std::vector<std::vector<const RETree*>> nodes(ntCount);
+    for (int nt : order) {
+        collectPostOrder(generator->m_roots[nt], nodes[nt]);
+        for (const RETree* node : nodes[nt]) {
+            NodeCounts& counts = generator->m_nodes[node];
+            counts.count.assign(maxLength + 1, 0.0);
+            if (dynamic_cast<const REIteration*>(node)) {
+                counts.body.assign(maxLength + 1, 0.0);
+                counts.loop.assign(maxLength + 1, 0.0);
+            }
+        }
+    }
+
+    for (size_t n = 0; n <= maxLength; ++n) {
+        for (int nt : order) {
+            for (const RETree* node : nodes[nt]) {
+                generator->computeNode(node, n);
+            }
+            // An NT without a rule derives nothing, as in YieldAnalysis
+            if (!generator->m_roots[nt]) continue;
+            generator->m_ntCounts[nt][n] = generator->count(generator->m_roots[nt], n);
+        }
+    }
+
+    return generator;
+}
+
+double SentenceGenerator::count(const RETree* tree, size_t length) const {
+    if (!tree) return length == 0 ? 1.0 : 0.0;
+
+    if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+        int id = nt->getID();
+        if (id < 0 || id >= static_cast<int>(m_ntCounts.size())) return 0.0;
+        return m_ntCounts[id][length];
+    }
+
+    auto it = m_nodes.find(tree);
+    return it != m_nodes.end() ? it->second.count[length] : 0.0;
+}
+
+void SentenceGenerator::computeNode(const RETree* tree, size_t n) {
+    NodeCounts& counts = m_nodes[tree];
+
+    if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+        size_t own = isEpsilonTerminal(m_grammar, term) ? 0 : 1;
+        counts.count[n] = n == own ? 1.0 : 0.0;
+        return;
+    }
+
+    if (dynamic_cast<const RESemantic*>(tree)) {
+        counts.count[n] = n == 0 ? 1.0 : 0.0;
+        return;
+    }
+
+    if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+        counts.count[n] = count(orNode->left(), n) + count(orNode->right(), n);
+        return;
+    }
+
+    if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+        double total = 0.0;
+        for (size_t i = 0; i <= n; ++i) {
+            total += count(andNode->left(), i) * count(andNode->right(), n - i);
+        }
+        counts.count[n] = total;
+        return;
+    }
+
+    // A#B = A(BA)*, counting only non-empty repetitions of BA
+    if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+        double body = 0.0;
+        for (size_t k = 0; k <= n; ++k) {
+            body += count(iterNode->right(), k) * count(iterNode->left(), n - k);
+        }
+        counts.body[n] = body;
+
+        double loop = n == 0 ? 1.0 : 0.0;
+        for (size_t j = 1; j <= n; ++j) {
+            loop += counts.body[j] * counts.loop[n - j];
+        }
+        counts.loop[n] = loop;
+
+        double total = 0.0;
+        for (size_t i = 0; i <= n; ++i) {
+            total += count(iterNode->left(), i) * counts.loop[n - i];
+        }
+        counts.count[n] = total;
+        return;
+    }
+
+    counts.count[n] = 0.0;
+}
+
+double SentenceGenerator::countDerivations(size_t length) const {
+    if (length > m_maxLength) return 0.0;
+    return m_ntCounts[0][length];
+}
+
+// ---------------------------------------------------------------------------
+// Sampling
+// ---------------------------------------------------------------------------
+
+void SentenceGenerator::sampleInto(size_t length, uint64_t seed, uint64_t index,
+                                   std::vector<int>& out) const {
+    out.clear();
+    // Seed and index are mixed separately: seed + index would make the
+    // stream of seed s+1 the stream of seed s shifted by one sentence
+    std::mt19937_64 rng(splitmix64(splitmix64(seed) ^ index));
+
+    // Pending work, processed right to left from the back of the stack;
+    // loop != nullptr means "the (BA)* tail of this iteration"
+    struct Task {
+        const RETree* node;
+        const REIteration* loop;
+        size_t length;
+    };
+    std::vector<Task> stack = {{m_roots[0], nullptr, length}};
+
+    while (!stack.empty()) {
+        Task task = stack.back();
+        stack.pop_back();
+        size_t n = task.length;
+
+        if (task.loop) {
+            if (n == 0) continue;
+            const NodeCounts& counts = m_nodes.at(task.loop);
+            size_t j = choose(rng, 1, n, [&](size_t i) { return counts.body[i] * counts.loop[n - i]; });
+            const RETree* a = task.loop->left();
+            const RETree* b = task.loop->right();
+            size_t k = choose(rng, 0, j, [&](size_t i) { return count(b, i) * count(a, j - i); });
+            stack.push_back({nullptr, task.loop, n - j});
+            stack.push_back({a, nullptr, j - k});
+            stack.push_back({b, nullptr, k});
+            continue;
+        }
+
+        const RETree* tree = task.node;
+        if (!tree) continue;
+
+        if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+            if (!isEpsilonTerminal(m_grammar, term)) out.push_back(term->getID());
+            continue;
+        }
+
+        if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+            stack.push_back({m_roots[nt->getID()], nullptr, n});
+            continue;
+        }
+
+        if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+            double left = count(orNode->left(), n);
+            double right = count(orNode->right(), n);
+            bool takeLeft = uniform01(rng) * (left + right) < left;
+            stack.push_back({takeLeft ? orNode->left() : orNode->right(), nullptr, n});
+            continue;
+        }
+
+        if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+            size_t i = choose(rng, 0, n, [&](size_t s) {
+                return count(andNode->left(), s) * count(andNode->right(), n - s);
+            });
+            stack.push_back({andNode->right(), nullptr, n - i});
+            stack.push_back({andNode->left(), nullptr, i});
+            continue;
+        }
+
+        if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+            const NodeCounts& counts = m_nodes.at(iterNode);
+            size_t i = choose(rng, 0, n, [&](size_t s) {
+                return count(iterNode->left(), s) * counts.loop[n - s];
+            });
+            stack.push_back({nullptr, iterNode, n - i});
+            stack.push_back({iterNode->left(), nullptr, i});
+        }
+    }
+}
+
+std::vector<int> SentenceGenerator::sentence(size_t length, uint64_t seed, uint64_t index) const {
+    if (length > m_maxLength) {
+        throw std::runtime_error("SentenceGenerator: length exceeds prepared maximum");
+    }
+    double total = countDerivations(length);
+    if (total <= 0.0) {
+        throw std::runtime_error("SentenceGenerator: no sentences of length " + std::to_string(length));
+    }
+    if (std::isinf(total)) {
+        throw std::runtime_error("SentenceGenerator: derivation count overflow");
+    }
+
+    std::vector<int> result;
+    sampleInto(length, seed, index, result);
+    return result;
+}
+
+void SentenceGenerator::generate(std::ostream& out, const GeneratorOptions& options) const {
+    // Validates the length once; sampling below cannot fail
+    sentence(options.length, options.seed, 0);
+
+    unsigned threads = options.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    const uint64_t chunkSize = 1024;
+    uint64_t chunks = (options.count + chunkSize - 1) / chunkSize;
+
+    auto fillChunk = [&](uint64_t chunk, std::string& buffer) {
+        std::vector<int> words;
+        uint64_t first = chunk * chunkSize;
+        uint64_t last = std::min<uint64_t>(options.count, first + chunkSize);
+        for (uint64_t i = first; i < last; ++i) {
+            sampleInto(options.length, options.seed, i, words);
+            for (size_t w = 0; w < words.size(); ++w) {
+                if (w > 0) buffer += options.separator;
+                buffer += m_terminalNames[words[w]];
+            }
+            buffer += '\n';
+        }
+    };
+
+    // Chunks are produced in parallel and written in index order
+    for (uint64_t batch = 0; batch < chunks; batch += threads) {
+        uint64_t batchEnd = std::min<uint64_t>(chunks, batch + threads);
+        std::vector<std::string> buffers(batchEnd - batch);
+
+        std::vector<std::thread> pool;
+        for (uint64_t chunk = batch + 1; chunk < batchEnd; ++chunk) {
+            pool.emplace_back(fillChunk, chunk, std::ref(buffers[chunk - batch]));
+        }
+        fillChunk(batch, buffers[0]);
+        for (auto& thread : pool) thread.join();
+
+        for (const auto& buffer : buffers) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+    }
+}
+
+}
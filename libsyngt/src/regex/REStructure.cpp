@@ -0,0 +1,117 @@
+#include <syngt/regex/REStructure.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/RELeaf.h>
+#include <syngt/regex/REMacro.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <typeinfo>
+#include <vector>
+
+namespace syngt {
+
+namespace {
+
+size_t combine(size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+// Nonterminal ids go through 'blocks' when it is given
+int leafID(const RELeaf* leaf, const std::vector<int>* blocks) {
+    int id = leaf->id();
+    if (blocks && id >= 0 && id < static_cast<int>(blocks->size()) &&
+        dynamic_cast<const RENonTerminal*>(leaf)) {
+        return (*blocks)[id];
+    }
+    return id;
+}
+
+size_t leafHash(const RELeaf* leaf, const std::vector<int>* blocks) {
+    size_t hash = typeid(*leaf).hash_code();
+    hash = combine(hash, static_cast<size_t>(leafID(leaf, blocks)));
+    if (auto macro = dynamic_cast<const REMacro*>(leaf)) {
+        hash = combine(hash, macro->isOpen() ? 1 : 0);
+    }
+    return hash;
+}
+
+size_t operationHash(const RETree* tree, size_t leftHash, size_t rightHash) {
+    size_t hash = typeid(*tree).hash_code();
+    hash = combine(hash, leftHash);
+    hash = combine(hash, rightHash);
+    return hash;
+}
+
+size_t hashTree(const RETree* tree, const std::vector<int>* blocks) {
+    if (!tree) return 0;
+    if (auto leaf = dynamic_cast<const RELeaf*>(tree)) {
+        return leafHash(leaf, blocks);
+    }
+    return operationHash(tree, hashTree(tree->left(), blocks), hashTree(tree->right(), blocks));
+}
+
+bool equalTrees(const RETree* a, const RETree* b, const std::vector<int>* blocks) {
+    // Iterative, so long ',' and ';' chains do not deepen the stack twice
+    std::vector<std::pair<const RETree*, const RETree*>> pending{{a, b}};
+    while (!pending.empty()) {
+        auto [x, y] = pending.back();
+        pending.pop_back();
+
+        if (x == y) continue;
+        if (!x || !y) return false;
+        if (typeid(*x) != typeid(*y)) return false;
+
+        auto leafX = dynamic_cast<const RELeaf*>(x);
+        if (leafX) {
+            auto leafY = static_cast<const RELeaf*>(y);
+            if (leafID(leafX, blocks) != leafID(leafY, blocks)) return false;
+            auto macroX = dynamic_cast<const REMacro*>(x);
+            if (macroX && macroX->isOpen() != static_cast<const REMacro*>(y)->isOpen()) return false;
+            continue;
+        }
+
+        pending.push_back({x->right(), y->right()});
+        pending.push_back({x->left(), y->left()});
+    }
+    return true;
+}
+
+}
+
+size_t structuralHash(const RETree* tree) {
+    return hashTree(tree, nullptr);
+}
+
+size_t structuralNodeHash(const RETree* node, size_t leftHash, size_t rightHash) {
+    if (!node) return 0;
+    if (auto leaf = dynamic_cast<const RELeaf*>(node)) {
+        return leafHash(leaf, nullptr);
+    }
+    return operationHash(node, leftHash, rightHash);
+}
+
+bool structurallyEqual(const RETree* a, const RETree* b) {
+    return equalTrees(a, b, nullptr);
+}
+
+size_t structuralHash(const RETree* tree, const std::vector<int>& ntBlocks) {
+    return hashTree(tree, &ntBlocks);
+}
+
+bool structurallyEqual(const RETree* a, const RETree* b, const std::vector<int>& ntBlocks) {
+    return equalTrees(a, b, &ntBlocks);
+}
+
+int nodeCount(const RETree* tree) {
+    int count = 0;
+    std::vector<const RETree*> pending{tree};
+    while (!pending.empty()) {
+        const RETree* node = pending.back();
+        pending.pop_back();
+        if (!node) continue;
+        ++count;
+        pending.push_back(node->left());
+        pending.push_back(node->right());
+    }
+    return count;
+}
+
+}
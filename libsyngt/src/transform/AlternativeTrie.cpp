@@ -0,0 +1,123 @@
+#include "transform/AlternativeTrie.h"
+#include <syngt/core/Grammar.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+
+namespace syngt {
+
+void collectAlternatives(const RETree* root, std::vector<const RETree*>& alternatives) {
+    std::vector<const RETree*> stack{root};
+    while (!stack.empty()) {
+        const RETree* node = stack.back();
+        stack.pop_back();
+        if (auto orNode = dynamic_cast<const REOr*>(node)) {
+            stack.push_back(orNode->right());
+            stack.push_back(orNode->left());
+        } else if (node) {
+            alternatives.push_back(node);
+        }
+    }
+}
+
+void flattenAndChain(const RETree* root, FactorSide side, std::vector<const RETree*>& elements) {
+    std::vector<const RETree*> stack{root};
+    while (!stack.empty()) {
+        const RETree* node = stack.back();
+        stack.pop_back();
+        if (auto andNode = dynamic_cast<const REAnd*>(node)) {
+            // The operand on the factored side is popped first
+            if (side == fsPrefix) {
+                stack.push_back(andNode->right());
+                stack.push_back(andNode->left());
+            } else {
+                stack.push_back(andNode->left());
+                stack.push_back(andNode->right());
+            }
+        } else if (node) {
+            elements.push_back(node);
+        }
+    }
+}
+
+void AlternativeTrie::insert(const std::vector<const RETree*>& elements) {
+    int node = 0;
+    for (const RETree* element : elements) {
+        auto found = m_nodes[node].index.find(element);
+        if (found != m_nodes[node].index.end()) {
+            node = found->second;
+            continue;
+        }
+        int child = static_cast<int>(m_nodes.size());
+        m_nodes[node].index.emplace(element, child);
+        m_nodes[node].children.emplace_back(element, child);
+        m_nodes.emplace_back();
+        node = child;
+    }
+    m_nodes[node].end = true;
+}
+
+std::unique_ptr<RETree> AlternativeTrie::build(int node, Grammar* grammar) const {
+    std::unique_ptr<RETree> result;
+    auto append = [&result](std::unique_ptr<RETree> alternative) {
+        result = result ? REOr::make(std::move(result), std::move(alternative))
+                        : std::move(alternative);
+    };
+
+    for (const auto& [label, start] : m_nodes[node].children) {
+        std::unique_ptr<RETree> sequence = label->copy();
+        int current = start;
+        while (!m_nodes[current].end && m_nodes[current].children.size() == 1) {
+            const auto& next = m_nodes[current].children.front();
+            sequence = extend(std::move(sequence), next.first->copy());
+            current = next.second;
+        }
+
+        if (!m_nodes[current].children.empty()) {
+            if (m_side == fsPrefix) {
+                std::string name = grammar->freshNonTerminalName("factored");
+                int id = grammar->addNonTerminal(name);
+                grammar->setNTRoot(name, build(current, grammar));
+                sequence = extend(std::move(sequence),
+                                  std::make_unique<RENonTerminal>(grammar, id, false));
+            } else {
+                sequence = extend(std::move(sequence), build(current, grammar));
+            }
+        }
+        append(std::move(sequence));
+    }
+
+    if (m_nodes[node].end) {
+        int epsilonId = grammar->addSemantic("@");
+        append(std::make_unique<RESemantic>(grammar, epsilonId));
+    }
+    return result;
+}
+
+std::unique_ptr<RETree> AlternativeTrie::extend(std::unique_ptr<RETree> sequence,
+                                                std::unique_ptr<RETree> next) const {
+    return m_side == fsPrefix ? REAnd::make(std::move(sequence), std::move(next))
+                              : REAnd::make(std::move(next), std::move(sequence));
+}
+
+std::unique_ptr<RETree> factorAlternatives(const RETree* root, FactorSide side, Grammar* grammar) {
+    std::vector<const RETree*> alternatives;
+    collectAlternatives(root, alternatives);
+    if (alternatives.size() < 2) return nullptr;
+
+    AlternativeTrie trie(side);
+    std::vector<const RETree*> elements;
+    for (const RETree* alternative : alternatives) {
+        elements.clear();
+        flattenAndChain(alternative, side, elements);
+        trie.insert(elements);
+    }
+
+    // Every alternative differs in its first element: nothing to factor
+    if (trie.rootBranches() == static_cast<int>(alternatives.size())) return nullptr;
+
+    return trie.build(0, grammar);
+}
+
+}
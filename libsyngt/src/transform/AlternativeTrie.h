@@ -0,0 +1,81 @@
+#pragma once
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REStructure.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace syngt {
+
+class Grammar;
+
+/**
+ * @brief Сторона, с которой факторизуются альтернативы
+ *
+ * fsPrefix - общие начала (LeftFactorization), fsSuffix - общие
+ * окончания (RightFactorization).
+ */
+enum FactorSide {
+    fsPrefix = 0,
+    fsSuffix = 1
+};
+
+/**
+ * @brief Альтернативы верхнего уровня правила слева направо
+ */
+void collectAlternatives(const RETree* root, std::vector<const RETree*>& alternatives);
+
+/**
+ * @brief Элементы цепочки конкатенации, начиная с факторизуемой стороны
+ *
+ * Для fsPrefix - слева направо, для fsSuffix - справа налево.
+ */
+void flattenAndChain(const RETree* root, FactorSide side, std::vector<const RETree*>& elements);
+
+/**
+ * @brief Префиксное дерево над цепочками альтернатив
+ *
+ * Ключи - структурные хеши элементов; потомки хранятся в порядке первой
+ * вставки, так что результат повторяет исходный порядок альтернатив.
+ * Для fsSuffix в дерево вставляются перевёрнутые цепочки.
+ *
+ * build собирает правило за один обход: неветвящийся путь становится
+ * цепочкой, а точка ветвления для fsPrefix получает новый нетерминал
+ * factored_<n>, для fsSuffix - альтернативу различающихся начал перед
+ * общим окончанием. Конец цепочки внутри дерева даёт пустую альтернативу.
+ */
+class AlternativeTrie {
+public:
+    explicit AlternativeTrie(FactorSide side) : m_side(side), m_nodes(1) {}
+
+    void insert(const std::vector<const RETree*>& elements);
+
+    int rootBranches() const { return static_cast<int>(m_nodes[0].children.size()); }
+
+    std::unique_ptr<RETree> build(int node, Grammar* grammar) const;
+
+private:
+    struct Node {
+        std::vector<std::pair<const RETree*, int>> children;
+        std::unordered_map<const RETree*, int, StructuralHash, StructuralEqual> index;
+        bool end = false;
+    };
+
+    // Joins two parts of a sequence in the order of the factored side
+    std::unique_ptr<RETree> extend(std::unique_ptr<RETree> sequence, std::unique_ptr<RETree> next) const;
+
+    FactorSide m_side;
+    std::vector<Node> m_nodes;
+};
+
+/**
+ * @brief Факторизованное правило или nullptr
+ *
+ * nullptr, если альтернатив меньше двух или все они различаются уже
+ * в первом элементе с факторизуемой стороны.
+ */
+std::unique_ptr<RETree> factorAlternatives(const RETree* root, FactorSide side, Grammar* grammar);
+
+}
@@ -0,0 +1,217 @@
+#include <syngt/transform/ExtractCommon.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/core/NonTerminalList.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REBinaryOp.h>
+#include <syngt/regex/REMacro.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/REStructure.h>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace syngt {
+
+namespace {
+
+size_t nodeBytes(const RETree* node) {
+    if (dynamic_cast<const RENonTerminal*>(node)) return sizeof(RENonTerminal);
+    if (dynamic_cast<const REMacro*>(node)) return sizeof(REMacro);
+    if (dynamic_cast<const RETerminal*>(node)) return sizeof(RETerminal);
+    if (dynamic_cast<const RESemantic*>(node)) return sizeof(RESemantic);
+    if (dynamic_cast<const REOr*>(node)) return sizeof(REOr);
+    if (dynamic_cast<const REAnd*>(node)) return sizeof(REAnd);
+    return sizeof(REIteration);
+}
+
+// Subtree in preorder; the subtree of record i is [i, i + size)
+struct Occurrence {
+    RETree* node = nullptr;
+    REBinaryOp* parent = nullptr;       // nullptr: root of the rule
+    bool first = false;                 // Which operand of parent
+    int rule = -1;
+    int size = 1;
+    size_t hash = 0;
+};
+
+class SubtreeIndex {
+public:
+    void addRule(int rule, RETree* root) {
+        const size_t begin = m_records.size();
+        std::vector<Occurrence> pending{Occurrence{root, nullptr, false, rule, 1, 0}};
+        while (!pending.empty()) {
+            Occurrence record = pending.back();
+            pending.pop_back();
+            m_records.push_back(record);
+            if (auto binary = dynamic_cast<REBinaryOp*>(record.node)) {
+                if (binary->right()) pending.push_back(Occurrence{binary->right(), binary, false, rule, 1, 0});
+                if (binary->left()) pending.push_back(Occurrence{binary->left(), binary, true, rule, 1, 0});
+            }
+        }
+
+        // Children follow their parent in preorder, so a reverse sweep sees
+        // them first; the hashes agree with structuralHash of each subtree
+        for (size_t i = m_records.size(); i-- > begin; ) {
+            Occurrence& record = m_records[i];
+            size_t operandHash[2] = {0, 0};
+            size_t child = i + 1;
+            for (int operand = 0; operand < 2 && child < m_records.size(); ++operand) {
+                const Occurrence& next = m_records[child];
+                if (next.parent != record.node) break;
+                operandHash[next.first ? 0 : 1] = next.hash;
+                record.size += next.size;
+                child += next.size;
+            }
+            record.hash = structuralNodeHash(record.node, operandHash[0], operandHash[1]);
+        }
+    }
+
+    // Classes of equal subtrees with at least 'minNodes' nodes and
+    // 'minOccurrences' members, largest first, each in preorder
+    std::vector<std::vector<int>> repeated(int minNodes, int minOccurrences) const {
+        auto hashRecord = [&](int i) { return m_records[i].hash; };
+        auto equalRecords = [&](int a, int b) {
+            return m_records[a].size == m_records[b].size &&
+                   structurallyEqual(m_records[a].node, m_records[b].node);
+        };
+        std::unordered_map<int, int, decltype(hashRecord), decltype(equalRecords)>
+            classOf(m_records.size(), hashRecord, equalRecords);
+
+        std::vector<std::vector<int>> classes;
+        for (int i = 0; i < static_cast<int>(m_records.size()); ++i) {
+            if (m_records[i].size < minNodes) continue;
+            auto [it, inserted] = classOf.emplace(i, static_cast<int>(classes.size()));
+            if (inserted) classes.emplace_back();
+            classes[it->second].push_back(i);
+        }
+
+        classes.erase(std::remove_if(classes.begin(), classes.end(),
+                                     [&](const std::vector<int>& members) {
+                                         return static_cast<int>(members.size()) < minOccurrences;
+                                     }),
+                      classes.end());
+        std::stable_sort(classes.begin(), classes.end(),
+                         [&](const std::vector<int>& a, const std::vector<int>& b) {
+                             return m_records[a[0]].size > m_records[b[0]].size;
+                         });
+        return classes;
+    }
+
+    const Occurrence& operator[](int i) const { return m_records[i]; }
+    int size() const { return static_cast<int>(m_records.size()); }
+
+private:
+    std::vector<Occurrence> m_records;
+};
+
+void measure(const Grammar* grammar, int& nodes, size_t& bytes) {
+    nodes = 0;
+    bytes = 0;
+    const int count = grammar->nonTerminals()->getCount();
+    for (int i = 0; i < count; ++i) {
+        std::vector<const RETree*> pending{grammar->getNTItemByIndex(i)->root()};
+        while (!pending.empty()) {
+            const RETree* node = pending.back();
+            pending.pop_back();
+            if (!node) continue;
+            ++nodes;
+            bytes += nodeBytes(node);
+            pending.push_back(node->left());
+            pending.push_back(node->right());
+        }
+    }
+}
+
+// One round: returns the number of replaced occurrences
+int extractRound(Grammar* grammar, const ExtractCommonOptions& options, ExtractCommonStats& stats) {
+    SubtreeIndex index;
+    const int ruleCount = grammar->nonTerminals()->getCount();
+    for (int i = 0; i < ruleCount; ++i) {
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (nt->hasRoot() && !nt->isMacro()) index.addRule(i, nt->root());
+    }
+
+    // Chosen occurrences never overlap: a class only keeps members outside
+    // the subtrees already taken by larger classes
+    std::vector<bool> covered(index.size(), false);
+    std::vector<std::vector<int>> chosen;
+    for (auto& members : index.repeated(std::max(options.minNodes, 2), std::max(options.minOccurrences, 2))) {
+        members.erase(std::remove_if(members.begin(), members.end(),
+                                     [&](int i) { return covered[i]; }),
+                      members.end());
+        if (static_cast<int>(members.size()) < std::max(options.minOccurrences, 2)) continue;
+        for (int i : members) {
+            std::fill(covered.begin() + i, covered.begin() + i + index[i].size, true);
+        }
+        chosen.push_back(std::move(members));
+    }
+    if (chosen.empty()) return 0;
+
+    std::vector<bool> changed(ruleCount, false);
+    int replaced = 0;
+    auto replace = [&](const Occurrence& occurrence, std::unique_ptr<RETree> reference) {
+        if (!occurrence.parent) {
+            grammar->getNTItemByIndex(occurrence.rule)->setRoot(std::move(reference));
+            return;
+        }
+        if (occurrence.first) occurrence.parent->setFirst(std::move(reference));
+        else occurrence.parent->setSecond(std::move(reference));
+        changed[occurrence.rule] = true;
+    };
+
+    for (const auto& members : chosen) {
+        // A whole rule equal to the subexpression is referenced instead of a new one
+        auto whole = std::find_if(members.begin(), members.end(),
+                                  [&](int i) { return index[i].parent == nullptr; });
+        int target;
+        if (whole != members.end()) {
+            target = index[*whole].rule;
+            ++stats.reused;
+        } else {
+            const Occurrence& body = index[members[0]];
+            std::string name = grammar->freshNonTerminalName(options.prefix);
+            target = grammar->addNonTerminal(name);
+            std::unique_ptr<RETree> moved = body.first ? body.parent->releaseFirst() : body.parent->releaseSecond();
+            grammar->getNTItemByIndex(target)->setRoot(std::move(moved));
+            ++stats.extracted;
+        }
+
+        for (int i : members) {
+            const Occurrence& occurrence = index[i];
+            if (occurrence.parent == nullptr && occurrence.rule == target) continue;
+            replace(occurrence, std::make_unique<RENonTerminal>(grammar, target, false));
+            ++replaced;
+        }
+    }
+
+    for (int i = 0; i < ruleCount; ++i) {
+        if (changed[i]) grammar->getNTItemByIndex(i)->updateValueFromRoot();
+    }
+    return replaced;
+}
+
+}
+
+ExtractCommonStats ExtractCommon::extract(Grammar* grammar, const ExtractCommonOptions& options) {
+    ExtractCommonStats stats;
+    if (!grammar) return stats;
+
+    measure(grammar, stats.nodesBefore, stats.bytesBefore);
+    for (;;) {
+        ++stats.rounds;
+        int replaced = extractRound(grammar, options, stats);
+        if (replaced == 0) break;
+        stats.occurrences += replaced;
+    }
+    measure(grammar, stats.nodesAfter, stats.bytesAfter);
+    return stats;
+}
+
+}
@@ -0,0 +1,209 @@
+#include <syngt/transform/Inlining.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/RELeaf.h>
+#include <syngt/regex/REBinaryOp.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace syngt {
+
+namespace {
+
+bool isReferenceTo(const RETree* node, int nt) {
+    auto reference = dynamic_cast<const RENonTerminal*>(node);
+    return reference && reference->getID() == nt;
+}
+
+// Appends the id of every nonterminal occurrence in tree
+void collectReferences(const RETree* tree, int ntCount, std::vector<int>& out) {
+    std::vector<const RETree*> pending{tree};
+    while (!pending.empty()) {
+        const RETree* node = pending.back();
+        pending.pop_back();
+        if (!node) continue;
+        if (auto reference = dynamic_cast<const RENonTerminal*>(node)) {
+            int id = reference->getID();
+            if (id >= 0 && id < ntCount) out.push_back(id);
+            continue;
+        }
+        pending.push_back(node->right());
+        pending.push_back(node->left());
+    }
+}
+
+// Replaces every occurrence of nt in tree by a copy of replacement in place;
+// returns the number of occurrences
+int replaceReferences(std::unique_ptr<RETree>& tree, int nt, const RETree* replacement) {
+    if (isReferenceTo(tree.get(), nt)) {
+        tree = replacement->copy();
+        return 1;
+    }
+
+    int replaced = 0;
+    std::vector<REBinaryOp*> pending;
+    if (auto binary = dynamic_cast<REBinaryOp*>(tree.get())) pending.push_back(binary);
+    while (!pending.empty()) {
+        REBinaryOp* node = pending.back();
+        pending.pop_back();
+
+        if (isReferenceTo(node->left(), nt)) {
+            node->setFirst(replacement->copy());
+            ++replaced;
+        } else if (auto binary = dynamic_cast<REBinaryOp*>(node->left())) {
+            pending.push_back(binary);
+        }
+
+        if (isReferenceTo(node->right(), nt)) {
+            node->setSecond(replacement->copy());
+            ++replaced;
+        } else if (auto binary = dynamic_cast<REBinaryOp*>(node->right())) {
+            pending.push_back(binary);
+        }
+    }
+    return replaced;
+}
+
+// Rules are copied on first change and written back once at the end
+class InliningPass {
+public:
+    InliningPass(Grammar* grammar, const InliningOptions& options)
+        : m_grammar(grammar), m_options(options),
+          m_count(static_cast<int>(grammar->getNonTerminals().size())),
+          m_trees(m_count), m_removed(m_count, false),
+          m_references(m_count, 0), m_users(m_count) {
+        std::vector<int> referenced;
+        for (int i = 0; i < m_count; ++i) {
+            const RETree* rule = current(i);
+            if (!rule) continue;
+            if (m_start < 0) m_start = i;
+            m_stats.operationsBefore += rule->getOperationCount();
+
+            referenced.clear();
+            collectReferences(rule, m_count, referenced);
+            for (int id : referenced) {
+                ++m_references[id];
+                m_users[id].push_back(i);
+            }
+        }
+    }
+
+    InliningStats run() {
+        if (m_options.unitRules) {
+            for (int i = 0; i < m_count; ++i) {
+                if (isCandidate(i) && dynamic_cast<const RELeaf*>(current(i))) {
+                    inlineInto(i, true);
+                }
+            }
+        }
+        if (m_options.singleUse) {
+            for (int i = 0; i < m_count; ++i) {
+                if (isCandidate(i) && m_references[i] == 1) {
+                    inlineInto(i, false);
+                }
+            }
+        }
+        commit();
+        return std::move(m_stats);
+    }
+
+private:
+    const RETree* current(int nt) const {
+        if (m_trees[nt]) return m_trees[nt].get();
+        NTListItem* item = m_grammar->getNTItemByIndex(nt);
+        return item ? item->root() : nullptr;
+    }
+
+    std::unique_ptr<RETree>& mutableTree(int nt) {
+        if (!m_trees[nt]) m_trees[nt] = current(nt)->copy();
+        return m_trees[nt];
+    }
+
+    bool isCandidate(int nt) const {
+        if (nt == m_start || m_removed[nt] || !current(nt) || m_references[nt] == 0) return false;
+        NTListItem* item = m_grammar->getNTItemByIndex(nt);
+        return !item->isMacro();
+    }
+
+    // Current rules that still mention nt, without repeats
+    std::vector<int> users(int nt) {
+        std::vector<int>& list = m_users[nt];
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [&](int user) { return m_removed[user]; }),
+                   list.end());
+        return list;
+    }
+
+    void inlineInto(int nt, bool unit) {
+        const RETree* rule = current(nt);
+        std::vector<int> targets = users(nt);
+        if (std::find(targets.begin(), targets.end(), nt) != targets.end()) return;
+
+        const int growth = rule->getOperationCount() - 1;
+        if (growth > 0) {
+            for (int user : targets) {
+                if (current(user)->getOperationCount() + growth > m_options.maxRuleOperations) {
+                    ++m_stats.overBudget;
+                    return;
+                }
+            }
+        }
+
+        std::vector<int> referenced;
+        collectReferences(rule, m_count, referenced);
+
+        int occurrences = 0;
+        for (int user : targets) {
+            occurrences += replaceReferences(mutableTree(user), nt, rule);
+            for (int id : referenced) {
+                m_users[id].push_back(user);
+            }
+        }
+        // The rule now appears 'occurrences' times instead of once
+        for (int id : referenced) {
+            m_references[id] += occurrences - 1;
+        }
+        m_references[nt] = 0;
+        m_removed[nt] = true;
+
+        ++(unit ? m_stats.unitRules : m_stats.singleUse);
+        m_stats.inlined.push_back(m_grammar->getNTItemByIndex(nt)->name());
+    }
+
+    void commit() {
+        for (int i = 0; i < m_count; ++i) {
+            NTListItem* item = m_grammar->getNTItemByIndex(i);
+            if (m_removed[i]) {
+                item->setRoot(nullptr);
+                ++m_stats.rowsRemoved;
+            } else if (m_trees[i]) {
+                item->setRoot(std::move(m_trees[i]));
+            }
+            if (item->hasRoot()) m_stats.operationsAfter += item->root()->getOperationCount();
+        }
+    }
+
+    Grammar* m_grammar;
+    const InliningOptions& m_options;
+    int m_count;
+    int m_start = -1;
+    std::vector<std::unique_ptr<RETree>> m_trees;   // nullptr: rule unchanged
+    std::vector<bool> m_removed;
+    std::vector<int> m_references;                  // Occurrences in current rules
+    std::vector<std::vector<int>> m_users;          // Rules that mention the nonterminal (may be stale)
+    InliningStats m_stats;
+};
+
+}
+
+InliningStats Inlining::inlineRules(Grammar* grammar, const InliningOptions& options) {
+    if (!grammar) return InliningStats();
+    return InliningPass(grammar, options).run();
+}
+
+}
@@ -88,49 +88,60 @@ static std::unique_ptr<RETree> createUnaryIteration(std::unique_ptr<RETree> tree
     return REIteration::make(makeEpsilon(grammar), std::move(tree));
 }
 
+// Добавить общий суффикс к обеим частям разложения: суффикс переносится
+// в последнюю часть, которой он нужен, и копируется, только если нужен обеим
+static void appendToBoth(std::unique_ptr<RETree>& first,
+                         std::unique_ptr<RETree>& second,
+                         std::unique_ptr<RETree> suffix,
+                         Grammar* grammar) {
+    if (first) first = createAnd(std::move(first), second ? suffix->copy() : std::move(suffix), grammar);
+    if (second) second = createAnd(std::move(second), std::move(suffix), grammar);
+}
+
 // ---------------------------------------------------------------------------
 // Core recursive decomposition (Pascal TRE_*.leftEl)
+// Забирает дерево во владение и переиспользует его поддеревья в результате
 // ---------------------------------------------------------------------------
 
-static LeftTransformation computeLeftEl(const RETree* node, int ntId, Grammar* grammar);
+static LeftTransformation computeLeftEl(std::unique_ptr<RETree> node, int ntId, Grammar* grammar);
 
-static LeftTransformation computeLeftEl(const RETree* node, int ntId, Grammar* grammar) {
+static LeftTransformation computeLeftEl(std::unique_ptr<RETree> node, int ntId, Grammar* grammar) {
     if (!node) return {};
 
     // --- RETerminal ---
     // isEmpty() = (id == 0): E=true, R1=nil, R2=nil
     // иначе: E=false, R1=nil, R2=self
-    if (auto term = dynamic_cast<const RETerminal*>(node)) {
+    if (auto term = dynamic_cast<const RETerminal*>(node.get())) {
         if (term->getID() == 0) {
             return { nullptr, nullptr, true };
         }
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- RESemantic ---
     // В C++ системе "@" используется как epsilon; обычная семантика не пустая
-    if (auto sem = dynamic_cast<const RESemantic*>(node)) {
+    if (auto sem = dynamic_cast<const RESemantic*>(node.get())) {
         if (grammar->getSemanticName(sem->id()) == "@") {
             return { nullptr, nullptr, true };
         }
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- RENonTerminal ---
-    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
+    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node.get())) {
         if (ntNode->getID() == ntId) {
             // Это и есть A: leftEl(A) = { ε, nil, false }
             return { makeEpsilon(grammar), nullptr, false };
         }
         // Другой нетерминал: нет рекурсии
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- REOr(L, R) ---
     // R1 = Or(L.R1, R.R1), R2 = Or(L.R2, R.R2), E = L.E || R.E
-    if (auto orNode = dynamic_cast<const REOr*>(node)) {
-        auto LTr = computeLeftEl(orNode->left(),  ntId, grammar);
-        auto RTr = computeLeftEl(orNode->right(), ntId, grammar);
+    if (auto orNode = dynamic_cast<REOr*>(node.get())) {
+        auto LTr = computeLeftEl(orNode->releaseFirst(),  ntId, grammar);
+        auto RTr = computeLeftEl(orNode->releaseSecond(), ntId, grammar);
         return {
             createOr(std::move(LTr.R1), std::move(RTr.R1)),
             createOr(std::move(LTr.R2), std::move(RTr.R2)),
@@ -139,59 +150,54 @@ static LeftTransformation computeLeftEl(const RETree* node, int ntId, Grammar* g
     }
 
     // --- REAnd(L, R) ---
-    if (auto andNode = dynamic_cast<const REAnd*>(node)) {
-        const RETree* L = andNode->left();
-        const RETree* R = andNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
+    if (auto andNode = dynamic_cast<REAnd*>(node.get())) {
+        if (!andNode->left() || !andNode->right()) return { nullptr, std::move(node), false };
 
-        auto LTr = computeLeftEl(L, ntId, grammar);
+        auto R = andNode->releaseSecond();
+        auto LTr = computeLeftEl(andNode->releaseFirst(), ntId, grammar);
 
         if (!LTr.E) {
             // L не порождает ε
             // R1 = And(L.R1, R), R2 = And(L.R2, R)
-            return {
-                createAnd(std::move(LTr.R1), R->copy(), grammar),
-                createAnd(std::move(LTr.R2), R->copy(), grammar),
-                false
-            };
+            appendToBoth(LTr.R1, LTr.R2, std::move(R), grammar);
+            return { std::move(LTr.R1), std::move(LTr.R2), false };
         } else {
             // L может порождать ε → учитываем и правую часть
             // R1 = Or(And(L.R1, R), R.R1), R2 = Or(And(L.R2, R), R.R2), E = R.E
-            auto RTr = computeLeftEl(R, ntId, grammar);
+            if (LTr.R1 || LTr.R2) {
+                appendToBoth(LTr.R1, LTr.R2, R->copy(), grammar);
+            }
+            auto RTr = computeLeftEl(std::move(R), ntId, grammar);
             return {
-                createOr(createAnd(std::move(LTr.R1), R->copy(), grammar), std::move(RTr.R1)),
-                createOr(createAnd(std::move(LTr.R2), R->copy(), grammar), std::move(RTr.R2)),
+                createOr(std::move(LTr.R1), std::move(RTr.R1)),
+                createOr(std::move(LTr.R2), std::move(RTr.R2)),
                 RTr.E
             };
         }
     }
 
     // --- REIteration(L, R) ---
-    if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
-        const RETree* L = iterNode->left();
-        const RETree* R = iterNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
+    if (auto iterNode = dynamic_cast<REIteration*>(node.get())) {
+        if (!iterNode->left() || !iterNode->right()) return { nullptr, std::move(node), false };
 
-        if (isEpsilonNode(L, grammar)) {
+        if (isEpsilonNode(iterNode->left(), grammar)) {
             // Унарная итерация ε*R: E=true
             // R1 = And(R.R1, self), R2 = And(R.R2, self)
-            auto RTr = computeLeftEl(R, ntId, grammar);
-            return {
-                createAnd(std::move(RTr.R1), node->copy(), grammar),
-                createAnd(std::move(RTr.R2), node->copy(), grammar),
-                true
-            };
+            auto RTr = computeLeftEl(iterNode->right()->copy(), ntId, grammar);
+            appendToBoth(RTr.R1, RTr.R2, std::move(node), grammar);
+            return { std::move(RTr.R1), std::move(RTr.R2), true };
         } else {
-            // Общая итерация L*R → And(L, UnaryIter(And(R,L)))
-            auto innerAnd  = REAnd::make(R->copy(), L->copy());
+            // Общая итерация L*R → And(L, UnaryIter(And(R,L))); копируется только L
+            auto L = iterNode->releaseFirst();
+            auto innerAnd  = REAnd::make(iterNode->releaseSecond(), L->copy());
             auto iterEps   = createUnaryIteration(std::move(innerAnd), grammar);
-            auto temp      = REAnd::make(L->copy(), std::move(iterEps));
-            return computeLeftEl(temp.get(), ntId, grammar);
+            auto temp      = REAnd::make(std::move(L), std::move(iterEps));
+            return computeLeftEl(std::move(temp), ntId, grammar);
         }
     }
 
     // Неизвестный тип → нерекурсивный лист
-    return { nullptr, node->copy(), false };
+    return { nullptr, std::move(node), false };
 }
 
 // ---------------------------------------------------------------------------
@@ -228,17 +234,11 @@ bool LeftElimination::hasDirectLeftRecursion(NTListItem* nt) {
     return isLeftRecursive(root, nt);
 }
 
-void LeftElimination::eliminateForNonTerminal(NTListItem* nt, Grammar* grammar) {
-    if (!nt || !grammar) return;
-
-    RETree* root = nt->root();
-    if (!root) return;
-
-    int ntId = grammar->findNonTerminal(nt->name());
-    if (ntId < 0) return;
+std::unique_ptr<RETree> LeftElimination::eliminateRule(const RETree* root, int ntId, Grammar* grammar) {
+    if (!root || !grammar || ntId < 0) return nullptr;
 
     // Вычислить трансформацию: TTransformation{R1, R2, E}
-    auto tr = computeLeftEl(root, ntId, grammar);
+    auto tr = computeLeftEl(root->copy(), ntId, grammar);
 
     bool r2WasNonNull = (tr.R2 != nullptr);
 
@@ -251,6 +251,16 @@ void LeftElimination::eliminateForNonTerminal(NTListItem* nt, Grammar* grammar)
         newRoot = createOrEmpty(std::move(newRoot), grammar);
     }
 
+    return newRoot;
+}
+
+void LeftElimination::eliminateForNonTerminal(NTListItem* nt, Grammar* grammar) {
+    if (!nt || !grammar) return;
+
+    RETree* root = nt->root();
+    if (!root) return;
+
+    auto newRoot = eliminateRule(root, grammar->findNonTerminal(nt->name()), grammar);
     if (newRoot) {
         nt->setRoot(std::move(newRoot));
     }
@@ -0,0 +1,124 @@
+#include <syngt/transform/MergeEquivalent.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/REStructure.h>
+#include <memory>
+#include <unordered_map>
+
+namespace syngt {
+
+namespace {
+
+// Splits every block by rule structure under the current blocks;
+// new block numbers follow the first member, so the result is deterministic
+int refine(const std::vector<const RETree*>& rules, std::vector<int>& blocks) {
+    const int count = static_cast<int>(rules.size());
+    std::vector<size_t> hashes(count, 0);
+    for (int i = 0; i < count; ++i) {
+        if (rules[i]) hashes[i] = structuralHash(rules[i], blocks);
+    }
+
+    auto hashNT = [&](int nt) { return hashes[nt] ^ (static_cast<size_t>(blocks[nt]) * 0x9e3779b97f4a7c15ull); };
+    auto equalNT = [&](int a, int b) {
+        return blocks[a] == blocks[b] && structurallyEqual(rules[a], rules[b], blocks);
+    };
+    std::unordered_map<int, int, decltype(hashNT), decltype(equalNT)> firstOfBlock(count, hashNT, equalNT);
+
+    std::vector<int> refined(count);
+    int blockCount = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!rules[i]) {
+            refined[i] = blockCount++;
+            continue;
+        }
+        auto [it, inserted] = firstOfBlock.emplace(i, blockCount);
+        refined[i] = inserted ? blockCount++ : it->second;
+    }
+    blocks.swap(refined);
+    return blockCount;
+}
+
+// Copy of node with every nonterminal replaced by its representative;
+// nullptr when nothing had to be replaced
+std::unique_ptr<RETree> redirect(const RETree* node, const std::vector<int>& representative,
+                                 Grammar* grammar) {
+    if (!node) return nullptr;
+    if (auto nt = dynamic_cast<const RENonTerminal*>(node)) {
+        int id = nt->getID();
+        if (id < 0 || id >= static_cast<int>(representative.size()) || representative[id] == id)
+            return nullptr;
+        return RENonTerminal::makeFromIDAndOpen(grammar, representative[id], nt->isOpen());
+    }
+    if (!node->left() || !node->right()) return nullptr;
+
+    auto first = redirect(node->left(), representative, grammar);
+    auto second = redirect(node->right(), representative, grammar);
+    if (!first && !second) return nullptr;
+    if (!first) first = node->left()->copy();
+    if (!second) second = node->right()->copy();
+
+    if (dynamic_cast<const REOr*>(node)) return REOr::make(std::move(first), std::move(second));
+    if (dynamic_cast<const REAnd*>(node)) return REAnd::make(std::move(first), std::move(second));
+    return REIteration::make(std::move(first), std::move(second));
+}
+
+}
+
+MergeEquivalentReport MergeEquivalent::merge(Grammar* grammar) {
+    MergeEquivalentReport report;
+    if (!grammar) return report;
+
+    const int count = static_cast<int>(grammar->getNonTerminals().size());
+    std::vector<const RETree*> rules(count, nullptr);
+    std::vector<int> blocks(count, 0);
+    int blockCount = 1;
+    for (int i = 0; i < count; ++i) {
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (nt && nt->hasRoot()) rules[i] = nt->root();
+        else blocks[i] = blockCount++;
+    }
+
+    // Blocks only ever split, so an unchanged count means a fixed point
+    for (;;) {
+        ++report.rounds;
+        int refined = refine(rules, blocks);
+        if (refined == blockCount) break;
+        blockCount = refined;
+    }
+
+    std::vector<int> firstOfBlock(blockCount, -1);
+    std::vector<int> representative(count);
+    std::vector<int> classOfBlock(blockCount, -1);
+    for (int i = 0; i < count; ++i) {
+        int& first = firstOfBlock[blocks[i]];
+        if (first < 0) first = i;
+        representative[i] = first;
+        if (first == i) continue;
+
+        int& merged = classOfBlock[blocks[i]];
+        if (merged < 0) {
+            merged = static_cast<int>(report.merged.size());
+            report.merged.push_back({grammar->getNTItemByIndex(first)->name()});
+        }
+        report.merged[merged].push_back(grammar->getNTItemByIndex(i)->name());
+    }
+    if (report.merged.empty()) return report;
+
+    for (int i = 0; i < count; ++i) {
+        if (!rules[i]) continue;
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (representative[i] != i) {
+            nt->setRoot(nullptr);
+        } else if (auto redirected = redirect(rules[i], representative, grammar)) {
+            nt->setRoot(std::move(redirected));
+        }
+    }
+    return report;
+}
+
+}
@@ -8,7 +8,13 @@
 #include <syngt/regex/REIteration.h>
 #include <syngt/regex/RESemantic.h>
 #include <syngt/regex/RETerminal.h>
+#include <syngt/regex/REStructure.h>
+#include <syngt/analysis/ReferenceGraph.h>
+#include <syngt/transform/LeftElimination.h>
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
 
 namespace syngt {
 
@@ -93,50 +99,78 @@ static std::unique_ptr<RETree> createIteration(std::unique_ptr<RETree> left,
     return REIteration::make(std::move(left), std::move(right));
 }
 
+// Append the same suffix to both parts of a decomposition. The suffix is
+// moved into the last part that needs it and copied only when both do.
+static void appendToBoth(std::unique_ptr<RETree>& first,
+                         std::unique_ptr<RETree>& second,
+                         std::unique_ptr<RETree> suffix,
+                         Grammar* grammar) {
+    if (first) first = createAnd(std::move(first), second ? suffix->copy() : std::move(suffix), grammar);
+    if (second) second = createAnd(std::move(second), std::move(suffix), grammar);
+}
+
+// Mirror of appendToBoth for a shared prefix
+static void prependToBoth(std::unique_ptr<RETree> prefix,
+                          std::unique_ptr<RETree>& first,
+                          std::unique_ptr<RETree>& second,
+                          Grammar* grammar) {
+    if (first) first = createAnd(second ? prefix->copy() : std::move(prefix), std::move(first), grammar);
+    if (second) second = createAnd(std::move(prefix), std::move(second), grammar);
+}
+
+// General L*R → L·(R·L)*: L occurs twice, so it is the only copy made
+static std::unique_ptr<RETree> expandIteration(REIteration* iterNode, Grammar* grammar) {
+    auto L = iterNode->releaseFirst();
+    auto R = iterNode->releaseSecond();
+    auto innerAnd = REAnd::make(std::move(R), L->copy());
+    return REAnd::make(std::move(L), createUnaryIteration(std::move(innerAnd), grammar));
+}
+
 // ---------------------------------------------------------------------------
 // computeLeftEl — recursive leftEl decomposition
 // Decomposes T into: T = A·R1 | R2
 // (analog of TRE_Tree.leftEl virtual method from Pascal)
+//
+// Takes ownership of the tree and reuses its subtrees in the result;
+// a subtree is copied only where it really occurs twice.
 // ---------------------------------------------------------------------------
 
-static LeftTransformation computeLeftEl(const RETree* node,
-                                        const NTListItem* nt,
+static LeftTransformation computeLeftEl(std::unique_ptr<RETree> node,
+                                        int ntId,
                                         Grammar* grammar);
 
-static LeftTransformation computeLeftEl(const RETree* node,
-                                        const NTListItem* nt,
+static LeftTransformation computeLeftEl(std::unique_ptr<RETree> node,
+                                        int ntId,
                                         Grammar* grammar) {
     if (!node) return {};
 
-    const int ntId = grammar->findNonTerminal(nt->name());
-
     // --- RENonTerminal ---
-    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
+    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node.get())) {
         if (ntNode->getID() == ntId) {
             // This IS A: T = A·ε | ∅
             return { makeEpsilon(grammar), nullptr, false };
         }
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- RETerminal ---
-    if (auto termNode = dynamic_cast<const RETerminal*>(node)) {
+    if (auto termNode = dynamic_cast<const RETerminal*>(node.get())) {
         if (termNode->getID() == 0)
             return { nullptr, nullptr, true };
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- RESemantic ---
-    if (auto semNode = dynamic_cast<const RESemantic*>(node)) {
+    if (auto semNode = dynamic_cast<const RESemantic*>(node.get())) {
         if (grammar->getSemanticName(semNode->id()) == "@")
             return { nullptr, nullptr, true };
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- REOr(L, R) ---
-    if (auto orNode = dynamic_cast<const REOr*>(node)) {
-        auto LTr = computeLeftEl(orNode->left(),  nt, grammar);
-        auto RTr = computeLeftEl(orNode->right(), nt, grammar);
+    if (auto orNode = dynamic_cast<REOr*>(node.get())) {
+        auto LTr = computeLeftEl(orNode->releaseFirst(),  ntId, grammar);
+        auto RTr = computeLeftEl(orNode->releaseSecond(), ntId, grammar);
         return {
             createOr(std::move(LTr.R1), std::move(RTr.R1)),
             createOr(std::move(LTr.R2), std::move(RTr.R2)),
@@ -145,56 +179,46 @@ static LeftTransformation computeLeftEl(const RETree* node,
     }
 
     // --- REAnd(L, R) ---
-    if (auto andNode = dynamic_cast<const REAnd*>(node)) {
-        const RETree* L = andNode->left();
-        const RETree* R = andNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
+    if (auto andNode = dynamic_cast<REAnd*>(node.get())) {
+        if (!andNode->left() || !andNode->right()) return { nullptr, std::move(node), false };
 
-        auto LTr = computeLeftEl(L, nt, grammar);
+        auto R = andNode->releaseSecond();
+        auto LTr = computeLeftEl(andNode->releaseFirst(), ntId, grammar);
 
         if (!LTr.E) {
             // L cannot produce epsilon: left recursion only through L's left edge
-            return {
-                createAnd(std::move(LTr.R1), R->copy(), grammar),
-                createAnd(std::move(LTr.R2), R->copy(), grammar),
-                false
-            };
+            appendToBoth(LTr.R1, LTr.R2, std::move(R), grammar);
+            return { std::move(LTr.R1), std::move(LTr.R2), false };
         } else {
             // L can produce epsilon: also check right operand
-            auto RTr = computeLeftEl(R, nt, grammar);
+            if (LTr.R1 || LTr.R2)
+                appendToBoth(LTr.R1, LTr.R2, R->copy(), grammar);
+            auto RTr = computeLeftEl(std::move(R), ntId, grammar);
             return {
-                createOr(createAnd(std::move(LTr.R1), R->copy(), grammar), std::move(RTr.R1)),
-                createOr(createAnd(std::move(LTr.R2), R->copy(), grammar), std::move(RTr.R2)),
+                createOr(std::move(LTr.R1), std::move(RTr.R1)),
+                createOr(std::move(LTr.R2), std::move(RTr.R2)),
                 RTr.E
             };
         }
     }
 
     // --- REIteration(L, R) ---
-    if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
-        const RETree* L = iterNode->left();
-        const RETree* R = iterNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
-
-        if (isEpsilonNode(L, grammar)) {
-            // Unary star: ε*R = R*
-            auto RTr = computeLeftEl(R, nt, grammar);
-            return {
-                createAnd(std::move(RTr.R1), node->copy(), grammar),
-                createAnd(std::move(RTr.R2), node->copy(), grammar),
-                true
-            };
+    if (auto iterNode = dynamic_cast<REIteration*>(node.get())) {
+        if (!iterNode->left() || !iterNode->right()) return { nullptr, std::move(node), false };
+
+        if (isEpsilonNode(iterNode->left(), grammar)) {
+            // Unary star: ε*R = R*; the star itself follows both parts
+            auto RTr = computeLeftEl(iterNode->right()->copy(), ntId, grammar);
+            appendToBoth(RTr.R1, RTr.R2, std::move(node), grammar);
+            return { std::move(RTr.R1), std::move(RTr.R2), true };
         } else {
             // General L*R → expand to L·(R·L)* then recurse
-            auto innerAnd = REAnd::make(R->copy(), L->copy());
-            auto iterEps  = createUnaryIteration(std::move(innerAnd), grammar);
-            auto temp     = REAnd::make(L->copy(), std::move(iterEps));
-            return computeLeftEl(temp.get(), nt, grammar);
+            return computeLeftEl(expandIteration(iterNode, grammar), ntId, grammar);
         }
     }
 
     // Unknown type: treat as non-recursive leaf
-    return { nullptr, node->copy(), false };
+    return { nullptr, std::move(node), false };
 }
 
 // ---------------------------------------------------------------------------
@@ -203,42 +227,40 @@ static LeftTransformation computeLeftEl(const RETree* node,
 // (analog of TRE_Tree.rightEl virtual method from Pascal)
 // ---------------------------------------------------------------------------
 
-static RightTransformation computeRightEl(const RETree* node,
-                                          const NTListItem* nt,
+static RightTransformation computeRightEl(std::unique_ptr<RETree> node,
+                                          int ntId,
                                           Grammar* grammar);
 
-static RightTransformation computeRightEl(const RETree* node,
-                                          const NTListItem* nt,
+static RightTransformation computeRightEl(std::unique_ptr<RETree> node,
+                                          int ntId,
                                           Grammar* grammar) {
     if (!node) return {};
 
-    const int ntId = grammar->findNonTerminal(nt->name());
-
     // --- RENonTerminal ---
-    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
+    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node.get())) {
         if (ntNode->getID() == ntId)
             return { makeEpsilon(grammar), nullptr, false };
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- RETerminal ---
-    if (auto termNode = dynamic_cast<const RETerminal*>(node)) {
+    if (auto termNode = dynamic_cast<const RETerminal*>(node.get())) {
         if (termNode->getID() == 0)
             return { nullptr, nullptr, true };
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- RESemantic ---
-    if (auto semNode = dynamic_cast<const RESemantic*>(node)) {
+    if (auto semNode = dynamic_cast<const RESemantic*>(node.get())) {
         if (grammar->getSemanticName(semNode->id()) == "@")
             return { nullptr, nullptr, true };
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- REOr(L, R) ---
-    if (auto orNode = dynamic_cast<const REOr*>(node)) {
-        auto LTr = computeRightEl(orNode->left(),  nt, grammar);
-        auto RTr = computeRightEl(orNode->right(), nt, grammar);
+    if (auto orNode = dynamic_cast<REOr*>(node.get())) {
+        auto LTr = computeRightEl(orNode->releaseFirst(),  ntId, grammar);
+        auto RTr = computeRightEl(orNode->releaseSecond(), ntId, grammar);
         return {
             createOr(std::move(LTr.RA), std::move(RTr.RA)),
             createOr(std::move(LTr.RB), std::move(RTr.RB)),
@@ -247,67 +269,82 @@ static RightTransformation computeRightEl(const RETree* node,
     }
 
     // --- REAnd(L, R) ---
-    if (auto andNode = dynamic_cast<const REAnd*>(node)) {
-        const RETree* L = andNode->left();
-        const RETree* R = andNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
+    if (auto andNode = dynamic_cast<REAnd*>(node.get())) {
+        if (!andNode->left() || !andNode->right()) return { nullptr, std::move(node), false };
 
-        auto RTr = computeRightEl(R, nt, grammar);
+        auto L = andNode->releaseFirst();
+        auto RTr = computeRightEl(andNode->releaseSecond(), ntId, grammar);
 
         if (!RTr.E) {
-            return {
-                createAnd(L->copy(), std::move(RTr.RA), grammar),
-                createAnd(L->copy(), std::move(RTr.RB), grammar),
-                false
-            };
+            prependToBoth(std::move(L), RTr.RA, RTr.RB, grammar);
+            return { std::move(RTr.RA), std::move(RTr.RB), false };
         } else {
-            auto LTr = computeRightEl(L, nt, grammar);
+            if (RTr.RA || RTr.RB)
+                prependToBoth(L->copy(), RTr.RA, RTr.RB, grammar);
+            auto LTr = computeRightEl(std::move(L), ntId, grammar);
             return {
-                createOr(createAnd(L->copy(), std::move(RTr.RA), grammar), std::move(LTr.RA)),
-                createOr(createAnd(L->copy(), std::move(RTr.RB), grammar), std::move(LTr.RB)),
+                createOr(std::move(RTr.RA), std::move(LTr.RA)),
+                createOr(std::move(RTr.RB), std::move(LTr.RB)),
                 LTr.E
             };
         }
     }
 
     // --- REIteration(L, R) ---
-    if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
-        const RETree* L = iterNode->left();
-        const RETree* R = iterNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
+    if (auto iterNode = dynamic_cast<REIteration*>(node.get())) {
+        if (!iterNode->left() || !iterNode->right()) return { nullptr, std::move(node), false };
 
-        if (isEpsilonNode(L, grammar)) {
-            auto RTr = computeRightEl(R, nt, grammar);
-            return {
-                createAnd(node->copy(), std::move(RTr.RA), grammar),
-                createAnd(node->copy(), std::move(RTr.RB), grammar),
-                true
-            };
+        if (isEpsilonNode(iterNode->left(), grammar)) {
+            auto RTr = computeRightEl(iterNode->right()->copy(), ntId, grammar);
+            prependToBoth(std::move(node), RTr.RA, RTr.RB, grammar);
+            return { std::move(RTr.RA), std::move(RTr.RB), true };
         } else {
-            auto innerAnd = REAnd::make(R->copy(), L->copy());
-            auto iterEps  = createUnaryIteration(std::move(innerAnd), grammar);
-            auto temp     = REAnd::make(L->copy(), std::move(iterEps));
-            return computeRightEl(temp.get(), nt, grammar);
+            return computeRightEl(expandIteration(iterNode, grammar), ntId, grammar);
         }
     }
 
-    return { nullptr, node->copy(), false };
+    return { nullptr, std::move(node), false };
 }
 
 // ---------------------------------------------------------------------------
-// Helper for null-safe rightEl call (used in regularize)
+// Public API
 // ---------------------------------------------------------------------------
 
-static RightTransformation safeRightEl(const RETree* tree,
-                                       const NTListItem* nt,
-                                       Grammar* grammar) {
-    if (!tree) return {};
-    return computeRightEl(tree, nt, grammar);
-}
+std::unique_ptr<RETree> Regularize::regularizeRule(const RETree* root, int ntId, Grammar* grammar) {
+    if (!root || !grammar) return nullptr;
+
+    // Step 1: leftEl decomposition → T = A·R1 | R2
+    // (works on a single copy of the rule, which it takes apart)
+    auto tr = computeLeftEl(root->copy(), ntId, grammar);
+
+    // Step 2: rightEl on R1 and R2 separately
+    // R1 = RA1·A | RB1
+    // R2 = RA2·A | RB2
+    auto RightT_R1 = computeRightEl(std::move(tr.R1), ntId, grammar);
+    auto RightT_R2 = computeRightEl(std::move(tr.R2), ntId, grammar);
+
+    // Step 3: assemble the final expression
+    //
+    // From the Pascal regularize() formula:
+    //   core = (RA2)* · RB2 · (RB1)*
+    //   if E: core = ε | core
+    //   N    = core # RA1  (i.e. core·(RA1·core)*)
+    //
+    auto core = createAnd(
+        createAnd(
+            createUnaryIteration(std::move(RightT_R2.RA), grammar),  // (RA2)*
+            std::move(RightT_R2.RB),                                  // · RB2
+            grammar
+        ),
+        createUnaryIteration(std::move(RightT_R1.RB), grammar),       // · (RB1)*
+        grammar
+    );
 
-// ---------------------------------------------------------------------------
-// Public API
-// ---------------------------------------------------------------------------
+    if (tr.E && core)
+        core = createOrEmpty(std::move(core), grammar);
+
+    return createIteration(std::move(core), std::move(RightT_R1.RA));
+}
 
 void Regularize::regularize(Grammar* grammar) {
     if (!grammar) return;
@@ -319,40 +356,173 @@ void Regularize::regularize(Grammar* grammar) {
         NTListItem* nt = grammar->getNTItemByIndex(i);
         if (!nt || !nt->root()) continue;
 
-        // Step 1: leftEl decomposition → T = A·R1 | R2
-        auto tr = computeLeftEl(nt->root(), nt, grammar);
-
-        // Step 2: rightEl on R1 and R2 separately
-        // R1 = RA1·A | RB1
-        // R2 = RA2·A | RB2
-        auto RightT_R1 = safeRightEl(tr.R1.get(), nt, grammar);
-        auto RightT_R2 = safeRightEl(tr.R2.get(), nt, grammar);
-
-        // Step 3: assemble the final expression
-        //
-        // From the Pascal regularize() formula:
-        //   core = (RA2)* · RB2 · (RB1)*
-        //   if E: core = ε | core
-        //   N    = core # RA1  (i.e. core·(RA1·core)*)
-        //
-        auto core = createAnd(
-            createAnd(
-                createUnaryIteration(std::move(RightT_R2.RA), grammar),  // (RA2)*
-                std::move(RightT_R2.RB),                                  // · RB2
-                grammar
-            ),
-            createUnaryIteration(std::move(RightT_R1.RB), grammar),       // · (RB1)*
-            grammar
-        );
+        auto newRoot = regularizeRule(nt->root(), i, grammar);
+        if (newRoot)
+            nt->setRoot(std::move(newRoot));
+    }
+}
 
-        if (tr.E && core)
-            core = createOrEmpty(std::move(core), grammar);
+// ---------------------------------------------------------------------------
+// Component-ordered driver
+// ---------------------------------------------------------------------------
 
-        auto newRoot = createIteration(std::move(core), std::move(RightT_R1.RA));
+// Whether computeLeftEl/computeRightEl would see the node produce ε (their E)
+static bool canBeEmpty(const RETree* node, Grammar* grammar) {
+    if (!node) return false;
+    if (isEpsilonNode(node, grammar)) return true;
+    if (auto orNode = dynamic_cast<const REOr*>(node))
+        return canBeEmpty(orNode->left(), grammar) || canBeEmpty(orNode->right(), grammar);
+    if (auto andNode = dynamic_cast<const REAnd*>(node))
+        return canBeEmpty(andNode->left(), grammar) && canBeEmpty(andNode->right(), grammar);
+    if (auto iterNode = dynamic_cast<const REIteration*>(node))
+        return isEpsilonNode(iterNode->left(), grammar) || canBeEmpty(iterNode->left(), grammar);
+    return false;
+}
 
-        if (newRoot)
-            nt->setRoot(std::move(newRoot));
+// Edge flags of the operands of a binary node that sits on the given edges:
+//   L;R  — both operands keep the node's edges
+//   L,R  — R is on the left edge behind an empty L, L on the right edge before an empty R
+//   @#R  — R* keeps both edges
+//   L#R  — L(RL)*: L keeps both edges, R only behind an empty L
+struct EdgeFlags {
+    bool firstLeft, firstRight, secondLeft, secondRight;
+};
+
+static EdgeFlags operandEdges(const RETree* node, bool atLeft, bool atRight, Grammar* grammar) {
+    const RETree* L = node->left();
+    if (dynamic_cast<const REAnd*>(node)) {
+        return {atLeft, atRight && canBeEmpty(node->right(), grammar),
+                atLeft && canBeEmpty(L, grammar), atRight};
+    }
+    if (dynamic_cast<const REIteration*>(node) && !isEpsilonNode(L, grammar)) {
+        bool emptyL = canBeEmpty(L, grammar);
+        return {atLeft, atRight, atLeft && emptyL, atRight && emptyL};
+    }
+    return {atLeft, atRight, atLeft, atRight};
+}
+
+static int countEdgeOccurrences(const RETree* node, int target, bool atLeft, bool atRight,
+                                Grammar* grammar) {
+    if (!atLeft && !atRight) return 0;
+    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node))
+        return ntNode->getID() == target ? 1 : 0;
+    if (!dynamic_cast<const REBinaryOp*>(node) || !node->left() || !node->right()) return 0;
+
+    EdgeFlags edges = operandEdges(node, atLeft, atRight, grammar);
+    return countEdgeOccurrences(node->left(), target, edges.firstLeft, edges.firstRight, grammar) +
+           countEdgeOccurrences(node->right(), target, edges.secondLeft, edges.secondRight, grammar);
+}
+
+// Copy of node with the occurrences of target on its left (and/or right)
+// edge replaced by copies of replacement
+static std::unique_ptr<RETree> substituteEdges(const RETree* node, int target,
+                                               const RETree* replacement,
+                                               bool atLeft, bool atRight, Grammar* grammar) {
+    if (!atLeft && !atRight) return node->copy();
+    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node))
+        return ntNode->getID() == target ? replacement->copy() : node->copy();
+    if (!dynamic_cast<const REBinaryOp*>(node) || !node->left() || !node->right()) return node->copy();
+
+    EdgeFlags edges = operandEdges(node, atLeft, atRight, grammar);
+    auto first = substituteEdges(node->left(), target, replacement,
+                                 edges.firstLeft, edges.firstRight, grammar);
+    auto second = substituteEdges(node->right(), target, replacement,
+                                  edges.secondLeft, edges.secondRight, grammar);
+    if (dynamic_cast<const REOr*>(node)) return REOr::make(std::move(first), std::move(second));
+    if (dynamic_cast<const REAnd*>(node)) return REAnd::make(std::move(first), std::move(second));
+    return REIteration::make(std::move(first), std::move(second));
+}
+
+namespace {
+
+struct ComponentResult {
+    std::vector<std::unique_ptr<RETree>> roots;     // nullptr: rule unchanged
+    ComponentStats stats;
+};
+
+}
+
+// Paull's algorithm restricted to one component; the grammar is only read
+static ComponentResult processComponent(const std::vector<int>& members, Grammar* grammar,
+                                        const RegularizeOptions& options) {
+    ComponentResult result;
+    result.roots.resize(members.size());
+    auto current = [&](size_t k) -> const RETree* {
+        return result.roots[k] ? result.roots[k].get() : grammar->getNTItemByIndex(members[k])->root();
+    };
+    const bool rightEdges = options.transform == rtRegularize;
+
+    for (size_t i = 0; i < members.size(); ++i) {
+        const RETree* root = current(i);
+        result.stats.nonTerminals.push_back(grammar->getNTItemByIndex(members[i])->name());
+        if (!root) continue;
+        result.stats.nodesBefore += nodeCount(root);
+
+        for (size_t j = 0; j < i; ++j) {
+            const RETree* replacement = current(j);
+            if (!replacement) continue;
+            int occurrences = countEdgeOccurrences(current(i), members[j], true, rightEdges, grammar);
+            if (occurrences == 0) continue;
+            result.stats.substitutions += occurrences;
+            result.roots[i] = substituteEdges(current(i), members[j], replacement, true, rightEdges, grammar);
+        }
+
+        auto transformed = options.transform == rtRegularize
+            ? Regularize::regularizeRule(current(i), members[i], grammar)
+            : LeftElimination::eliminateRule(current(i), members[i], grammar);
+        if (transformed) result.roots[i] = std::move(transformed);
+    }
+
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (current(i)) result.stats.nodesAfter += nodeCount(current(i));
+    }
+    return result;
+}
+
+RegularizeStats Regularize::regularize(Grammar* grammar, const RegularizeOptions& options) {
+    RegularizeStats stats;
+    if (!grammar) return stats;
+
+    auto graph = ReferenceGraph::build(grammar);
+    auto components = graph.stronglyConnectedComponents();
+    for (auto& members : components) {
+        std::sort(members.begin(), members.end());
+    }
+    stats.components = static_cast<int>(components.size());
+
+    unsigned threads = options.threads;
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, static_cast<unsigned>(components.size()));
+
+    // Components only read the grammar; rules are committed in order afterwards
+    std::vector<ComponentResult> results(components.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next++; i < components.size(); i = next++) {
+            results[i] = processComponent(components[i], grammar, options);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) thread.join();
+
+    for (size_t c = 0; c < components.size(); ++c) {
+        const auto& members = components[c];
+        for (size_t k = 0; k < members.size(); ++k) {
+            if (results[c].roots[k]) {
+                grammar->getNTItemByIndex(members[k])->setRoot(std::move(results[c].roots[k]));
+            }
+        }
+        stats.nodesBefore += results[c].stats.nodesBefore;
+        stats.nodesAfter += results[c].stats.nodesAfter;
+        if (members.size() > 1 || graph.hasSelfLoop(members[0])) {
+            stats.recursive.push_back(std::move(results[c].stats));
+        }
     }
+    return stats;
 }
 
 } // namespace syngt
@@ -3,153 +3,166 @@
 #include <syngt/core/NTListItem.h>
 #include <syngt/regex/RETree.h>
 #include <syngt/regex/RENonTerminal.h>
-#include <syngt/regex/RETerminal.h>
-#include <syngt/regex/RESemantic.h>
 #include <syngt/regex/REOr.h>
 #include <syngt/regex/REAnd.h>
 #include <syngt/regex/REIteration.h>
-#include <queue>
-#include <set>
-#include <iostream>
+#include <vector>
 
 namespace syngt {
 
-static bool checkTreeProductive(const RETree* tree, const std::set<int>& productive) {
-    if (!tree) return true;
-    
-    if (dynamic_cast<const RETerminal*>(tree)) {
-        return true;
-    }
-    
-    if (dynamic_cast<const RESemantic*>(tree)) {
-        return true;
-    }
-    
-    if (auto nt = dynamic_cast<const RENonTerminal*>(tree)) {
-        return productive.count(nt->getID()) > 0;
-    }
-    
-    if (auto orNode = dynamic_cast<const REOr*>(tree)) {
-        return checkTreeProductive(orNode->left(), productive) ||
-               checkTreeProductive(orNode->right(), productive);
-    }
-    
-    if (auto andNode = dynamic_cast<const REAnd*>(tree)) {
-        return checkTreeProductive(andNode->left(), productive) &&
-               checkTreeProductive(andNode->right(), productive);
-    }
-    
-    if (dynamic_cast<const REIteration*>(tree)) {
-        return true;
-    }
-    
-    return true;
-}
+namespace {
 
-static void collectUsedIndices(const RETree* tree, std::set<int>& used) {
-    if (!tree) return;
-    
-    if (auto nt = dynamic_cast<const RENonTerminal*>(tree)) {
-        used.insert(nt->getID());
-        return;
-    }
-    
-    if (auto orNode = dynamic_cast<const REOr*>(tree)) {
-        collectUsedIndices(orNode->left(), used);
-        collectUsedIndices(orNode->right(), used);
+// Every rule is flattened into gates: a gate becomes productive once
+// 'pending' of its operands have (one for ';', two for ',') and then
+// notifies its parent. Rule roots notify the nonterminal instead.
+struct Gate {
+    int parent = -1;
+    int pending = 0;
+    int rule = -1;      // Nonterminal whose root this gate is
+};
+
+class ProductivityNetwork {
+public:
+    explicit ProductivityNetwork(int ntCount)
+        : m_occurrences(ntCount), m_references(ntCount) {}
+
+    void addRule(int nt, const RETree* root) {
+        int gate = addNode(root, -1, nt, true);
+        m_gates[gate].rule = nt;
     }
-    
-    if (auto andNode = dynamic_cast<const REAnd*>(tree)) {
-        collectUsedIndices(andNode->left(), used);
-        collectUsedIndices(andNode->right(), used);
+
+    // Worklist propagation; each gate and each occurrence is handled once
+    std::vector<bool> solve() {
+        std::vector<bool> productive(m_occurrences.size(), false);
+        while (!m_ready.empty()) {
+            int gate = m_ready.back();
+            m_ready.pop_back();
+
+            const Gate& current = m_gates[gate];
+            if (current.parent >= 0) {
+                if (--m_gates[current.parent].pending == 0) m_ready.push_back(current.parent);
+            } else if (current.rule >= 0 && !productive[current.rule]) {
+                productive[current.rule] = true;
+                for (int occurrence : m_occurrences[current.rule]) {
+                    m_ready.push_back(occurrence);
+                }
+            }
+        }
+        return productive;
     }
-    
-    if (auto iterNode = dynamic_cast<const REIteration*>(tree)) {
-        collectUsedIndices(iterNode->left(), used);
-        collectUsedIndices(iterNode->right(), used);
+
+    // Nonterminals mentioned anywhere in the rule of nt (with repeats)
+    const std::vector<int>& references(int nt) const { return m_references[nt]; }
+
+private:
+    // 'counted' is false under the right operand of '#': A#B = A(BA)* is
+    // productive together with A, but B's references still make nonterminals reachable
+    int addNode(const RETree* node, int parent, int owner, bool counted) {
+        int gate = static_cast<int>(m_gates.size());
+        m_gates.push_back(Gate{counted ? parent : -1, 0, -1});
+
+        if (auto nt = dynamic_cast<const RENonTerminal*>(node)) {
+            int id = nt->getID();
+            if (id >= 0 && id < static_cast<int>(m_occurrences.size())) {
+                m_references[owner].push_back(id);
+                if (counted) m_occurrences[id].push_back(gate);
+            }
+            return gate;
+        }
+
+        if (auto orNode = dynamic_cast<const REOr*>(node)) {
+            m_gates[gate].pending = 1;
+            addNode(orNode->left(), gate, owner, counted);
+            addNode(orNode->right(), gate, owner, counted);
+            return gate;
+        }
+
+        if (auto andNode = dynamic_cast<const REAnd*>(node)) {
+            m_gates[gate].pending = 2;
+            addNode(andNode->left(), gate, owner, counted);
+            addNode(andNode->right(), gate, owner, counted);
+            return gate;
+        }
+
+        if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
+            m_gates[gate].pending = 1;
+            addNode(iterNode->left(), gate, owner, counted);
+            addNode(iterNode->right(), gate, owner, false);
+            return gate;
+        }
+
+        // Terminals, semantics and macros are productive by themselves
+        if (counted) m_ready.push_back(gate);
+        return gate;
     }
+
+    std::vector<Gate> m_gates;
+    std::vector<int> m_ready;
+    std::vector<std::vector<int>> m_occurrences;
+    std::vector<std::vector<int>> m_references;
+};
+
 }
 
-void RemoveUseless::remove(Grammar* grammar) {
-    if (!grammar) return;
-    
-    auto allNTs = grammar->getNonTerminals();
-    int ntCount = static_cast<int>(allNTs.size());
+RemoveUselessReport RemoveUseless::remove(Grammar* grammar) {
+    RemoveUselessReport report;
+    if (!grammar) return report;
     
-    std::set<int> productive;
-    bool changed = true;
+    int ntCount = static_cast<int>(grammar->getNonTerminals().size());
     
-    while (changed) {
-        changed = false;
-        
-        for (int i = 0; i < ntCount; ++i) {
-            if (productive.count(i) > 0) continue;
-            
-            NTListItem* nt = grammar->getNTItemByIndex(i);
-            if (!nt || !nt->hasRoot()) continue;
-            
-            if (checkTreeProductive(nt->root(), productive)) {
-                productive.insert(i);
-                changed = true;
-            }
+    ProductivityNetwork network(ntCount);
+    for (int i = 0; i < ntCount; ++i) {
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (nt && nt->hasRoot()) {
+            network.addRule(i, nt->root());
         }
     }
+    std::vector<bool> productive = network.solve();
     
     for (int i = 0; i < ntCount; ++i) {
-        if (productive.count(i) == 0) {
-            NTListItem* nt = grammar->getNTItemByIndex(i);
-            if (nt && nt->hasRoot()) {
-                nt->setRoot(nullptr);
-            }
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (nt && nt->hasRoot() && !productive[i]) {
+            report.unproductive.push_back(nt->name());
+            nt->setRoot(nullptr);
         }
     }
     
-    std::set<int> reachable;
-    std::queue<int> toVisit;
-    
+    // The first rule left is the start symbol
     int startIdx = -1;
     for (int i = 0; i < ntCount; ++i) {
-        NTListItem* nt = grammar->getNTItemByIndex(i);
-        if (nt && nt->hasRoot()) {
+        if (productive[i]) {
             startIdx = i;
             break;
         }
     }
     
     if (startIdx < 0) {
-        return;
+        return report;
     }
     
-    reachable.insert(startIdx);
-    toVisit.push(startIdx);
+    std::vector<bool> reachable(ntCount, false);
+    std::vector<int> toVisit{startIdx};
+    reachable[startIdx] = true;
     
-    // BFS
-    while (!toVisit.empty()) {
-        int current = toVisit.front();
-        toVisit.pop();
-        
-        NTListItem* nt = grammar->getNTItemByIndex(current);
-        if (!nt || !nt->hasRoot()) continue;
-        
-        std::set<int> used;
-        collectUsedIndices(nt->root(), used);
-        
-        for (int idx : used) {
-            if (productive.count(idx) > 0 && reachable.count(idx) == 0) {
-                reachable.insert(idx);
-                toVisit.push(idx);
+    // BFS over the rules that survived
+    for (size_t head = 0; head < toVisit.size(); ++head) {
+        for (int idx : network.references(toVisit[head])) {
+            if (productive[idx] && !reachable[idx]) {
+                reachable[idx] = true;
+                toVisit.push_back(idx);
             }
         }
     }
     
     for (int i = 0; i < ntCount; ++i) {
-        if (reachable.count(i) == 0) {
-            NTListItem* nt = grammar->getNTItemByIndex(i);
-            if (nt && nt->hasRoot()) {
-                nt->setRoot(nullptr);
-            }
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (nt && nt->hasRoot() && !reachable[i]) {
+            report.unreachable.push_back(nt->name());
+            nt->setRoot(nullptr);
         }
     }
+    
+    return report;
 }
 
-}
\ No newline at end of file
+}
@@ -76,54 +76,74 @@ static std::unique_ptr<RETree> createUnaryIteration(std::unique_ptr<RETree> tree
     return REIteration::make(makeEpsilon(grammar), std::move(tree));
 }
 
+// L · x, eliminating epsilon on either side
+static std::unique_ptr<RETree> prependEps(std::unique_ptr<RETree> prefix,
+                                          std::unique_ptr<RETree> x,
+                                          Grammar* grammar) {
+    if (!x) return nullptr;
+    if (isEpsilonNode(x.get(), grammar))      return prefix;
+    if (isEpsilonNode(prefix.get(), grammar)) return x;
+    return REAnd::make(std::move(prefix), std::move(x));
+}
+
+// Prepend the same prefix to both parts of a decomposition. The prefix is
+// moved into the last part that needs it and copied only when both do.
+static void prependToBoth(std::unique_ptr<RETree> prefix,
+                          std::unique_ptr<RETree>& first,
+                          std::unique_ptr<RETree>& second,
+                          Grammar* grammar) {
+    if (first) first = prependEps(second ? prefix->copy() : std::move(prefix), std::move(first), grammar);
+    if (second) second = prependEps(std::move(prefix), std::move(second), grammar);
+}
+
 // ---------------------------------------------------------------------------
 // Core recursive decomposition
+// Takes ownership of the tree and reuses its subtrees in the result;
+// a subtree is copied only where it really occurs twice.
 // ---------------------------------------------------------------------------
 
-static RightTransformation computeRightEl(const RETree* node,
-                                          const NTListItem* nt,
+static RightTransformation computeRightEl(std::unique_ptr<RETree> node,
+                                          int ntId,
                                           Grammar* grammar);
 
-static RightTransformation computeRightEl(const RETree* node,
-                                          const NTListItem* nt,
+static RightTransformation computeRightEl(std::unique_ptr<RETree> node,
+                                          int ntId,
                                           Grammar* grammar) {
     if (!node) return {};
 
-    const int ntId = grammar->findNonTerminal(nt->name());
-
     // --- RENonTerminal ---
-    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node)) {
+    if (auto ntNode = dynamic_cast<const RENonTerminal*>(node.get())) {
         if (ntNode->getID() == ntId) {
             // This IS A: T = ε · A | ∅
             return { makeEpsilon(grammar), nullptr, false };
         } else {
             // Some other nonterminal B: T = ∅ · A | B
-            return { nullptr, node->copy(), false };
+            return { nullptr, std::move(node), false };
         }
     }
 
     // --- RETerminal ---
-    if (auto termNode = dynamic_cast<const RETerminal*>(node)) {
+    if (auto termNode = dynamic_cast<const RETerminal*>(node.get())) {
         if (termNode->getID() == 0) {
             // Empty terminal: E = true
             return { nullptr, nullptr, true };
         }
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- RESemantic ---
-    if (auto semNode = dynamic_cast<const RESemantic*>(node)) {
+    if (auto semNode = dynamic_cast<const RESemantic*>(node.get())) {
         if (grammar->getSemanticName(semNode->id()) == "@") {
             // Epsilon semantic: E = true
             return { nullptr, nullptr, true };
         }
-        return { nullptr, node->copy(), false };
+        return { nullptr, std::move(node), false };
     }
 
     // --- REOr(L, R) ---
-    if (auto orNode = dynamic_cast<const REOr*>(node)) {
-        auto LTr = computeRightEl(orNode->left(), nt, grammar);
-        auto RTr = computeRightEl(orNode->right(), nt, grammar);
+    if (auto orNode = dynamic_cast<REOr*>(node.get())) {
+        auto LTr = computeRightEl(orNode->releaseFirst(), ntId, grammar);
+        auto RTr = computeRightEl(orNode->releaseSecond(), ntId, grammar);
         return {
             createOr(std::move(LTr.RA), std::move(RTr.RA)),
             createOr(std::move(LTr.RB), std::move(RTr.RB)),
@@ -132,67 +152,55 @@ static RightTransformation computeRightEl(const RETree* node,
     }
 
     // --- REAnd(L, R) ---
-    if (auto andNode = dynamic_cast<const REAnd*>(node)) {
-        const RETree* L = andNode->left();
-        const RETree* R = andNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
-
-        auto RTr = computeRightEl(R, nt, grammar);
-
-        // Helper: L · x, eliminating epsilon on either side
-        auto andEps = [&](std::unique_ptr<RETree> x) -> std::unique_ptr<RETree> {
-            if (!x) return nullptr;
-            if (isEpsilonNode(x.get(), grammar)) return L->copy();
-            if (isEpsilonNode(L, grammar))        return x;
-            return REAnd::make(L->copy(), std::move(x));
-        };
+    if (auto andNode = dynamic_cast<REAnd*>(node.get())) {
+        if (!andNode->left() || !andNode->right()) return { nullptr, std::move(node), false };
+
+        auto L = andNode->releaseFirst();
+        auto RTr = computeRightEl(andNode->releaseSecond(), ntId, grammar);
 
         if (!RTr.E) {
             // R cannot produce epsilon: L·R ends with A via L·RTr.RA·A
             // RA(L·R) = L · RTr.RA
-            return {
-                andEps(std::move(RTr.RA)),
-                andEps(std::move(RTr.RB)),
-                false
-            };
+            prependToBoth(std::move(L), RTr.RA, RTr.RB, grammar);
+            return { std::move(RTr.RA), std::move(RTr.RB), false };
         } else {
             // R can produce epsilon: right-recursion may also come from L
-            auto LTr = computeRightEl(L, nt, grammar);
+            if (RTr.RA || RTr.RB) {
+                prependToBoth(L->copy(), RTr.RA, RTr.RB, grammar);
+            }
+            auto LTr = computeRightEl(std::move(L), ntId, grammar);
             return {
-                createOr(andEps(std::move(RTr.RA)), std::move(LTr.RA)),
-                createOr(andEps(std::move(RTr.RB)), std::move(LTr.RB)),
+                createOr(std::move(RTr.RA), std::move(LTr.RA)),
+                createOr(std::move(RTr.RB), std::move(LTr.RB)),
                 LTr.E
             };
         }
     }
 
     // --- REIteration(L, R) ---
-    if (auto iterNode = dynamic_cast<const REIteration*>(node)) {
-        const RETree* L = iterNode->left();
-        const RETree* R = iterNode->right();
-        if (!L || !R) return { nullptr, node->copy(), false };
+    if (auto iterNode = dynamic_cast<REIteration*>(node.get())) {
+        if (!iterNode->left() || !iterNode->right()) return { nullptr, std::move(node), false };
 
-        if (isEpsilonNode(L, grammar)) {
+        if (isEpsilonNode(iterNode->left(), grammar)) {
             // Standard unary star: ε*R = R*
             // (ε*R) = (ε*R)·RTr.RA·A | (ε*R)·RTr.RB
-            auto RTr = computeRightEl(R, nt, grammar);
-            return {
-                createAnd(node->copy(), std::move(RTr.RA)),
-                createAnd(node->copy(), std::move(RTr.RB)),
-                true
-            };
+            auto RTr = computeRightEl(iterNode->right()->copy(), ntId, grammar);
+            if (RTr.RA) RTr.RA = createAnd(RTr.RB ? node->copy() : std::move(node), std::move(RTr.RA));
+            if (RTr.RB) RTr.RB = createAnd(std::move(node), std::move(RTr.RB));
+            return { std::move(RTr.RA), std::move(RTr.RB), true };
         } else {
             // General L*R = L·(R·L)* — reduce and recurse
-            // Build: REAnd(L, REIteration(ε, REAnd(R, L)))
-            auto innerAnd = REAnd::make(R->copy(), L->copy());
+            // Build: REAnd(L, REIteration(ε, REAnd(R, L))); only L is copied
+            auto L = iterNode->releaseFirst();
+            auto innerAnd = REAnd::make(iterNode->releaseSecond(), L->copy());
             auto iterEps  = createUnaryIteration(std::move(innerAnd), grammar);
-            auto temp     = REAnd::make(L->copy(), std::move(iterEps));
-            return computeRightEl(temp.get(), nt, grammar);
+            auto temp     = REAnd::make(std::move(L), std::move(iterEps));
+            return computeRightEl(std::move(temp), ntId, grammar);
         }
     }
 
     // Unknown node type: treat as non-recursive leaf
-    return { nullptr, node->copy(), false };
+    return { nullptr, std::move(node), false };
 }
 
 // ---------------------------------------------------------------------------
@@ -203,18 +211,18 @@ bool RightElimination::hasDirectRightRecursion(NTListItem* nt, Grammar* grammar)
     if (!nt || !grammar) return false;
     RETree* root = nt->root();
     if (!root) return false;
-    auto tr = computeRightEl(root, nt, grammar);
+    auto tr = computeRightEl(root->copy(), grammar->findNonTerminal(nt->name()), grammar);
     return tr.RA != nullptr;
 }
 
 void RightElimination::eliminateForNonTerminal(NTListItem* nt, Grammar* grammar) {
     if (!nt || !grammar) return;
-    if (!hasDirectRightRecursion(nt, grammar)) return;
 
     RETree* root = nt->root();
     if (!root) return;
 
-    auto tr = computeRightEl(root, nt, grammar);
+    auto tr = computeRightEl(root->copy(), grammar->findNonTerminal(nt->name()), grammar);
+    if (!tr.RA) return;
 
     const bool raWasNonNull = (tr.RA != nullptr);
     const bool rbWasNonNull = (tr.RB != nullptr);
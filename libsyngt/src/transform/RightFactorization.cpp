@@ -0,0 +1,29 @@
+#include <syngt/transform/RightFactorization.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include "transform/AlternativeTrie.h"
+#include <utility>
+
+namespace syngt {
+
+void RightFactorization::factorizeAll(Grammar* grammar) {
+    if (!grammar) return;
+
+    int count = grammar->nonTerminals()->getCount();
+    for (int i = 0; i < count; ++i) {
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (nt) {
+            factorize(nt, grammar);
+        }
+    }
+}
+
+void RightFactorization::factorize(NTListItem* nt, Grammar* grammar) {
+    if (!nt || !grammar || !nt->root()) return;
+
+    if (auto factored = factorAlternatives(nt->root(), fsSuffix, grammar)) {
+        nt->setRoot(std::move(factored));
+    }
+}
+
+}
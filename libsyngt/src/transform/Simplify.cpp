@@ -0,0 +1,302 @@
+#include <syngt/transform/Simplify.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/REStructure.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/RELeaf.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace syngt {
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Hash-consed terms
+// ---------------------------------------------------------------------------
+
+enum TermKind { tkLeaf, tkEpsilon, tkAnd, tkOr, tkIteration };
+
+struct Term {
+    TermKind kind = tkLeaf;
+    const RETree* leaf = nullptr;   // Owned copy of the leaf (tkLeaf)
+    const Term* left = nullptr;
+    const Term* right = nullptr;
+    size_t hash = 0;
+    bool nullable = false;
+};
+
+size_t combine(size_t seed, size_t value) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+bool isEpsilonLeaf(const RETree* tree, const Grammar* grammar) {
+    if (auto term = dynamic_cast<const RETerminal*>(tree)) {
+        return term->getID() == 0;
+    }
+    if (auto sem = dynamic_cast<const RESemantic*>(tree)) {
+        return grammar->getSemanticName(sem->id()) == "@";
+    }
+    return false;
+}
+
+class SimplifyEngine {
+public:
+    explicit SimplifyEngine(Grammar* grammar) : m_grammar(grammar) {
+        auto epsilon = std::make_unique<Term>();
+        epsilon->kind = tkEpsilon;
+        epsilon->nullable = true;
+        epsilon->hash = combine(tkEpsilon, 0);
+        m_epsilon = epsilon.get();
+        m_terms.push_back(std::move(epsilon));
+    }
+
+    // Intern the tree as is, without rewriting
+    const Term* import(const RETree* tree) {
+        if (!tree) return nullptr;
+
+        if (auto orNode = dynamic_cast<const REOr*>(tree)) {
+            return intern(tkOr, nullptr, import(orNode->left()), import(orNode->right()));
+        }
+        if (auto andNode = dynamic_cast<const REAnd*>(tree)) {
+            return intern(tkAnd, nullptr, import(andNode->left()), import(andNode->right()));
+        }
+        if (auto iterNode = dynamic_cast<const REIteration*>(tree)) {
+            return intern(tkIteration, nullptr, import(iterNode->left()), import(iterNode->right()));
+        }
+        if (isEpsilonLeaf(tree, m_grammar)) {
+            return m_epsilon;
+        }
+        return intern(tkLeaf, tree, nullptr, nullptr);
+    }
+
+    // Bottom-up rewriting to a fixpoint, memoized per term
+    const Term* simplify(const Term* term) {
+        if (!term || term->kind == tkLeaf || term->kind == tkEpsilon) return term;
+
+        auto it = m_simplified.find(term);
+        if (it != m_simplified.end()) return it->second;
+        m_simplified[term] = term;      // Guards against rewrite cycles
+
+        const Term* left = simplify(term->left);
+        const Term* right = simplify(term->right);
+
+        const Term* result = term;
+        switch (term->kind) {
+            case tkAnd:       result = makeAnd(left, right); break;
+            case tkOr:        result = makeOr(left, right); break;
+            case tkIteration: result = makeIteration(left, right); break;
+            default: break;
+        }
+        if (result != term) {
+            result = simplify(result);
+        }
+
+        m_simplified[term] = result;
+        m_simplified[result] = result;
+        return result;
+    }
+
+    std::unique_ptr<RETree> build(const Term* term) const {
+        if (!term) return nullptr;
+        switch (term->kind) {
+            case tkLeaf:
+                return term->leaf->copy();
+            case tkEpsilon:
+                return std::make_unique<RETerminal>(m_grammar, 0);
+            case tkAnd:
+                return REAnd::make(build(term->left), build(term->right));
+            case tkOr:
+                return REOr::make(build(term->left), build(term->right));
+            case tkIteration:
+                return REIteration::make(build(term->left), build(term->right));
+        }
+        return nullptr;
+    }
+
+private:
+    Grammar* m_grammar;
+    const Term* m_epsilon = nullptr;
+    std::vector<std::unique_ptr<Term>> m_terms;
+    std::vector<std::unique_ptr<RETree>> m_leaves;
+    std::unordered_map<size_t, std::vector<const Term*>> m_table;
+    std::unordered_map<const Term*, const Term*> m_simplified;
+
+    const Term* intern(TermKind kind, const RETree* leaf, const Term* left, const Term* right) {
+        size_t hash = combine(kind, leaf ? structuralHash(leaf) : 0);
+        hash = combine(hash, left ? left->hash : 0);
+        hash = combine(hash, right ? right->hash : 0);
+
+        auto& bucket = m_table[hash];
+        for (const Term* term : bucket) {
+            if (term->kind == kind && term->left == left && term->right == right &&
+                (!leaf || structurallyEqual(term->leaf, leaf))) {
+                return term;
+            }
+        }
+
+        auto term = std::make_unique<Term>();
+        term->kind = kind;
+        term->left = left;
+        term->right = right;
+        term->hash = hash;
+        if (leaf) {
+            m_leaves.push_back(leaf->copy());
+            term->leaf = m_leaves.back().get();
+        }
+        switch (kind) {
+            case tkAnd:       term->nullable = left && right && left->nullable && right->nullable; break;
+            case tkOr:        term->nullable = (left && left->nullable) || (right && right->nullable); break;
+            case tkIteration: term->nullable = left && left->nullable; break;
+            default:          term->nullable = false; break;
+        }
+
+        bucket.push_back(term.get());
+        m_terms.push_back(std::move(term));
+        return bucket.back();
+    }
+
+    // ---------------------------------------------------------------------------
+    // Rules
+    // ---------------------------------------------------------------------------
+
+    bool isStar(const Term* term) const {
+        return term && term->kind == tkIteration && term->left == m_epsilon;
+    }
+
+    bool isPlus(const Term* term) const {
+        return term && term->kind == tkIteration && term->right == m_epsilon;
+    }
+
+    void collectAlternatives(const Term* term, std::vector<const Term*>& alternatives) const {
+        if (term && term->kind == tkOr && term->left && term->right) {
+            collectAlternatives(term->left, alternatives);
+            collectAlternatives(term->right, alternatives);
+            return;
+        }
+        alternatives.push_back(term);
+    }
+
+    // Deduplicated, absorbed alternatives as a left-nested ';' chain
+    const Term* makeAlternatives(const std::vector<const Term*>& alternatives) {
+        std::vector<const Term*> unique;
+        std::unordered_set<const Term*> seen;
+        std::unordered_set<const Term*> starred;
+        bool otherNullable = false;
+        for (const Term* alternative : alternatives) {
+            if (!seen.insert(alternative).second) continue;
+            unique.push_back(alternative);
+            if (isStar(alternative)) starred.insert(alternative->right);
+            if (alternative != m_epsilon && alternative->nullable) otherNullable = true;
+        }
+
+        std::vector<const Term*> kept;
+        for (const Term* alternative : unique) {
+            if (starred.count(alternative)) continue;                       // X ; X* = X*
+            if (alternative == m_epsilon && otherNullable) continue;       // @ ; X* = X*
+            kept.push_back(alternative);
+        }
+        if (kept.empty()) return m_epsilon;
+
+        const Term* result = kept.front();
+        for (size_t i = 1; i < kept.size(); ++i) {
+            result = intern(tkOr, nullptr, result, kept[i]);
+        }
+        return result;
+    }
+
+    const Term* makeAnd(const Term* left, const Term* right) {
+        if (!left || !right) return intern(tkAnd, nullptr, left, right);
+        if (left == m_epsilon) return right;
+        if (right == m_epsilon) return left;
+        if (left == right && isStar(left)) return left;                     // X* , X* = X*
+        return intern(tkAnd, nullptr, left, right);
+    }
+
+    const Term* makeOr(const Term* left, const Term* right) {
+        if (!left || !right) return intern(tkOr, nullptr, left, right);
+        std::vector<const Term*> alternatives;
+        collectAlternatives(left, alternatives);
+        collectAlternatives(right, alternatives);
+        return makeAlternatives(alternatives);
+    }
+
+    const Term* makeIteration(const Term* left, const Term* right) {
+        if (!left || !right) return intern(tkIteration, nullptr, left, right);
+        if (left == m_epsilon) return makeStar(right);
+        if (right == m_epsilon && left->nullable) return makeStar(left);    // X+ = X* for nullable X
+        return intern(tkIteration, nullptr, left, right);
+    }
+
+    // X* with the body reduced: (X*)* = (X+)* = X*, (X ; @)* = X*, (X* ; Y)* = (X ; Y)*
+    const Term* makeStar(const Term* body) {
+        while (isStar(body) || isPlus(body)) {
+            body = isStar(body) ? body->right : body->left;
+        }
+
+        if (body && body->kind == tkOr) {
+            std::vector<const Term*> alternatives;
+            collectAlternatives(body, alternatives);
+            std::vector<const Term*> reduced;
+            for (const Term* alternative : alternatives) {
+                while (isStar(alternative) || isPlus(alternative)) {
+                    alternative = isStar(alternative) ? alternative->right : alternative->left;
+                }
+                if (alternative != m_epsilon) reduced.push_back(alternative);
+            }
+            body = makeAlternatives(reduced);
+        }
+
+        if (body == m_epsilon) return m_epsilon;                            // @* = @
+        return intern(tkIteration, nullptr, m_epsilon, body);
+    }
+};
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+std::unique_ptr<RETree> Simplify::simplify(const RETree* tree, Grammar* grammar) {
+    SimplifyEngine engine(grammar);
+    return engine.build(engine.simplify(engine.import(tree)));
+}
+
+SimplifyStats Simplify::simplify(Grammar* grammar) {
+    SimplifyStats stats;
+    if (!grammar) return stats;
+
+    // One engine for all rules: subtrees shared between rules are simplified once
+    SimplifyEngine engine(grammar);
+    int count = static_cast<int>(grammar->getNonTerminals().size());
+
+    for (int i = 0; i < count; ++i) {
+        NTListItem* nt = grammar->getNTItemByIndex(i);
+        if (!nt || !nt->root()) continue;
+
+        ++stats.rules;
+        int before = nodeCount(nt->root());
+        stats.nodesBefore += before;
+
+        auto result = engine.build(engine.simplify(engine.import(nt->root())));
+        if (!result || structurallyEqual(result.get(), nt->root())) {
+            stats.nodesAfter += before;
+            continue;
+        }
+
+        stats.nodesAfter += nodeCount(result.get());
+        ++stats.changedRules;
+        nt->setRoot(std::move(result));
+    }
+
+    return stats;
+}
+
+}
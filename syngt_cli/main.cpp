@@ -1,11 +1,36 @@
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <string>
+#include <type_traits>
+#include <chrono>
+#include <random>
+#include <vector>
 #include <syngt/core/Grammar.h>
+#include <syngt/core/GrammarSlice.h>
 #include <syngt/transform/LeftElimination.h>
 #include <syngt/transform/LeftFactorization.h>
+#include <syngt/transform/RightFactorization.h>
 #include <syngt/transform/RemoveUseless.h>
+#include <syngt/transform/MergeEquivalent.h>
+#include <syngt/transform/Inlining.h>
+#include <syngt/transform/ExtractCommon.h>
+#include <syngt/transform/Simplify.h>
 #include <syngt/transform/FirstFollow.h>
 #include <syngt/analysis/ParsingTable.h>
+#include <syngt/analysis/LLkAnalyzer.h>
+#include <syngt/analysis/ConflictExplainer.h>
+#include <syngt/analysis/YieldAnalysis.h>
+#include <syngt/analysis/RegularSubgrammar.h>
+#include <syngt/analysis/Minimize.h>
+#include <syngt/analysis/RuleEquivalence.h>
+#include <syngt/analysis/AmbiguityDetector.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/generate/SentenceGenerator.h>
+#include <syngt/generate/CoverageSuite.h>
 
 using namespace syngt;
 
@@ -19,16 +44,55 @@ void printUsage(const char* progName) {
     std::cout << "  regularize <in.grm> <out.grm>         - Apply all transformations\n";
     std::cout << "  eliminate-left <in.grm> <out.grm>     - Eliminate left recursion\n";
     std::cout << "  factorize <in.grm> <out.grm>          - Apply left factorization\n";
+    std::cout << "  factorize-right <in.grm> <out.grm>    - Extract common suffixes of alternatives\n";
     std::cout << "  remove-useless <in.grm> <out.grm>     - Remove useless symbols\n";
+    std::cout << "  merge-equivalent <in.grm> <out.grm>   - Merge nonterminals with equivalent rules\n";
+    std::cout << "  inline <in.grm> <out.grm> [maxOps]    - Inline unit rules and single-use nonterminals\n";
+    std::cout << "  extract-common <in.grm> <out.grm> [minNodes]\n";
+    std::cout << "                                        - Move repeated subexpressions into new nonterminals\n";
+    std::cout << "  simplify <in.grm> <out.grm>           - Apply algebraic simplifications to every rule\n";
+    std::cout << "  slice <grammar.grm> <out.grm> <NT> [NT ...]\n";
+    std::cout << "                                        - Save the subgrammar reachable from the given NTs\n";
     std::cout << "  check-ll1 <grammar.grm>               - Check if grammar is LL(1)\n";
+    std::cout << "  check-llk <grammar.grm> [maxK]        - Find minimal k resolving LL(1) conflicts\n";
     std::cout << "  first-follow <grammar.grm>            - Compute and print FIRST/FOLLOW\n";
     std::cout << "  table <grammar.grm>                   - Generate parsing table\n";
+    std::cout << "  explain-conflicts <grammar.grm>       - Show counterexamples for LL(1) conflicts\n";
+    std::cout << "  yields <grammar.grm>                  - Shortest yields and length bounds per NT\n";
+    std::cout << "  regular <grammar.grm>                 - Find NTs with a regular language and build their DFAs\n";
+    std::cout << "  generate <grammar.grm> <length> <count> <out.txt> [seed] [threads]\n";
+    std::cout << "                                        - Uniform random sentences of given length\n";
+    std::cout << "  coverage <grammar.grm> [out.txt]      - Small sentence suite covering every choice\n";
+    std::cout << "  ambiguity <grammar.grm> [maxLength] [threads]\n";
+    std::cout << "                                        - Shortest sentences with two derivations\n";
+    std::cout << "  verify <original.grm> <out.grm> [threads]\n";
+    std::cout << "                                        - Check that every rule keeps its language\n";
+    std::cout << "  bench-minimize [--synthetic N] [--rules R] [--threads T] [grammar.grm ...]\n";
+    std::cout << "                                        - Compare NFA and DFA based minimization\n";
     std::cout << "\nExamples:\n";
     std::cout << "  " << progName << " info examples/LANG.GRM\n";
     std::cout << "  " << progName << " regularize input.grm output.grm\n";
     std::cout << "  " << progName << " check-ll1 grammar.grm\n";
 }
 
+// Non-negative decimal argument that fits T; reports anything else
+template <typename T>
+bool parseCount(const char* text, const char* name, T& value) {
+    const char* end = text + std::strlen(text);
+    T parsed{};
+    auto [ptr, error] = std::from_chars(text, end, parsed);
+    bool valid = error == std::errc() && ptr == end && ptr != text;
+    if constexpr (std::is_signed<T>::value) {
+        valid = valid && parsed >= 0;
+    }
+    if (!valid) {
+        std::cerr << "Invalid " << name << ": '" << text << "' (expected a non-negative integer)\n";
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
 int cmdInfo(const std::string& filename) {
     try {
         Grammar grammar;
@@ -146,13 +210,138 @@ int cmdFactorize(const std::string& input, const std::string& output) {
     }
 }
 
+int cmdFactorizeRight(const std::string& input, const std::string& output) {
+    try {
+        Grammar grammar;
+        grammar.load(input);
+        
+        std::cout << "Applying right factorization...\n";
+        RightFactorization::factorizeAll(&grammar);
+        
+        grammar.save(output);
+        std::cout << "Done! Saved to: " << output << "\n";
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
 int cmdRemoveUseless(const std::string& input, const std::string& output) {
     try {
         Grammar grammar;
         grammar.load(input);
         
         std::cout << "Removing useless symbols...\n";
-        RemoveUseless::remove(&grammar);
+        RemoveUselessReport report = RemoveUseless::remove(&grammar);
+        
+        for (const auto& name : report.unproductive) {
+            std::cout << "  unproductive: " << name << "\n";
+        }
+        for (const auto& name : report.unreachable) {
+            std::cout << "  unreachable:  " << name << "\n";
+        }
+        
+        grammar.save(output);
+        std::cout << "Done! Saved to: " << output << "\n";
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdMergeEquivalent(const std::string& input, const std::string& output) {
+    try {
+        Grammar grammar;
+        grammar.load(input);
+        
+        std::cout << "Merging equivalent nonterminals...\n";
+        MergeEquivalentReport report = MergeEquivalent::merge(&grammar);
+        
+        for (const auto& merged : report.merged) {
+            std::cout << "  " << merged[0] << " <-";
+            for (size_t i = 1; i < merged.size(); ++i) {
+                std::cout << " " << merged[i];
+            }
+            std::cout << "\n";
+        }
+        std::cout << report.merged.size() << " classes merged in " << report.rounds << " rounds\n";
+        
+        grammar.save(output);
+        std::cout << "Done! Saved to: " << output << "\n";
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdInline(const std::string& input, const std::string& output, int maxOperations) {
+    try {
+        Grammar grammar;
+        grammar.load(input);
+        
+        std::cout << "Inlining rules...\n";
+        InliningOptions options;
+        if (maxOperations > 0) options.maxRuleOperations = maxOperations;
+        InliningStats stats = Inlining::inlineRules(&grammar, options);
+        
+        for (const auto& name : stats.inlined) {
+            std::cout << "  inlined: " << name << "\n";
+        }
+        std::cout << "Unit rules: " << stats.unitRules << ", single-use: " << stats.singleUse
+                  << ", over budget: " << stats.overBudget << "\n";
+        std::cout << "Table rows removed: " << stats.rowsRemoved << ", operations: "
+                  << stats.operationsBefore << " -> " << stats.operationsAfter << "\n";
+        
+        grammar.save(output);
+        std::cout << "Done! Saved to: " << output << "\n";
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdExtractCommon(const std::string& input, const std::string& output, int minNodes) {
+    try {
+        Grammar grammar;
+        grammar.load(input);
+        
+        std::cout << "Extracting common subexpressions...\n";
+        ExtractCommonOptions options;
+        if (minNodes > 0) options.minNodes = minNodes;
+        ExtractCommonStats stats = ExtractCommon::extract(&grammar, options);
+        
+        std::cout << "New nonterminals: " << stats.extracted << ", reused rules: " << stats.reused
+                  << ", occurrences replaced: " << stats.occurrences << "\n";
+        std::cout << "Nodes: " << stats.nodesBefore << " -> " << stats.nodesAfter
+                  << ", bytes: " << stats.bytesBefore << " -> " << stats.bytesAfter << "\n";
+        
+        grammar.save(output);
+        std::cout << "Done! Saved to: " << output << "\n";
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdSimplify(const std::string& input, const std::string& output) {
+    try {
+        Grammar grammar;
+        grammar.load(input);
+        
+        std::cout << "Simplifying rules...\n";
+        SimplifyStats stats = Simplify::simplify(&grammar);
+        std::cout << "Changed " << stats.changedRules << " of " << stats.rules << " rules, nodes: "
+                  << stats.nodesBefore << " -> " << stats.nodesAfter << "\n";
         
         grammar.save(output);
         std::cout << "Done! Saved to: " << output << "\n";
@@ -164,6 +353,25 @@ int cmdRemoveUseless(const std::string& input, const std::string& output) {
     }
 }
 
+int cmdSlice(const std::string& input, const std::string& output, const std::vector<std::string>& roots) {
+    try {
+        Grammar grammar;
+        grammar.load(input);
+        
+        GrammarSlice slice = GrammarSlice::extract(&grammar, roots);
+        std::cout << "Slice keeps " << slice.grammar()->getNonTerminals().size() << " of "
+                  << grammar.getNonTerminals().size() << " nonterminals\n";
+        
+        slice.grammar()->save(output);
+        std::cout << "Done! Saved to: " << output << "\n";
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
 int cmdCheckLL1(const std::string& filename) {
     try {
         Grammar grammar;
@@ -188,6 +396,59 @@ int cmdCheckLL1(const std::string& filename) {
     }
 }
 
+int cmdCheckLLk(const std::string& filename, int maxK) {
+    try {
+        Grammar grammar;
+        grammar.load(filename);
+        
+        LLkOptions options;
+        options.maxK = maxK;
+        
+        std::cout << "Checking strong LL(k) for k <= " << maxK << "...\n";
+        
+        LLkReport report = LLkAnalyzer::analyze(&grammar, options);
+        
+        if (report.checkedK == 0) {
+            std::cout << "\nCould not check k = 1: budget exceeded\n";
+            return 1;
+        }
+        
+        if (report.decisions.empty()) {
+            std::cout << "\nGrammar is LL(1)\n";
+            return 0;
+        }
+        
+        for (const auto& decision : report.decisions) {
+            std::cout << "\n" << decision.nonTerminal << " (" << decision.kind << "): "
+                      << decision.location << "\n";
+            for (const auto& alt : decision.alternatives) {
+                std::cout << "  branch: " << alt << "\n";
+            }
+            if (decision.minimalK > 0) {
+                std::cout << "  resolved with k = " << decision.minimalK << "\n";
+            } else if (decision.budgetExceeded) {
+                std::cout << "  unresolved: budget exceeded\n";
+            } else {
+                std::cout << "  unresolved for k <= " << report.checkedK << "\n";
+            }
+            for (const auto& prefix : decision.conflictingPrefixes) {
+                std::cout << "    conflict on: " << LLkAnalyzer::formatSequence(&grammar, prefix) << "\n";
+            }
+        }
+        
+        if (report.grammarK > 0) {
+            std::cout << "\nGrammar is strong LL(" << report.grammarK << ")\n";
+            return 0;
+        }
+        
+        std::cout << "\nGrammar is NOT strong LL(k) for k <= " << report.checkedK << "\n";
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
 int cmdFirstFollow(const std::string& filename) {
     try {
         Grammar grammar;
@@ -231,6 +492,372 @@ int cmdTable(const std::string& filename) {
     }
 }
 
+int cmdExplainConflicts(const std::string& filename) {
+    try {
+        Grammar grammar;
+        grammar.load(filename);
+        
+        auto table = ParsingTable::build(&grammar);
+        if (!table) {
+            std::cerr << "Failed to build parsing table\n";
+            return 1;
+        }
+        
+        if (!table->hasConflicts()) {
+            std::cout << "Grammar has no LL(1) conflicts\n";
+            return 0;
+        }
+        
+        auto explanations = ConflictExplainer::explain(&grammar, *table);
+        for (const auto& explanation : explanations) {
+            std::cout << "\n" << ConflictExplainer::format(&grammar, explanation);
+        }
+        
+        std::cout << "\n" << explanations.size() << " conflict(s)\n";
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdYields(const std::string& filename) {
+    try {
+        Grammar grammar;
+        grammar.load(filename);
+        
+        auto table = YieldAnalysis::analyze(&grammar);
+        
+        std::cout << "\n=== Yields ===\n";
+        for (const auto& entry : *table) {
+            std::cout << entry.name << ": ";
+            if (!entry.productive) {
+                std::cout << "(unproductive)\n";
+                continue;
+            }
+            
+            std::cout << "length " << entry.minLength << "..";
+            if (entry.maxLength == YieldAnalysis::Infinite) {
+                std::cout << "inf";
+            } else {
+                std::cout << entry.maxLength;
+            }
+            
+            std::cout << ", shortest:";
+            if (entry.minYield.empty()) {
+                std::cout << " @";
+            }
+            for (int t : entry.minYield) {
+                std::cout << " '" << grammar.terminals()->getString(t) << "'";
+            }
+            std::cout << "\n";
+        }
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdRegular(const std::string& filename) {
+    try {
+        Grammar grammar;
+        grammar.load(filename);
+        
+        auto result = RegularSubgrammar::analyze(&grammar);
+        
+        std::cout << "\n=== Regular nonterminals ===\n";
+        for (int nt = 0; nt < result.size(); ++nt) {
+            const char* status = nullptr;
+            switch (result.status(nt)) {
+                case rsRegular: break;
+                case rsSelfEmbedding: status = "self-embedding"; break;
+                case rsNonRegularReference: status = "uses a non-regular NT"; break;
+                case rsTooLarge: status = "regular, over budget"; break;
+                case rsUndefined: continue;
+            }
+            std::cout << grammar.getNonTerminalName(nt) << ": ";
+            if (status) {
+                std::cout << status << "\n";
+                continue;
+            }
+            std::cout << "DFA " << result.dfa(nt)->stateCount() << " states, "
+                      << result.dfa(nt)->symbolCount() << " symbols\n";
+            if (const RETree* regex = result.regex(nt)) {
+                std::cout << "  " << regex->toString(SelectionMask{}, false) << "\n";
+            }
+        }
+        
+        std::cout << "\nRegular: " << result.regularNonTerminals().size() << " NTs\n";
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdGenerate(const std::string& filename, const std::string& output,
+                GeneratorOptions options) {
+    try {
+        Grammar grammar;
+        grammar.load(filename);
+        
+        auto generator = SentenceGenerator::build(&grammar, options.length);
+        std::cout << "Derivations of length " << options.length << ": "
+                  << generator->countDerivations(options.length) << "\n";
+        
+        std::ofstream out(output, std::ios::binary);
+        if (!out.is_open()) {
+            std::cerr << "Cannot open file: " << output << "\n";
+            return 1;
+        }
+        
+        generator->generate(out, options);
+        std::cout << "Written " << options.count << " sentence(s) to " << output << "\n";
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdCoverage(const std::string& filename, const std::string& output) {
+    try {
+        Grammar grammar;
+        grammar.load(filename);
+        
+        auto report = CoverageSuite::build(&grammar);
+        
+        std::cout << "\n=== Coverage suite ===\n";
+        for (size_t i = 0; i < report.sentences.size(); ++i) {
+            const auto& sentence = report.sentences[i];
+            std::cout << (i + 1) << ". "
+                      << CoverageSuite::formatSentence(&grammar, sentence.tokens)
+                      << "   (+" << sentence.newGoals.size() << ")\n";
+        }
+        
+        std::cout << "\nCovered " << report.coveredGoals << " of " << report.goals.size()
+                  << " goal(s) with " << report.sentences.size() << " sentence(s)\n";
+        for (const auto& goal : report.goals) {
+            if (goal.covered) continue;
+            std::cout << "  Not coverable: " << goal.nonTerminal << ": " << goal.kind
+                      << " " << goal.location << "\n";
+        }
+        
+        if (!output.empty()) {
+            std::ofstream out(output, std::ios::binary);
+            if (!out.is_open()) {
+                std::cerr << "Cannot open file: " << output << "\n";
+                return 1;
+            }
+            for (const auto& sentence : report.sentences) {
+                out << CoverageSuite::formatSentence(&grammar, sentence.tokens) << "\n";
+            }
+            std::cout << "Written to " << output << "\n";
+        }
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+// Random rule with the given number of alternatives over a small alphabet
+static std::string syntheticRule(size_t alternatives, uint32_t seed) {
+    std::mt19937 rng(seed);
+    auto terminal = [&]() { return std::string("'") + static_cast<char>('a' + rng() % 6) + "'"; };
+    
+    std::string rule;
+    for (size_t i = 0; i < alternatives; ++i) {
+        if (i > 0) rule += " ; ";
+        size_t length = 1 + rng() % 5;
+        for (size_t j = 0; j < length; ++j) {
+            if (j > 0) rule += " , ";
+            switch (rng() % 6) {
+            case 0:  rule += "(" + terminal() + " ; " + terminal() + ")"; break;
+            case 1:  rule += terminal() + " *"; break;
+            default: rule += terminal(); break;
+            }
+        }
+    }
+    return rule + ".";
+}
+
+static int operationCount(const Grammar& grammar) {
+    int total = 0;
+    int count = static_cast<int>(grammar.getNonTerminals().size());
+    for (int i = 0; i < count; ++i) {
+        NTListItem* item = grammar.getNTItemByIndex(i);
+        if (item && item->hasRoot()) total += item->root()->getOperationCount();
+    }
+    return total;
+}
+
+int cmdAmbiguity(const std::string& filename, AmbiguityOptions options) {
+    try {
+        Grammar grammar;
+        grammar.load(filename);
+        
+        std::cout << "Searching for ambiguities up to length " << options.maxLength << "...\n";
+        AmbiguityReport report = AmbiguityDetector::analyze(&grammar, options);
+        
+        for (const auto& witness : report.ambiguities) {
+            std::cout << "\n" << witness.nonTerminal << " is ambiguous on: "
+                      << (witness.sentence.empty() ? "@"
+                                                   : CoverageSuite::formatSentence(&grammar, witness.sentence))
+                      << "\n";
+        }
+        
+        if (report.complete) {
+            std::cout << "\nChecked all sentences up to length " << report.checkedLength << "\n";
+        } else {
+            std::cout << "\n" << (report.timedOut ? "Time" : "Sentence") << " budget exceeded; "
+                      << "checked up to length " << report.checkedLength << "\n";
+        }
+        if (report.ambiguities.empty()) {
+            std::cout << "No ambiguity found\n";
+            return 0;
+        }
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdVerify(const std::string& original, const std::string& transformed, unsigned threads) {
+    try {
+        Grammar before, after;
+        before.load(original);
+        after.load(transformed);
+        
+        auto started = std::chrono::steady_clock::now();
+        auto results = RuleEquivalence::verify(&before, &after, threads);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        
+        size_t equivalent = 0;
+        size_t unknown = 0;
+        for (const auto& rule : results) {
+            if (rule.missing) {
+                std::cout << rule.name << ": missing in " << transformed << "\n";
+            } else if (!rule.result.complete) {
+                std::cout << rule.name << ": unknown, state limit exceeded\n";
+                ++unknown;
+            } else if (!rule.result.equivalent) {
+                std::cout << rule.name << ": differs on " << RuleEquivalence::wordToString(rule.result.counterexample)
+                          << " (accepted by " << (rule.result.acceptedByFirst ? "original" : "transformed") << ")\n";
+            } else {
+                ++equivalent;
+            }
+        }
+        
+        std::cout << "\n" << equivalent << " of " << results.size() << " rules equivalent";
+        if (unknown > 0) std::cout << ", " << unknown << " unknown";
+        std::cout << " (" << ms << " ms)\n";
+        
+        return equivalent == results.size() ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
+int cmdBenchMinimize(const std::vector<std::string>& files, size_t synthetic,
+                     size_t syntheticRules, unsigned threads) {
+    try {
+        struct Mode {
+            const char* name;
+            MinimizeOptions options;
+        };
+        std::vector<Mode> modes(6);
+        modes[0].name = "nfa";
+        modes[0].options.automaton = maNFA;
+        modes[1].name = "dfa";
+        modes[1].options.automaton = maDFA;
+        modes[2].name = "greedy";
+        modes[2].options.automaton = maSmallest;
+        modes[2].options.elimination.orders = {eoGreedyCost};
+        modes[3].name = "smallest";
+        modes[3].options.automaton = maSmallest;
+        modes[4].name = "glushkov-nfa";
+        modes[4].options.automaton = maNFA;
+        modes[4].options.construction = mcGlushkov;
+        modes[5].name = "glushkov-smallest";
+        modes[5].options.automaton = maSmallest;
+        modes[5].options.construction = mcGlushkov;
+        for (auto& mode : modes) {
+            mode.options.threads = threads;
+        }
+        
+        std::vector<std::string> inputs = files;
+        if (synthetic > 0) inputs.push_back("");
+        
+        std::cout << "\n=== Minimize benchmark ===\n";
+        for (const auto& input : inputs) {
+            auto load = [&](Grammar& grammar) {
+                if (!input.empty()) {
+                    grammar.load(input);
+                    return;
+                }
+                grammar.fillNew();
+                for (size_t rule = 0; rule < syntheticRules; ++rule) {
+                    std::string name = rule == 0 ? "S" : "S" + std::to_string(rule);
+                    grammar.addNonTerminal(name);
+                    grammar.setNTRule(name, syntheticRule(synthetic, static_cast<uint32_t>(rule + 1)));
+                }
+            };
+            
+            Grammar original;
+            load(original);
+            std::cout << (input.empty() ? "synthetic(" + std::to_string(synthetic) + ")" : input)
+                      << ": " << original.getNonTerminals().size() << " rule(s), "
+                      << operationCount(original) << " operation(s)\n";
+            
+            for (const auto& mode : modes) {
+                Grammar grammar;
+                load(grammar);
+                
+                auto started = std::chrono::steady_clock::now();
+                MinimizeStats stats = Minimize::minimize(&grammar, mode.options);
+                double ms = std::chrono::duration<double, std::milli>(
+                    std::chrono::steady_clock::now() - started).count();
+                
+                std::cout << "  " << mode.name << ": " << ms << " ms, states " << stats.nfaStates;
+                if (mode.options.automaton != maNFA) std::cout << " -> " << stats.dfaStates;
+                std::cout << " -> " << stats.minimizedStates << ", " << operationCount(grammar)
+                          << " operation(s)";
+                if (mode.options.automaton == maSmallest) {
+                    std::cout << ", DFA kept for " << stats.dfaChosen << " rule(s)";
+                }
+                if (stats.budgetExceeded > 0) {
+                    std::cout << ", " << stats.budgetExceeded << " rule(s) over DFA budget";
+                }
+                std::cout << "\n";
+                
+                if (mode.options.elimination.orders.size() > 1) {
+                    std::cout << "    best ordering:";
+                    for (int order = 0; order < EliminationOrderCount; ++order) {
+                        std::cout << " " << eliminationOrderName(static_cast<EliminationOrder>(order))
+                                  << " " << stats.orderWins[order];
+                    }
+                    if (stats.eliminationTimeouts > 0) {
+                        std::cout << ", " << stats.eliminationTimeouts << " timed out";
+                    }
+                    std::cout << "\n";
+                }
+            }
+        }
+        
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         printUsage(argv[0]);
@@ -267,6 +894,13 @@ int main(int argc, char* argv[]) {
         }
         return cmdFactorize(argv[2], argv[3]);
     }
+    else if (command == "factorize-right") {
+        if (argc < 4) {
+            std::cerr << "Usage: factorize-right <input.grm> <output.grm>\n";
+            return 1;
+        }
+        return cmdFactorizeRight(argv[2], argv[3]);
+    }
     else if (command == "remove-useless") {
         if (argc < 4) {
             std::cerr << "Usage: remove-useless <input.grm> <output.grm>\n";
@@ -274,6 +908,51 @@ int main(int argc, char* argv[]) {
         }
         return cmdRemoveUseless(argv[2], argv[3]);
     }
+    else if (command == "merge-equivalent") {
+        if (argc < 4) {
+            std::cerr << "Usage: merge-equivalent <input.grm> <output.grm>\n";
+            return 1;
+        }
+        return cmdMergeEquivalent(argv[2], argv[3]);
+    }
+    else if (command == "inline") {
+        if (argc < 4) {
+            std::cerr << "Usage: inline <input.grm> <output.grm> [maxOps]\n";
+            return 1;
+        }
+        int maxOperations = 0;
+        if (argc >= 5 && !parseCount(argv[4], "maxOps", maxOperations)) {
+            std::cerr << "Usage: inline <input.grm> <output.grm> [maxOps]\n";
+            return 1;
+        }
+        return cmdInline(argv[2], argv[3], maxOperations);
+    }
+    else if (command == "extract-common") {
+        if (argc < 4) {
+            std::cerr << "Usage: extract-common <input.grm> <output.grm> [minNodes]\n";
+            return 1;
+        }
+        int minNodes = 0;
+        if (argc >= 5 && !parseCount(argv[4], "minNodes", minNodes)) {
+            std::cerr << "Usage: extract-common <input.grm> <output.grm> [minNodes]\n";
+            return 1;
+        }
+        return cmdExtractCommon(argv[2], argv[3], minNodes);
+    }
+    else if (command == "simplify") {
+        if (argc < 4) {
+            std::cerr << "Usage: simplify <input.grm> <output.grm>\n";
+            return 1;
+        }
+        return cmdSimplify(argv[2], argv[3]);
+    }
+    else if (command == "slice") {
+        if (argc < 5) {
+            std::cerr << "Usage: slice <grammar.grm> <output.grm> <NT> [NT ...]\n";
+            return 1;
+        }
+        return cmdSlice(argv[2], argv[3], std::vector<std::string>(argv + 4, argv + argc));
+    }
     else if (command == "check-ll1") {
         if (argc < 3) {
             std::cerr << "Usage: check-ll1 <grammar.grm>\n";
@@ -281,6 +960,23 @@ int main(int argc, char* argv[]) {
         }
         return cmdCheckLL1(argv[2]);
     }
+    else if (command == "check-llk") {
+        if (argc < 3) {
+            std::cerr << "Usage: check-llk <grammar.grm> [maxK]\n";
+            return 1;
+        }
+        int maxK = 3;
+        if (argc >= 4 && !parseCount(argv[3], "maxK", maxK)) {
+            std::cerr << "Usage: check-llk <grammar.grm> [maxK]\n";
+            return 1;
+        }
+        if (maxK < 1) {
+            std::cerr << "Invalid maxK: '" << argv[3] << "' (expected at least 1)\n";
+            std::cerr << "Usage: check-llk <grammar.grm> [maxK]\n";
+            return 1;
+        }
+        return cmdCheckLLk(argv[2], maxK);
+    }
     else if (command == "first-follow") {
         if (argc < 3) {
             std::cerr << "Usage: first-follow <grammar.grm>\n";
@@ -295,6 +991,99 @@ int main(int argc, char* argv[]) {
         }
         return cmdTable(argv[2]);
     }
+    else if (command == "explain-conflicts") {
+        if (argc < 3) {
+            std::cerr << "Usage: explain-conflicts <grammar.grm>\n";
+            return 1;
+        }
+        return cmdExplainConflicts(argv[2]);
+    }
+    else if (command == "yields") {
+        if (argc < 3) {
+            std::cerr << "Usage: yields <grammar.grm>\n";
+            return 1;
+        }
+        return cmdYields(argv[2]);
+    }
+    else if (command == "regular") {
+        if (argc < 3) {
+            std::cerr << "Usage: regular <grammar.grm>\n";
+            return 1;
+        }
+        return cmdRegular(argv[2]);
+    }
+    else if (command == "generate") {
+        if (argc < 6) {
+            std::cerr << "Usage: generate <grammar.grm> <length> <count> <out.txt> [seed] [threads]\n";
+            return 1;
+        }
+        GeneratorOptions options;
+        if (!parseCount(argv[3], "length", options.length) ||
+            !parseCount(argv[4], "count", options.count) ||
+            (argc >= 7 && !parseCount(argv[6], "seed", options.seed)) ||
+            (argc >= 8 && !parseCount(argv[7], "threads", options.threads))) {
+            std::cerr << "Usage: generate <grammar.grm> <length> <count> <out.txt> [seed] [threads]\n";
+            return 1;
+        }
+        return cmdGenerate(argv[2], argv[5], options);
+    }
+    else if (command == "coverage") {
+        if (argc < 3) {
+            std::cerr << "Usage: coverage <grammar.grm> [out.txt]\n";
+            return 1;
+        }
+        return cmdCoverage(argv[2], argc >= 4 ? argv[3] : "");
+    }
+    else if (command == "ambiguity") {
+        if (argc < 3) {
+            std::cerr << "Usage: ambiguity <grammar.grm> [maxLength] [threads]\n";
+            return 1;
+        }
+        AmbiguityOptions options;
+        if ((argc >= 4 && !parseCount(argv[3], "maxLength", options.maxLength)) ||
+            (argc >= 5 && !parseCount(argv[4], "threads", options.threads))) {
+            std::cerr << "Usage: ambiguity <grammar.grm> [maxLength] [threads]\n";
+            return 1;
+        }
+        return cmdAmbiguity(argv[2], options);
+    }
+    else if (command == "verify") {
+        if (argc < 4) {
+            std::cerr << "Usage: verify <original.grm> <transformed.grm> [threads]\n";
+            return 1;
+        }
+        unsigned threads = 0;
+        if (argc > 4 && !parseCount(argv[4], "threads", threads)) {
+            std::cerr << "Usage: verify <original.grm> <transformed.grm> [threads]\n";
+            return 1;
+        }
+        return cmdVerify(argv[2], argv[3], threads);
+    }
+    else if (command == "bench-minimize") {
+        std::vector<std::string> files;
+        size_t synthetic = 0;
+        size_t syntheticRules = 1;
+        unsigned threads = 1;
+        bool valid = true;
+        for (int i = 2; i < argc && valid; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--synthetic" && i + 1 < argc) {
+                valid = parseCount(argv[++i], "--synthetic", synthetic);
+            } else if (arg == "--rules" && i + 1 < argc) {
+                valid = parseCount(argv[++i], "--rules", syntheticRules);
+                syntheticRules = std::max<size_t>(1, syntheticRules);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                valid = parseCount(argv[++i], "--threads", threads);
+            } else {
+                files.push_back(arg);
+            }
+        }
+        if (!valid || (files.empty() && synthetic == 0)) {
+            std::cerr << "Usage: bench-minimize [--synthetic N] [--rules R] [--threads T] [grammar.grm ...]\n";
+            return 1;
+        }
+        return cmdBenchMinimize(files, synthetic, syntheticRules, threads);
+    }
     else if (command == "--help" || command == "-h") {
         printUsage(argv[0]);
         return 0;
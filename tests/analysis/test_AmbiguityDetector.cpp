@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/analysis/AmbiguityDetector.h>
+#include <syngt/generate/CoverageSuite.h>
+
+using namespace syngt;
+
+class AmbiguityDetectorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    void rule(const std::string& name, const std::string& text) {
+        grammar->addNonTerminal(name);
+        grammar->setNTRule(name, text);
+    }
+
+    std::string text(const AmbiguityWitness& witness) {
+        return CoverageSuite::formatSentence(grammar.get(), witness.sentence);
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(AmbiguityDetectorTest, UnambiguousExpression) {
+    rule("E", "T # ('+' ; '-').");
+    rule("T", "'n' ; '(' , E , ')'.");
+
+    AmbiguityOptions options;
+    options.maxLength = 7;
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get(), options);
+
+    EXPECT_TRUE(report.complete);
+    EXPECT_EQ(report.checkedLength, 7);
+    EXPECT_TRUE(report.ambiguities.empty());
+}
+
+TEST_F(AmbiguityDetectorTest, AmbiguousExpressionHasShortestWitness) {
+    rule("E", "E , '+' , E ; 'n'.");
+
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get());
+
+    ASSERT_EQ(report.ambiguities.size(), 1u);
+    EXPECT_EQ(report.ambiguities[0].nonTerminal, "E");
+    EXPECT_EQ(text(report.ambiguities[0]), "n + n + n");
+}
+
+TEST_F(AmbiguityDetectorTest, DanglingElse) {
+    rule("S", "'if' , S , ('else' , S ; @) ; 'x'.");
+
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get());
+
+    ASSERT_EQ(report.ambiguities.size(), 1u);
+    EXPECT_EQ(text(report.ambiguities[0]), "if if x else x");
+}
+
+TEST_F(AmbiguityDetectorTest, AmbiguityIsReportedWhereItArises) {
+    // S is ambiguous only through A
+    rule("S", "A , 'b' ; 'c'.");
+    rule("A", "'a' ; 'a' ; 'd'.");
+
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get());
+
+    ASSERT_EQ(report.ambiguities.size(), 1u);
+    EXPECT_EQ(report.ambiguities[0].nonTerminal, "A");
+    EXPECT_EQ(text(report.ambiguities[0]), "a");
+}
+
+TEST_F(AmbiguityDetectorTest, NestedIterations) {
+    // aa is one repetition of 'a'* or two repetitions of 'a'
+    rule("S", "('a' #@) * , 'b'.");
+
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get());
+
+    ASSERT_EQ(report.ambiguities.size(), 1u);
+    EXPECT_EQ(text(report.ambiguities[0]), "a a b");
+}
+
+TEST_F(AmbiguityDetectorTest, NullableRepeatedBody) {
+    // A may be empty, so any number of empty repetitions derives each sentence
+    rule("S", "@*('a' ; A).");
+    rule("A", "@ ; 'b'.");
+
+    AmbiguityOptions options;
+    options.maxLength = 4;
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get(), options);
+
+    ASSERT_EQ(report.ambiguities.size(), 1u);
+    EXPECT_EQ(report.ambiguities[0].nonTerminal, "S");
+    EXPECT_TRUE(report.ambiguities[0].sentence.empty());
+}
+
+TEST_F(AmbiguityDetectorTest, NullableBodyWitnessIsShortestSentenceOfRule) {
+    rule("S", "'x' , ('y' # ('z' ; @)).");
+
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get());
+
+    // 'y'#('z';@): an empty separator is not a nullable body ('y' follows it)
+    EXPECT_TRUE(report.ambiguities.empty());
+
+    rule("T", "'x' , (('y' ; @) # @).");
+    grammar->setNTRule("S", "T.");
+    report = AmbiguityDetector::analyze(grammar.get());
+
+    ASSERT_EQ(report.ambiguities.size(), 1u);
+    EXPECT_EQ(report.ambiguities[0].nonTerminal, "T");
+    EXPECT_EQ(text(report.ambiguities[0]), "x");
+}
+
+TEST_F(AmbiguityDetectorTest, EmptyCycleThroughNonTerminals) {
+    rule("S", "A , 'x'.");
+    rule("A", "B ; 'a'.");
+    rule("B", "A ; @.");
+
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get());
+
+    ASSERT_EQ(report.ambiguities.size(), 2u);
+    EXPECT_EQ(report.ambiguities[0].nonTerminal, "A");
+    EXPECT_EQ(report.ambiguities[1].nonTerminal, "B");
+}
+
+TEST_F(AmbiguityDetectorTest, UnreachableRulesAreIgnored) {
+    rule("S", "'a'.");
+    rule("Unused", "'b' ; 'b'.");
+
+    EXPECT_TRUE(AmbiguityDetector::analyze(grammar.get()).ambiguities.empty());
+}
+
+TEST_F(AmbiguityDetectorTest, LengthBoundHidesLongerAmbiguity) {
+    rule("E", "E , '+' , E ; 'n'.");
+
+    AmbiguityOptions options;
+    options.maxLength = 4;
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get(), options);
+
+    EXPECT_TRUE(report.complete);
+    EXPECT_TRUE(report.ambiguities.empty());
+}
+
+TEST_F(AmbiguityDetectorTest, SentenceBudgetStopsSearch) {
+    rule("S", "('a' ; 'b' ; 'c' ; 'd') *.");
+
+    AmbiguityOptions options;
+    options.maxLength = 12;
+    options.sentenceBudget = 1000;
+    AmbiguityReport report = AmbiguityDetector::analyze(grammar.get(), options);
+
+    EXPECT_FALSE(report.complete);
+    EXPECT_TRUE(report.budgetExceeded);
+    EXPECT_FALSE(report.timedOut);
+    EXPECT_GE(report.checkedLength, 2);
+    EXPECT_LT(report.checkedLength, 12);
+}
+
+TEST_F(AmbiguityDetectorTest, ThreadsDoNotChangeResult) {
+    rule("S", "A , B ; B , A ; C.");
+    rule("A", "'a' # 'x'.");
+    rule("B", "'b' , ('x' ; @).");
+    rule("C", "('a' ; 'b' , 'x') , 'b'.");
+
+    AmbiguityOptions options;
+    options.maxLength = 6;
+    AmbiguityReport single = AmbiguityDetector::analyze(grammar.get(), options);
+    options.threads = 4;
+    AmbiguityReport parallel = AmbiguityDetector::analyze(grammar.get(), options);
+
+    ASSERT_EQ(single.ambiguities.size(), parallel.ambiguities.size());
+    for (size_t i = 0; i < single.ambiguities.size(); ++i) {
+        EXPECT_EQ(single.ambiguities[i].nonTerminal, parallel.ambiguities[i].nonTerminal);
+        EXPECT_EQ(single.ambiguities[i].sentence, parallel.ambiguities[i].sentence);
+    }
+    ASSERT_EQ(single.ambiguities.size(), 1u);
+    EXPECT_EQ(text(single.ambiguities[0]), "a b");
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/analysis/ParsingTable.h>
+#include <syngt/analysis/ConflictExplainer.h>
+
+using namespace syngt;
+
+class ConflictExplainerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    int t(const std::string& name) { return grammar->findTerminal(name); }
+
+    std::vector<ConflictExplanation> explainAll() {
+        auto table = ParsingTable::build(grammar.get());
+        return ConflictExplainer::explain(grammar.get(), *table);
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(ConflictExplainerTest, StructuredConflictsMatchStrings) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' ; 'a' , 'c'.");
+
+    auto table = ParsingTable::build(grammar.get());
+    ASSERT_TRUE(table->hasConflicts());
+    ASSERT_EQ(table->getConflictDetails().size(), table->getConflicts().size());
+
+    const auto& conflict = table->getConflictDetails()[0];
+    EXPECT_EQ(conflict.nonTerminal, "S");
+    EXPECT_EQ(conflict.terminal, t("a"));
+    EXPECT_NE(conflict.existing, conflict.incoming);
+}
+
+TEST_F(ConflictExplainerTest, FirstFirstConflictAtStart) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' ; 'a' , 'c'.");
+
+    auto explanations = explainAll();
+    ASSERT_EQ(explanations.size(), 1u);
+
+    const auto& e = explanations[0];
+    ASSERT_TRUE(e.found);
+    EXPECT_FALSE(e.viaFollow);
+    EXPECT_EQ(e.derivation, std::vector<std::string>{"S"});
+    EXPECT_TRUE(e.prefix.empty());
+    EXPECT_EQ(e.firstWitness, (std::vector<int>{t("a"), t("b")}));
+    EXPECT_EQ(e.secondWitness, (std::vector<int>{t("a"), t("c")}));
+}
+
+TEST_F(ConflictExplainerTest, NestedConflictHasContext) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "'x' , A , 'y'.");
+    grammar->setNTRule("A", "'a' ; 'a' , 'b'.");
+
+    auto explanations = explainAll();
+    ASSERT_EQ(explanations.size(), 1u);
+
+    const auto& e = explanations[0];
+    ASSERT_TRUE(e.found);
+    EXPECT_EQ(e.derivation, (std::vector<std::string>{"S", "A"}));
+    EXPECT_EQ(e.prefix, std::vector<int>{t("x")});
+    EXPECT_EQ(e.firstWitness, (std::vector<int>{t("x"), t("a"), t("y")}));
+    EXPECT_EQ(e.secondWitness, (std::vector<int>{t("x"), t("a"), t("b"), t("y")}));
+}
+
+TEST_F(ConflictExplainerTest, FirstFollowConflict) {
+    // A may vanish, and 'a' also follows A
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "A , 'a'.");
+    grammar->setNTRule("A", "'a' ; 'b' *.");
+
+    auto explanations = explainAll();
+    ASSERT_EQ(explanations.size(), 1u);
+
+    const auto& e = explanations[0];
+    ASSERT_TRUE(e.found);
+    EXPECT_TRUE(e.viaFollow);
+    EXPECT_EQ(e.derivation, (std::vector<std::string>{"S", "A"}));
+    EXPECT_EQ(e.firstWitness, (std::vector<int>{t("a"), t("a")}));
+    EXPECT_EQ(e.secondWitness, std::vector<int>{t("a")});
+}
+
+TEST_F(ConflictExplainerTest, LeftRecursionConflict) {
+    grammar->addNonTerminal("E");
+    grammar->setNTRule("E", "E , '+' , 'n' ; 'n'.");
+
+    auto explanations = explainAll();
+    ASSERT_EQ(explanations.size(), 1u);
+
+    const auto& e = explanations[0];
+    ASSERT_TRUE(e.found);
+    EXPECT_EQ(e.firstWitness, (std::vector<int>{t("n"), t("+"), t("n")}));
+    EXPECT_EQ(e.secondWitness, std::vector<int>{t("n")});
+}
+
+TEST_F(ConflictExplainerTest, WitnessesStartWithConflictToken) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("B");
+    grammar->addNonTerminal("C");
+    grammar->setNTRule("S", "'p' , 'q' , B ; 'p' , C.");
+    grammar->setNTRule("B", "'b' , C ; C , 'b'.");
+    grammar->setNTRule("C", "'c' ; 'd'.");
+
+    auto explanations = explainAll();
+    ASSERT_FALSE(explanations.empty());
+
+    for (const auto& e : explanations) {
+        ASSERT_TRUE(e.found);
+        size_t pos = e.prefix.size();
+        ASSERT_GT(e.firstWitness.size(), pos);
+        ASSERT_GT(e.secondWitness.size(), pos);
+        EXPECT_EQ(e.firstWitness[pos], e.terminal);
+        EXPECT_EQ(e.secondWitness[pos], e.terminal);
+    }
+}
+
+TEST_F(ConflictExplainerTest, NoConflicts) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' ; 'b'.");
+
+    EXPECT_TRUE(explainAll().empty());
+}
+
+TEST_F(ConflictExplainerTest, FormatMentionsWitnesses) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' ; 'a' , 'c'.");
+
+    auto explanations = explainAll();
+    ASSERT_EQ(explanations.size(), 1u);
+
+    std::string text = ConflictExplainer::format(grammar.get(), explanations[0]);
+    EXPECT_NE(text.find("Conflict at M[S, a]"), std::string::npos);
+    EXPECT_NE(text.find("witness 1: 'a' 'b'"), std::string::npos);
+    EXPECT_NE(text.find("witness 2: 'a' 'c'"), std::string::npos);
+}
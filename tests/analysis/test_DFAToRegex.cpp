@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/analysis/DFAToREGEX.h>
+#include <syngt/regex/REOr.h>
+
+#include "common/REMatch.h"
+
+#include <chrono>
+#include <random>
+
+using namespace syngt;
+using namespace syngt::test;
+
+namespace {
+
+// Automaton over {a, b} with loops and back arcs
+MinimizationTable randomTable(unsigned seed, int states) {
+    std::mt19937 random(seed);
+    MinimizationTable table;
+    std::vector<State> all{StartState, FinalState};
+    for (int i = 0; i < states; ++i) {
+        all.push_back(table.createState());
+    }
+    std::uniform_int_distribution<size_t> pick(0, all.size() - 1);
+    for (size_t i = 0; i < all.size(); ++i) {
+        if (all[i] == FinalState) continue;
+        table.linkStates(all[i], all[i == 0 ? 2 : pick(random)], "\"a\"");
+        table.linkStates(all[i], all[pick(random)], "\"b\"");
+    }
+    table.linkStates(all.back(), FinalState, "\"\"");
+    return table;
+}
+
+// Chain of states, each of which may leave to the final state:
+// a prefix of 'a' of length 1..states followed by 'b'
+MinimizationTable combTable(int states) {
+    MinimizationTable table;
+    State previous = StartState;
+    for (int i = 0; i < states; ++i) {
+        State state = table.createState();
+        table.linkStates(previous, state, "\"a\"");
+        table.linkStates(state, FinalState, "\"b\"");
+        previous = state;
+    }
+    return table;
+}
+
+}
+
+class DFAToRegexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    std::unique_ptr<RETree> convert(const MinimizationTable& table) {
+        auto converter = DFAToRegex::fromMinimizationTable(grammar.get(), &table);
+        converter->removeAllStates();
+        return converter->getRegularExpression();
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(DFAToRegexTest, Sequence) {
+    MinimizationTable table;
+    State s2 = table.createState();
+    table.linkStates(StartState, s2, "\"a\"");
+    table.linkStates(s2, FinalState, "\"b\"");
+
+    auto tree = convert(table);
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a", "b"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {"a"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {"b", "a"}));
+}
+
+TEST_F(DFAToRegexTest, ParallelArcsBecomeAlternative) {
+    MinimizationTable table;
+    table.linkStates(StartState, FinalState, "\"a\"");
+    table.linkStates(StartState, FinalState, "\"b\"");
+
+    auto tree = convert(table);
+    ASSERT_NE(dynamic_cast<const REOr*>(tree.get()), nullptr);
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a"}));
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"b"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {}));
+}
+
+TEST_F(DFAToRegexTest, SelfLoopBecomesIteration) {
+    MinimizationTable table;
+    State s2 = table.createState();
+    table.linkStates(StartState, s2, "\"a\"");
+    table.linkStates(s2, s2, "\"b\"");
+    table.linkStates(s2, FinalState, "\"c\"");
+
+    auto tree = convert(table);
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a", "c"}));
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a", "b", "b", "b", "c"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {"a", "b"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {"b", "c"}));
+}
+
+TEST_F(DFAToRegexTest, BackArcBecomesBinaryIteration) {
+    // 'a' # 'b'
+    MinimizationTable table;
+    State s2 = table.createState();
+    table.linkStates(StartState, s2, "\"a\"");
+    table.linkStates(s2, StartState, "\"b\"");
+    table.linkStates(s2, FinalState, "\"\"");
+
+    auto tree = convert(table);
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a"}));
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a", "b", "a"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {"a", "b"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {}));
+}
+
+TEST_F(DFAToRegexTest, EmptyTableGivesEpsilon) {
+    MinimizationTable table;
+    auto tree = convert(table);
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {}));
+}
+
+TEST_F(DFAToRegexTest, LargeAutomatonIsFast) {
+    const int length = 5000;
+    auto table = combTable(length);
+
+    auto started = std::chrono::steady_clock::now();
+    auto tree = convert(table);
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count(), 5);
+    EXPECT_LE(tree->getOperationCount(), 4 * length);
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a", "b"}));
+    EXPECT_TRUE(accepts(grammar.get(), tree.get(), {"a", "a", "a", "b"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {"b"}));
+    EXPECT_FALSE(accepts(grammar.get(), tree.get(), {"a", "a"}));
+}
+
+// ---------------------------------------------------------------------------
+// Elimination orderings
+// ---------------------------------------------------------------------------
+
+TEST_F(DFAToRegexTest, EveryOrderingPreservesLanguage) {
+    auto words = allWords({"a", "b"}, 7);
+    for (unsigned seed = 1; seed <= 10; ++seed) {
+        auto table = randomTable(seed, 6);
+        auto reference = convert(table);
+
+        for (int order = 0; order < EliminationOrderCount; ++order) {
+            auto converter = DFAToRegex::fromMinimizationTable(grammar.get(), &table);
+            converter->removeAllStates(static_cast<EliminationOrder>(order));
+            auto tree = converter->getRegularExpression();
+
+            for (const auto& word : words) {
+                ASSERT_EQ(accepts(grammar.get(), tree.get(), word),
+                          accepts(grammar.get(), reference.get(), word))
+                    << "seed " << seed << ", " << eliminationOrderName(static_cast<EliminationOrder>(order));
+            }
+        }
+    }
+}
+
+TEST_F(DFAToRegexTest, PortfolioKeepsSmallestResult) {
+    for (unsigned seed = 1; seed <= 20; ++seed) {
+        auto table = randomTable(seed, 12);
+        auto converter = DFAToRegex::fromMinimizationTable(grammar.get(), &table);
+        auto stats = converter->removeAllStates(EliminationOptions());
+        auto tree = converter->getRegularExpression();
+
+        ASSERT_EQ(stats.size(), static_cast<size_t>(EliminationOrderCount));
+        int smallest = stats[0].operationCount;
+        for (const auto& run : stats) {
+            EXPECT_TRUE(run.completed);
+            smallest = std::min(smallest, run.operationCount);
+        }
+        EXPECT_EQ(tree->getOperationCount(), smallest) << "seed " << seed;
+        EXPECT_LE(tree->getOperationCount(), convert(table)->getOperationCount());
+    }
+}
+
+TEST_F(DFAToRegexTest, PortfolioDoesNotDependOnThreads) {
+    auto table = combTable(300);
+
+    EliminationOptions options;
+    options.threads = 1;
+    auto single = DFAToRegex::fromMinimizationTable(grammar.get(), &table);
+    single->removeAllStates(options);
+
+    options.threads = 4;
+    auto parallel = DFAToRegex::fromMinimizationTable(grammar.get(), &table);
+    parallel->removeAllStates(options);
+
+    EXPECT_EQ(single->getRegularExpression()->toString(SelectionMask{}, false),
+              parallel->getRegularExpression()->toString(SelectionMask{}, false));
+}
+
+TEST_F(DFAToRegexTest, TimeBudgetAlwaysCompletesFirstOrdering) {
+    auto table = combTable(2000);
+
+    EliminationOptions options;
+    options.orders = {eoMinDegree, eoGreedyCost};
+    options.timeBudgetMs = 1e-6;
+    auto converter = DFAToRegex::fromMinimizationTable(grammar.get(), &table);
+    auto stats = converter->removeAllStates(options);
+
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].order, eoMinDegree);
+    EXPECT_TRUE(stats[0].completed);
+    EXPECT_FALSE(stats[1].completed);
+    EXPECT_EQ(converter->getRegularExpression()->getOperationCount(), stats[0].operationCount);
+}
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/analysis/LLkAnalyzer.h>
+#include <syngt/analysis/TokenTrie.h>
+
+using namespace syngt;
+
+class LLkAnalyzerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    int t(const std::string& name) { return grammar->findTerminal(name); }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+// ---------------------------------------------------------------------------
+// TokenTrie
+// ---------------------------------------------------------------------------
+
+TEST(TokenTrieTest, InsertAndContains) {
+    TokenTrie trie;
+    EXPECT_TRUE(trie.insert({1, 2}));
+    EXPECT_FALSE(trie.insert({1, 2}));
+    EXPECT_TRUE(trie.insert({1}));
+
+    EXPECT_TRUE(trie.contains({1, 2}));
+    EXPECT_TRUE(trie.contains({1}));
+    EXPECT_FALSE(trie.contains({2}));
+    EXPECT_FALSE(trie.containsEmpty());
+    EXPECT_EQ(trie.size(), 2u);
+}
+
+TEST(TokenTrieTest, ConcatTruncatesToK) {
+    TokenTrie head;
+    head.insert({});
+    head.insert({1});
+    head.insert({1, 2});
+
+    TokenTrie tail;
+    tail.insert({3, 4});
+
+    auto result = head.concat(tail, 2);
+    EXPECT_TRUE(result.contains({3, 4}));
+    EXPECT_TRUE(result.contains({1, 3}));
+    EXPECT_TRUE(result.contains({1, 2}));
+    EXPECT_EQ(result.size(), 3u);
+}
+
+TEST(TokenTrieTest, ConcatStopsAtEndOfInput) {
+    TokenTrie head;
+    head.insert({TokenTrie::EndOfInput});
+
+    TokenTrie tail;
+    tail.insert({5});
+
+    auto result = head.concat(tail, 3);
+    EXPECT_TRUE(result.contains({TokenTrie::EndOfInput}));
+    EXPECT_EQ(result.size(), 1u);
+}
+
+TEST(TokenTrieTest, UniteAndIntersect) {
+    TokenTrie a;
+    a.insert({1, 2});
+    a.insert({1, 3});
+
+    TokenTrie b;
+    b.insert({1, 3});
+    b.insert({4});
+
+    EXPECT_TRUE(a.intersects(b));
+    auto common = a.intersect(b);
+    EXPECT_EQ(common.size(), 1u);
+    EXPECT_TRUE(common.contains({1, 3}));
+
+    EXPECT_TRUE(a.unite(b));
+    EXPECT_FALSE(a.unite(b));
+    EXPECT_EQ(a.size(), 3u);
+}
+
+TEST(TokenTrieTest, LimitThrows) {
+    TokenTrie trie;
+    trie.setLimit(2);
+    trie.insert({1});
+    trie.insert({2});
+    EXPECT_THROW(trie.insert({3}), std::length_error);
+}
+
+// ---------------------------------------------------------------------------
+// FIRST_k / FOLLOW_k
+// ---------------------------------------------------------------------------
+
+TEST_F(LLkAnalyzerTest, FirstKOfSequence) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' , 'c'.");
+
+    auto first = LLkAnalyzer::computeFirstK(grammar.get(), 2);
+    int s = grammar->findNonTerminal("S");
+    EXPECT_EQ(first[s].size(), 1u);
+    EXPECT_TRUE(first[s].contains({t("a"), t("b")}));
+}
+
+TEST_F(LLkAnalyzerTest, FirstKThroughNullable) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "A , 'b'.");
+    grammar->setNTRule("A", "'a' ; @.");
+
+    auto first = LLkAnalyzer::computeFirstK(grammar.get(), 2);
+    int s = grammar->findNonTerminal("S");
+    int a = grammar->findNonTerminal("A");
+    EXPECT_TRUE(first[a].containsEmpty());
+    EXPECT_TRUE(first[s].contains({t("a"), t("b")}));
+    EXPECT_TRUE(first[s].contains({t("b")}));
+}
+
+TEST_F(LLkAnalyzerTest, FollowKOfStartContainsEndOfInput) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "A , 'x' , 'y'.");
+    grammar->setNTRule("A", "'a'.");
+
+    auto follow = LLkAnalyzer::computeFollowK(grammar.get(), 2);
+    int s = grammar->findNonTerminal("S");
+    int a = grammar->findNonTerminal("A");
+    EXPECT_TRUE(follow[s].contains({TokenTrie::EndOfInput}));
+    EXPECT_TRUE(follow[a].contains({t("x"), t("y")}));
+}
+
+TEST_F(LLkAnalyzerTest, FirstKOfIteration) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' * , 'b'.");
+
+    auto first = LLkAnalyzer::computeFirstK(grammar.get(), 2);
+    int s = grammar->findNonTerminal("S");
+    EXPECT_TRUE(first[s].contains({t("b")}));
+    EXPECT_TRUE(first[s].contains({t("a"), t("b")}));
+    EXPECT_TRUE(first[s].contains({t("a"), t("a")}));
+    EXPECT_EQ(first[s].size(), 3u);
+}
+
+// ---------------------------------------------------------------------------
+// Minimal k
+// ---------------------------------------------------------------------------
+
+TEST_F(LLkAnalyzerTest, LL1GrammarHasNoDecisions) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' ; 'b'.");
+
+    auto report = LLkAnalyzer::analyze(grammar.get());
+    EXPECT_TRUE(report.decisions.empty());
+    EXPECT_EQ(report.grammarK, 1);
+}
+
+TEST_F(LLkAnalyzerTest, CommonPrefixNeedsK2) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' ; 'a' , 'c'.");
+
+    auto report = LLkAnalyzer::analyze(grammar.get());
+    ASSERT_EQ(report.decisions.size(), 1u);
+    EXPECT_EQ(report.decisions[0].nonTerminal, "S");
+    EXPECT_EQ(report.decisions[0].kind, "alternative");
+    EXPECT_EQ(report.decisions[0].minimalK, 2);
+    EXPECT_EQ(report.decisions[0].alternatives.size(), 2u);
+
+    ASSERT_EQ(report.decisions[0].conflictingPrefixes.size(), 1u);
+    EXPECT_EQ(report.decisions[0].conflictingPrefixes[0], std::vector<int>{t("a")});
+    EXPECT_EQ(report.grammarK, 2);
+}
+
+TEST_F(LLkAnalyzerTest, LongerCommonPrefixNeedsK3) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "A , 'x' ; A , 'y'.");
+    grammar->setNTRule("A", "'a' , 'a'.");
+
+    auto report = LLkAnalyzer::analyze(grammar.get());
+    ASSERT_EQ(report.decisions.size(), 1u);
+    EXPECT_EQ(report.decisions[0].minimalK, 3);
+    ASSERT_FALSE(report.decisions[0].conflictingPrefixes.empty());
+    EXPECT_EQ(report.decisions[0].conflictingPrefixes[0],
+              (std::vector<int>{t("a"), t("a")}));
+}
+
+TEST_F(LLkAnalyzerTest, IterationExitConflict) {
+    // S : ('a' , 'b')* , 'a' , 'c'  — continue and exit both start with 'a'
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' , 'b') * , 'a' , 'c'.");
+
+    auto report = LLkAnalyzer::analyze(grammar.get());
+    ASSERT_EQ(report.decisions.size(), 1u);
+    EXPECT_EQ(report.decisions[0].kind, "iteration");
+    EXPECT_EQ(report.decisions[0].minimalK, 2);
+}
+
+TEST_F(LLkAnalyzerTest, LeftRecursionIsNeverLLk) {
+    grammar->addNonTerminal("E");
+    grammar->setNTRule("E", "E , '+' , 'n' ; 'n'.");
+
+    LLkOptions options;
+    options.maxK = 3;
+    auto report = LLkAnalyzer::analyze(grammar.get(), options);
+    ASSERT_EQ(report.decisions.size(), 1u);
+    EXPECT_EQ(report.decisions[0].minimalK, 0);
+    EXPECT_FALSE(report.decisions[0].budgetExceeded);
+    EXPECT_EQ(report.checkedK, 3);
+    EXPECT_EQ(report.grammarK, 0);
+}
+
+TEST_F(LLkAnalyzerTest, SetSizeBudget) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' ; 'b' ; 'c') * , 'a' ; ('a' ; 'b' ; 'c') * , 'b'.");
+
+    LLkOptions options;
+    options.maxK = 6;
+    options.maxSetSize = 16;
+    auto report = LLkAnalyzer::analyze(grammar.get(), options);
+    EXPECT_TRUE(report.budgetExceeded);
+    ASSERT_FALSE(report.decisions.empty());
+    EXPECT_TRUE(report.decisions[0].budgetExceeded);
+    EXPECT_EQ(report.grammarK, 0);
+}
+
+TEST_F(LLkAnalyzerTest, NullGrammar) {
+    auto report = LLkAnalyzer::analyze(nullptr);
+    EXPECT_TRUE(report.decisions.empty());
+    EXPECT_TRUE(LLkAnalyzer::computeFirstK(nullptr, 2).empty());
+}
+
+TEST_F(LLkAnalyzerTest, FormatSequence) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a'.");
+
+    EXPECT_EQ(LLkAnalyzer::formatSequence(grammar.get(), {t("a"), TokenTrie::EndOfInput}), "'a' $");
+    EXPECT_EQ(LLkAnalyzer::formatSequence(grammar.get(), {}), "@");
+}
+
+TEST_F(LLkAnalyzerTest, MaxKBelowOneStillChecksK1) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' ; 'a' , 'c'.");
+
+    LLkOptions options;
+    options.maxK = 0;
+    auto report = LLkAnalyzer::analyze(grammar.get(), options);
+    EXPECT_EQ(report.checkedK, 1);
+    ASSERT_EQ(report.decisions.size(), 1u);
+    EXPECT_EQ(report.decisions[0].minimalK, 0);
+    EXPECT_EQ(report.grammarK, 0);
+}
@@ -0,0 +1,244 @@
+#include <gtest/gtest.h>
+#include <syngt/analysis/Minimization.h>
+
+#include <random>
+
+using namespace syngt;
+
+namespace {
+
+std::set<State> targets(const MinimizationTable& table, State state, const std::string& symbol) {
+    for (int i = 0; i < table.getSymbolsCount(); ++i) {
+        if (table.getSymbol(i) != symbol) continue;
+        const StatesSet* cell = table.getTableElement(state, i);
+        return cell ? cell->getStates() : std::set<State>{};
+    }
+    return {};
+}
+
+bool hasRow(const MinimizationTable& table, State state) {
+    for (int i = 0; i < table.getSymbolsCount(); ++i) {
+        if (table.getTableElement(state, i)) return true;
+    }
+    return false;
+}
+
+}
+
+TEST(MinimizationTableTest, SymbolsGetStableIndices) {
+    MinimizationTable table;
+    table.linkStates(StartState, FinalState, "\"a\"");
+    table.linkStates(StartState, FinalState, "\"b\"");
+    table.linkStates(StartState, FinalState, "\"a\"");
+
+    EXPECT_EQ(table.getSymbolsCount(), 2);
+    EXPECT_EQ(table.getSymbol(0), "\"a\"");
+    EXPECT_EQ(table.getSymbol(1), "\"b\"");
+    EXPECT_EQ(table.getTableElement(StartState, 0)->count(), 1u);
+    EXPECT_EQ(table.getTableElement(FinalState, 0), nullptr);
+    EXPECT_EQ(table.getTableElement(StartState, 5), nullptr);
+}
+
+TEST(MinimizationTableTest, MergesStatesWithEqualRows) {
+    // 'a' , 'c' ; 'b' , 'c': both intermediate states go to X on 'c'
+    MinimizationTable table;
+    State s2 = table.createState();
+    State s3 = table.createState();
+    table.linkStates(StartState, s2, "\"a\"");
+    table.linkStates(StartState, s3, "\"b\"");
+    table.linkStates(s2, FinalState, "\"c\"");
+    table.linkStates(s3, FinalState, "\"c\"");
+
+    table.minimize();
+
+    EXPECT_EQ(targets(table, StartState, "\"a\""), std::set<State>{s2});
+    EXPECT_EQ(targets(table, StartState, "\"b\""), std::set<State>{s2});
+    EXPECT_EQ(targets(table, s2, "\"c\""), std::set<State>{FinalState});
+    EXPECT_FALSE(hasRow(table, s3));
+}
+
+TEST(MinimizationTableTest, FinalStateIsNeverMerged) {
+    // State 2 has no transitions, just like FinalState
+    MinimizationTable table;
+    State s2 = table.createState();
+    table.linkStates(StartState, FinalState, "\"a\"");
+    table.linkStates(StartState, s2, "\"b\"");
+
+    table.minimize();
+
+    EXPECT_EQ(targets(table, StartState, "\"a\""), std::set<State>{FinalState});
+    EXPECT_EQ(targets(table, StartState, "\"b\""), std::set<State>{s2});
+}
+
+TEST(MinimizationTableTest, MissingTransitionDiffersFromTransition) {
+    MinimizationTable table;
+    State s2 = table.createState();
+    State s3 = table.createState();
+    State s4 = table.createState();
+    table.linkStates(StartState, s2, "\"a\"");
+    table.linkStates(StartState, s3, "\"b\"");
+    table.linkStates(s2, FinalState, "\"c\"");
+    table.linkStates(s3, FinalState, "\"c\"");
+    table.linkStates(s3, s4, "\"d\"");
+
+    table.minimize();
+
+    EXPECT_EQ(targets(table, StartState, "\"a\""), std::set<State>{s2});
+    EXPECT_EQ(targets(table, StartState, "\"b\""), std::set<State>{s3});
+}
+
+TEST(MinimizationTableTest, NondeterministicRowsCompareAsClasses) {
+    // States 2 and 3 both reach {4, 5} on 'a', and 4, 5 are equivalent
+    MinimizationTable table;
+    State s2 = table.createState();
+    State s3 = table.createState();
+    State s4 = table.createState();
+    State s5 = table.createState();
+    table.linkStates(StartState, s2, "\"x\"");
+    table.linkStates(StartState, s3, "\"y\"");
+    table.linkStates(s2, s4, "\"a\"");
+    table.linkStates(s2, s5, "\"a\"");
+    table.linkStates(s3, s4, "\"a\"");
+    table.linkStates(s4, FinalState, "\"b\"");
+    table.linkStates(s5, FinalState, "\"b\"");
+
+    table.minimize();
+
+    EXPECT_EQ(targets(table, StartState, "\"y\""), std::set<State>{s2});
+    EXPECT_EQ(targets(table, s2, "\"a\""), std::set<State>{s4});
+}
+
+TEST(MinimizationTableTest, LongCyclesCollapse) {
+    // 2 -> 3 -> 4 -> 2 on 'a' and 5 -> 5 on 'a' are bisimilar
+    MinimizationTable table;
+    State s2 = table.createState();
+    State s3 = table.createState();
+    State s4 = table.createState();
+    State s5 = table.createState();
+    table.linkStates(StartState, s2, "\"x\"");
+    table.linkStates(StartState, s5, "\"y\"");
+    table.linkStates(s2, s3, "\"a\"");
+    table.linkStates(s3, s4, "\"a\"");
+    table.linkStates(s4, s2, "\"a\"");
+    table.linkStates(s5, s5, "\"a\"");
+
+    table.minimize();
+
+    EXPECT_EQ(targets(table, StartState, "\"x\""), std::set<State>{s2});
+    EXPECT_EQ(targets(table, StartState, "\"y\""), std::set<State>{s2});
+    EXPECT_EQ(targets(table, s2, "\"a\""), std::set<State>{s2});
+}
+
+TEST(MinimizationTableTest, ResultIsStableAndIdempotent) {
+    std::mt19937 rng(17);
+    for (int round = 0; round < 300; ++round) {
+        MinimizationTable table;
+        int states = 2 + static_cast<int>(rng() % 10);
+        for (int i = 2; i < states; ++i) table.createState();
+        int edges = static_cast<int>(rng() % (2 * states + 1));
+        for (int e = 0; e < edges; ++e) {
+            State from = static_cast<State>(rng() % states);
+            State to = static_cast<State>(rng() % states);
+            table.linkStates(from, to, std::string(1, static_cast<char>('a' + rng() % 3)));
+        }
+
+        table.minimize();
+        std::string once = table.toString();
+
+        // No two remaining states have identical rows
+        for (State s1 = 0; s1 < states; ++s1) {
+            if (s1 == FinalState || !hasRow(table, s1)) continue;
+            for (State s2 = s1 + 1; s2 < states; ++s2) {
+                if (s2 == FinalState || !hasRow(table, s2)) continue;
+                bool equal = true;
+                for (int i = 0; i < table.getSymbolsCount() && equal; ++i) {
+                    const StatesSet* c1 = table.getTableElement(s1, i);
+                    const StatesSet* c2 = table.getTableElement(s2, i);
+                    equal = (c1 ? c1->getStates() : std::set<State>{}) ==
+                            (c2 ? c2->getStates() : std::set<State>{});
+                }
+                EXPECT_FALSE(equal) << "round " << round << ": " << s1 << " ~ " << s2;
+            }
+        }
+
+        table.minimize();
+        EXPECT_EQ(table.toString(), once) << "round " << round;
+    }
+}
+
+TEST(MinimizationTableTest, DeterminizeRemovesEpsilonAndNondeterminism) {
+    // 0 -a-> {2, 3}, 2 -b-> X, 3 -eps-> 4, 4 -c-> X
+    MinimizationTable table;
+    State s2 = table.createState();
+    State s3 = table.createState();
+    State s4 = table.createState();
+    table.linkStates(StartState, s2, "\"a\"");
+    table.linkStates(StartState, s3, "\"a\"");
+    table.linkStates(s2, FinalState, "\"b\"");
+    table.linkStates(s3, s4, EpsilonSymbol);
+    table.linkStates(s4, FinalState, "\"c\"");
+
+    ASSERT_TRUE(table.determinize());
+
+    auto afterA = targets(table, StartState, "\"a\"");
+    ASSERT_EQ(afterA.size(), 1u);
+    State merged = *afterA.begin();
+    EXPECT_EQ(targets(table, merged, "\"b\""), std::set<State>{FinalState});
+    EXPECT_EQ(targets(table, merged, "\"c\""), std::set<State>{FinalState});
+    EXPECT_TRUE(targets(table, StartState, EpsilonSymbol).empty());
+    EXPECT_EQ(table.getUsedStatesCount(), 3);
+}
+
+TEST(MinimizationTableTest, DeterminizeMarksAcceptingStates) {
+    // 'a' * : the start subset already contains FinalState
+    MinimizationTable table;
+    State s2 = table.createState();
+    table.linkStates(StartState, s2, EpsilonSymbol);
+    table.linkStates(s2, FinalState, EpsilonSymbol);
+    table.linkStates(s2, s2, "\"a\"");
+
+    ASSERT_TRUE(table.determinize());
+    table.minimize();
+
+    EXPECT_EQ(targets(table, StartState, EpsilonSymbol), std::set<State>{FinalState});
+    EXPECT_EQ(targets(table, StartState, "\"a\""), std::set<State>{StartState});
+}
+
+TEST(MinimizationTableTest, DeterminizeDropsDeadSubsets) {
+    MinimizationTable table;
+    State s2 = table.createState();
+    State dead = table.createState();
+    table.linkStates(StartState, s2, "\"a\"");
+    table.linkStates(s2, FinalState, "\"b\"");
+    table.linkStates(StartState, dead, "\"c\"");
+    table.linkStates(dead, dead, "\"c\"");
+
+    ASSERT_TRUE(table.determinize());
+    EXPECT_TRUE(targets(table, StartState, "\"c\"").empty());
+    EXPECT_EQ(table.getUsedStatesCount(), 3);
+}
+
+TEST(MinimizationTableTest, DeterminizeRespectsBudget) {
+    // (a;b)*, a, (a;b), (a;b), (a;b): the DFA needs 2^4 subsets
+    MinimizationTable table;
+    State loop = table.createState();
+    table.linkStates(StartState, loop, EpsilonSymbol);
+    table.linkStates(loop, loop, "\"a\"");
+    table.linkStates(loop, loop, "\"b\"");
+    State previous = table.createState();
+    table.linkStates(loop, previous, "\"a\"");
+    for (int i = 0; i < 3; ++i) {
+        State next = (i == 2) ? FinalState : table.createState();
+        table.linkStates(previous, next, "\"a\"");
+        table.linkStates(previous, next, "\"b\"");
+        previous = next;
+    }
+
+    std::string before = table.toString();
+    EXPECT_FALSE(table.determinize(8));
+    EXPECT_EQ(table.toString(), before);
+
+    ASSERT_TRUE(table.determinize(64));
+    table.minimize();
+    EXPECT_EQ(table.getUsedStatesCount(), 17);
+}
@@ -3,7 +3,10 @@
 #include <syngt/core/NTListItem.h>
 #include <syngt/analysis/Minimize.h>
 
+#include "common/REMatch.h"
+
 using namespace syngt;
+using namespace syngt::test;
 
 class MinimizeTest : public ::testing::Test {
 protected:
@@ -81,3 +84,141 @@ TEST_F(MinimizeTest, RegularizedGrammarCanBeMinimized) {
     ASSERT_NE(e, nullptr);
     EXPECT_TRUE(e->hasRoot());
 }
+
+TEST_F(MinimizeTest, IterationDoesNotLeakIntoSiblingAlternatives) {
+    for (MinimizeAutomaton automaton : {maNFA, maDFA, maSmallest}) {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+        grammar->addNonTerminal("S");
+        grammar->setNTRule("S", "'a' , 'b' ; 'c' *.");
+
+        MinimizeOptions options;
+        options.automaton = automaton;
+        Minimize::minimize(grammar.get(), options);
+
+        EXPECT_TRUE(accepts(grammar.get(), "S", {"a", "b"})) << automaton;
+        EXPECT_TRUE(accepts(grammar.get(), "S", {}));
+        EXPECT_TRUE(accepts(grammar.get(), "S", {"c", "c"}));
+        EXPECT_FALSE(accepts(grammar.get(), "S", {"c", "a", "b"})) << automaton;
+        EXPECT_FALSE(accepts(grammar.get(), "S", {"a", "b", "c"})) << automaton;
+    }
+}
+
+TEST_F(MinimizeTest, DeterminizedRulePreservesLanguage) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' ; 'b') * , 'a' , ('a' ; 'b').");
+
+    MinimizeOptions options;
+    options.automaton = maDFA;
+    MinimizeStats stats = Minimize::minimize(grammar.get(), options);
+
+    EXPECT_EQ(stats.rules, 1);
+    EXPECT_EQ(stats.budgetExceeded, 0);
+    // Minimal DFA for "second to last symbol is 'a'" has four states plus FinalState
+    EXPECT_EQ(stats.minimizedStates, 5);
+
+    EXPECT_TRUE(accepts(grammar.get(), "S", {"a", "a"}));
+    EXPECT_TRUE(accepts(grammar.get(), "S", {"b", "a", "b"}));
+    EXPECT_FALSE(accepts(grammar.get(), "S", {"a", "b", "b"}));
+    EXPECT_FALSE(accepts(grammar.get(), "S", {"a"}));
+}
+
+TEST_F(MinimizeTest, SmallestNeverGrowsOverNFA) {
+    grammar->addNonTerminal("E");
+    grammar->setNTRule("E", "('+' ; @) , ('n' ; 'm') , ('x' , 'n' ; 'x' , 'm') *.");
+
+    auto nfaGrammar = std::make_unique<Grammar>();
+    nfaGrammar->fillNew();
+    nfaGrammar->addNonTerminal("E");
+    nfaGrammar->setNTRule("E", "('+' ; @) , ('n' ; 'm') , ('x' , 'n' ; 'x' , 'm') *.");
+
+    MinimizeOptions nfaOptions;
+    nfaOptions.automaton = maNFA;
+    Minimize::minimize(nfaGrammar.get(), nfaOptions);
+    Minimize::minimize(grammar.get());
+
+    EXPECT_LE(grammar->getNTItem("E")->root()->getOperationCount(),
+              nfaGrammar->getNTItem("E")->root()->getOperationCount());
+    EXPECT_TRUE(accepts(grammar.get(), "E", {"+", "n", "x", "m"}));
+    EXPECT_FALSE(accepts(grammar.get(), "E", {"+", "x", "m"}));
+}
+
+TEST_F(MinimizeTest, GlushkovConstructionPreservesLanguage) {
+    const char* rules[] = {
+        "('a' ; @) # ('b' ; @) , 'c'.",
+        "'a' , 'b' ; 'c' *.",
+        "('a' # 'b') , ('c' ; $act) * , 'a'.",
+        "(@ ; 'a' , 'b') # 'c' ; 'b' , 'b'.",
+    };
+    auto words = allWords({"a", "b", "c"}, 5);
+
+    for (const char* rule : rules) {
+        for (MinimizeAutomaton automaton : {maNFA, maDFA}) {
+            auto original = std::make_unique<Grammar>();
+            original->fillNew();
+            original->addNonTerminal("S");
+            original->setNTRule("S", rule);
+
+            grammar = std::make_unique<Grammar>();
+            grammar->fillNew();
+            grammar->addNonTerminal("S");
+            grammar->setNTRule("S", rule);
+
+            MinimizeOptions options;
+            options.automaton = automaton;
+            options.construction = mcGlushkov;
+            Minimize::minimize(grammar.get(), options);
+
+            for (const auto& word : words) {
+                ASSERT_EQ(accepts(grammar.get(), "S", word), accepts(original.get(), "S", word))
+                    << rule << ", automaton " << automaton;
+            }
+        }
+    }
+}
+
+TEST_F(MinimizeTest, GlushkovHasOneStatePerSymbol) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , ('b' ; @) , 'c' * , 'd'.");
+
+    MinimizeOptions options;
+    options.automaton = maNFA;
+    options.construction = mcGlushkov;
+    MinimizeStats stats = Minimize::minimize(grammar.get(), options);
+
+    // Four positions plus StartState and FinalState
+    EXPECT_EQ(stats.nfaStates, 6);
+    EXPECT_TRUE(accepts(grammar.get(), "S", {"a", "c", "c", "d"}));
+    EXPECT_TRUE(accepts(grammar.get(), "S", {"a", "b", "d"}));
+    EXPECT_FALSE(accepts(grammar.get(), "S", {"a", "b", "b", "d"}));
+}
+
+TEST_F(MinimizeTest, ParallelMatchesSequential) {
+    auto load = [](Grammar& target) {
+        target.fillNew();
+        for (int i = 0; i < 40; ++i) {
+            std::string name = "R" + std::to_string(i);
+            target.addNonTerminal(name);
+            target.setNTRule(name, "('a' , R" + std::to_string((i + 1) % 40) +
+                                   " ; 'b' , $s" + std::to_string(i % 3) + ") * , ('c' ; 'a' , 'c') # 'd'.");
+        }
+    };
+
+    Grammar sequential, parallel;
+    load(sequential);
+    load(parallel);
+
+    MinimizeOptions options;
+    MinimizeStats sequentialStats = Minimize::minimize(&sequential, options);
+    options.threads = 4;
+    MinimizeStats parallelStats = Minimize::minimize(&parallel, options);
+
+    EXPECT_EQ(parallelStats.rules, 40);
+    EXPECT_EQ(parallelStats.nfaStates, sequentialStats.nfaStates);
+    EXPECT_EQ(parallelStats.minimizedStates, sequentialStats.minimizedStates);
+    EXPECT_EQ(parallelStats.dfaChosen, sequentialStats.dfaChosen);
+    ASSERT_EQ(parallel.getNonTerminals(), sequential.getNonTerminals());
+    for (const auto& name : sequential.getNonTerminals()) {
+        EXPECT_EQ(parallel.getNTItem(name)->value(), sequential.getNTItem(name)->value()) << name;
+    }
+}
@@ -2,6 +2,8 @@
 #include <syngt/core/Grammar.h>
 #include <syngt/analysis/RecursionAnalyzer.h>
 
+#include <chrono>
+
 using namespace syngt;
 
 class RecursionAnalyzerTest : public ::testing::Test {
@@ -121,3 +123,105 @@ TEST_F(RecursionAnalyzerTest, ResultCountMatchesNTs) {
 TEST_F(RecursionAnalyzerTest, EmptyGrammarDoesNotCrash) {
     EXPECT_NO_THROW(RecursionAnalyzer::analyze(grammar.get()));
 }
+
+// ---------------------------------------------------------------------------
+// Nullable prefixes and suffixes
+// ---------------------------------------------------------------------------
+
+TEST_F(RecursionAnalyzerTest, LeftRecursionThroughNullablePrefix) {
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->setNTRule("A", "B , A , 'x' ; 'y'.");
+    grammar->setNTRule("B", "'b' ; @.");
+
+    auto results = RecursionAnalyzer::analyze(grammar.get());
+    const RecursionResult* r = findResult(results, "A");
+    ASSERT_NE(r, nullptr);
+
+    EXPECT_EQ(r->leftRecursion, "direct");
+    EXPECT_TRUE(r->rightRecursion.empty());
+    EXPECT_EQ(r->anyRecursion, "direct");
+}
+
+TEST_F(RecursionAnalyzerTest, EmptyAlternativeIsNullable) {
+    // S : (@ ; 'a') , S , ('b' ; @) ; 'c'.
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "(@ ; 'a') , S , ('b' ; @) ; 'c'.");
+
+    auto results = RecursionAnalyzer::analyze(grammar.get());
+    const RecursionResult* r = findResult(results, "S");
+    ASSERT_NE(r, nullptr);
+
+    EXPECT_EQ(r->leftRecursion, "direct");
+    EXPECT_EQ(r->rightRecursion, "direct");
+}
+
+// ---------------------------------------------------------------------------
+// Indirect recursion
+// ---------------------------------------------------------------------------
+
+TEST_F(RecursionAnalyzerTest, IndirectLeftRecursion) {
+    // A : B , 'a' ; 'x'.  B : A , 'b'.  C : 'c' , A.
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->addNonTerminal("C");
+    grammar->setNTRule("A", "B , 'a' ; 'x'.");
+    grammar->setNTRule("B", "A , 'b'.");
+    grammar->setNTRule("C", "'c' , A.");
+
+    auto results = RecursionAnalyzer::analyze(grammar.get());
+    const RecursionResult* ra = findResult(results, "A");
+    const RecursionResult* rb = findResult(results, "B");
+    const RecursionResult* rc = findResult(results, "C");
+    ASSERT_NE(ra, nullptr);
+    ASSERT_NE(rb, nullptr);
+    ASSERT_NE(rc, nullptr);
+
+    EXPECT_EQ(ra->leftRecursion, "indirect");
+    EXPECT_EQ(rb->leftRecursion, "indirect");
+    EXPECT_TRUE(ra->rightRecursion.empty());
+    // C reaches the cycle but is not part of it
+    EXPECT_TRUE(rc->anyRecursion.empty());
+}
+
+TEST_F(RecursionAnalyzerTest, CentralRecursionIsOnlyAny) {
+    grammar->addNonTerminal("P");
+    grammar->setNTRule("P", "'(' , P , ')' ; 'x'.");
+
+    auto results = RecursionAnalyzer::analyze(grammar.get());
+    const RecursionResult* r = findResult(results, "P");
+    ASSERT_NE(r, nullptr);
+
+    EXPECT_EQ(r->anyRecursion, "direct");
+    EXPECT_TRUE(r->leftRecursion.empty());
+    EXPECT_TRUE(r->rightRecursion.empty());
+}
+
+// ---------------------------------------------------------------------------
+// Large grammars
+// ---------------------------------------------------------------------------
+
+TEST_F(RecursionAnalyzerTest, LongChainIsFast) {
+    // N0 : N1 , 'a'.  N1 : N2 , 'a'. ...  N(k-1) : N0 , 'a' ; 'b'.
+    const int count = 5000;
+    for (int i = 0; i < count; ++i) {
+        grammar->addNonTerminal("N" + std::to_string(i));
+    }
+    for (int i = 0; i + 1 < count; ++i) {
+        grammar->setNTRule("N" + std::to_string(i), "N" + std::to_string(i + 1) + " , 'a'.");
+    }
+    grammar->setNTRule("N" + std::to_string(count - 1), "N0 , 'a' ; 'b'.");
+
+    auto started = std::chrono::steady_clock::now();
+    auto results = RecursionAnalyzer::analyze(grammar.get());
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count(), 5);
+    const RecursionResult* first = findResult(results, "N0");
+    const RecursionResult* middle = findResult(results, "N" + std::to_string(count / 2));
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(middle, nullptr);
+    EXPECT_EQ(first->leftRecursion, "indirect");
+    EXPECT_EQ(middle->leftRecursion, "indirect");
+    EXPECT_TRUE(middle->rightRecursion.empty());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/analysis/ReferenceGraph.h>
+
+#include <algorithm>
+
+using namespace syngt;
+
+class ReferenceGraphTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    int id(const std::string& name) const {
+        auto names = grammar->getNonTerminals();
+        return static_cast<int>(std::find(names.begin(), names.end(), name) - names.begin());
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(ReferenceGraphTest, PositionsSelectEdges) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->addNonTerminal("C");
+    grammar->setNTRule("S", "A , B , C.");
+    grammar->setNTRule("A", "'a'.");
+    grammar->setNTRule("B", "'b' ; @.");
+    grammar->setNTRule("C", "'c'.");
+
+    auto anywhere = ReferenceGraph::build(grammar.get());
+    auto leftmost = ReferenceGraph::build(grammar.get(), rpLeftmost);
+    auto rightmost = ReferenceGraph::build(grammar.get(), rpRightmost);
+
+    std::vector<int> all{id("A"), id("B"), id("C")};
+    std::sort(all.begin(), all.end());
+    EXPECT_EQ(anywhere.successors(id("S")), all);
+    EXPECT_EQ(leftmost.successors(id("S")), std::vector<int>{id("A")});
+    EXPECT_EQ(rightmost.successors(id("S")), std::vector<int>{id("C")});
+    EXPECT_TRUE(anywhere.successors(id("B")).empty());
+}
+
+TEST_F(ReferenceGraphTest, IterationSeparatorIsNotLeftmost) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("X");
+    grammar->setNTRule("S", "'a' # X.");
+    grammar->setNTRule("X", "'x'.");
+
+    EXPECT_TRUE(ReferenceGraph::build(grammar.get(), rpLeftmost).successors(id("S")).empty());
+    EXPECT_TRUE(ReferenceGraph::build(grammar.get(), rpRightmost).successors(id("S")).empty());
+    EXPECT_EQ(ReferenceGraph::build(grammar.get()).successors(id("S")), std::vector<int>{id("X")});
+}
+
+TEST_F(ReferenceGraphTest, ComponentsComeAfterTheirSuccessors) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->addNonTerminal("C");
+    grammar->setNTRule("S", "A.");
+    grammar->setNTRule("A", "'a' , B ; C.");
+    grammar->setNTRule("B", "A , 'b'.");
+    grammar->setNTRule("C", "C , 'c' ; 'd'.");
+
+    auto graph = ReferenceGraph::build(grammar.get());
+    auto components = graph.stronglyConnectedComponents();
+    ASSERT_EQ(components.size(), 3u);
+
+    auto position = [&](int nt) {
+        for (size_t i = 0; i < components.size(); ++i) {
+            if (std::find(components[i].begin(), components[i].end(), nt) != components[i].end()) {
+                return i;
+            }
+        }
+        return components.size();
+    };
+    EXPECT_EQ(position(id("A")), position(id("B")));
+    EXPECT_LT(position(id("C")), position(id("A")));
+    EXPECT_LT(position(id("A")), position(id("S")));
+    EXPECT_TRUE(graph.hasSelfLoop(id("C")));
+    EXPECT_FALSE(graph.hasSelfLoop(id("A")));
+}
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/analysis/RegularSubgrammar.h>
+#include <syngt/analysis/TokenDFA.h>
+
+#include "common/REMatch.h"
+
+#include <utility>
+
+using namespace syngt;
+using namespace syngt::test;
+
+class RegularSubgrammarTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    void define(const std::vector<std::pair<std::string, std::string>>& rules) {
+        for (const auto& rule : rules) grammar->addNonTerminal(rule.first);
+        for (const auto& rule : rules) grammar->setNTRule(rule.first, rule.second);
+    }
+
+    int id(const std::string& name) const {
+        return grammar->findNonTerminal(name);
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(RegularSubgrammarTest, QualifiedNameCompilesToOneDFA) {
+    define({
+        {"qualified", "ident , @*( '.' , ident )."},
+        {"ident", "LETTER , @*( LETTER ; DIGIT ; '_' )."},
+    });
+
+    auto result = RegularSubgrammar::analyze(grammar.get());
+
+    EXPECT_EQ(result.status(id("qualified")), rsRegular);
+    EXPECT_EQ(result.status(id("ident")), rsRegular);
+    EXPECT_EQ(result.status(id("LETTER")), rsUndefined);
+    EXPECT_EQ(result.regularNonTerminals().size(), 2u);
+
+    const TokenDFA* dfa = result.dfa(id("qualified"));
+    ASSERT_NE(dfa, nullptr);
+    EXPECT_TRUE(dfa->matches(std::vector<std::string>{"LETTER"}));
+    EXPECT_TRUE(dfa->matches(std::vector<std::string>{"LETTER", "DIGIT", ".", "LETTER", "_"}));
+    EXPECT_FALSE(dfa->matches(std::vector<std::string>{"LETTER", "."}));
+    EXPECT_FALSE(dfa->matches(std::vector<std::string>{"DIGIT"}));
+    EXPECT_FALSE(dfa->matches(std::vector<std::string>{}));
+
+    // The start state and the state after a dot both expect a LETTER and merge
+    EXPECT_EQ(dfa->stateCount(), 2);
+
+    int letter = dfa->symbolIndex("LETTER");
+    int dot = dfa->terminalIndex(".");
+    int plus = dfa->terminalIndex("+");
+    ASSERT_GE(letter, 0);
+    ASSERT_GE(dot, 0);
+    EXPECT_EQ(plus, -1);
+    EXPECT_EQ(dfa->longestMatch({letter, dot, letter, dot, dot}), 3u);
+    EXPECT_EQ(dfa->longestMatch({dot, letter, letter}, 1), 2u);
+    EXPECT_EQ(dfa->longestMatch({dot, letter}), TokenDFA::NoMatch);
+}
+
+TEST_F(RegularSubgrammarTest, LinearRecursionIsSolved) {
+    define({
+        {"list", "'x' , tail."},
+        {"tail", "',' , list ; @."},
+        {"digits", "digits , 'd' ; 'd'."},
+    });
+
+    auto result = RegularSubgrammar::analyze(grammar.get());
+
+    ASSERT_EQ(result.status(id("list")), rsRegular);
+    ASSERT_EQ(result.status(id("tail")), rsRegular);
+    ASSERT_EQ(result.status(id("digits")), rsRegular);
+
+    const TokenDFA* list = result.dfa(id("list"));
+    EXPECT_TRUE(list->matches(std::vector<std::string>{"x"}));
+    EXPECT_TRUE(list->matches(std::vector<std::string>{"x", ",", "x", ",", "x"}));
+    EXPECT_FALSE(list->matches(std::vector<std::string>{"x", ","}));
+
+    const TokenDFA* tail = result.dfa(id("tail"));
+    EXPECT_TRUE(tail->matches(std::vector<std::string>{}));
+    EXPECT_TRUE(tail->matches(std::vector<std::string>{",", "x"}));
+
+    const TokenDFA* digits = result.dfa(id("digits"));
+    EXPECT_TRUE(digits->matches(std::vector<std::string>{"d", "d", "d"}));
+    EXPECT_FALSE(digits->matches(std::vector<std::string>{}));
+}
+
+TEST_F(RegularSubgrammarTest, SelfEmbeddingIsRejected) {
+    // The calculator grammar: number is a token, expr nests parentheses
+    define({
+        {"expr", "term , @*( '+' , term , $add ; '-' , term , $sub )."},
+        {"term", "factor , @*( '*' , factor , $mul ; '/' , factor , $div )."},
+        {"factor", "'(' , expr , ')' ; number , $push ; '-' , factor , $neg."},
+        {"number", "'DIGIT' , @*( 'DIGIT' , $digit )."},
+        {"stmt", "expr , ';'."},
+        {"pair", "'<' , pairTail."},
+        {"pairTail", "pair , '>' ; '>'."},
+    });
+
+    auto result = RegularSubgrammar::analyze(grammar.get());
+
+    EXPECT_EQ(result.status(id("expr")), rsSelfEmbedding);
+    EXPECT_EQ(result.status(id("term")), rsSelfEmbedding);
+    EXPECT_EQ(result.status(id("factor")), rsSelfEmbedding);
+    EXPECT_EQ(result.status(id("stmt")), rsNonRegularReference);
+    EXPECT_EQ(result.status(id("pair")), rsSelfEmbedding);
+    EXPECT_EQ(result.dfa(id("expr")), nullptr);
+    EXPECT_EQ(result.regex(id("stmt")), nullptr);
+
+    // Semantics are empty for the matcher
+    ASSERT_EQ(result.status(id("number")), rsRegular);
+    EXPECT_TRUE(result.dfa(id("number"))->matches(std::vector<std::string>{"DIGIT", "DIGIT"}));
+    EXPECT_EQ(result.regularNonTerminals(), std::vector<int>{id("number")});
+}
+
+TEST_F(RegularSubgrammarTest, DFAAgreesWithSubstitutedRegex) {
+    define({
+        {"S", "A , 'c' ; B , S ; @."},
+        {"A", "'a' , @*( 'b' ; A2 )."},
+        {"A2", "'c' , 'a' ; @."},
+        {"B", "B , 'b' ; 'a' ; C."},
+        {"C", "'c' , @*( 'a' , 'b' )."},
+    });
+
+    auto result = RegularSubgrammar::analyze(grammar.get());
+
+    const std::vector<std::string> alphabet = {"a", "b", "c"};
+    for (const std::string name : {"S", "A", "B"}) {
+        ASSERT_EQ(result.status(id(name)), rsRegular) << name;
+        const RETree* regex = result.regex(id(name));
+        const TokenDFA* dfa = result.dfa(id(name));
+        ASSERT_NE(regex, nullptr);
+        ASSERT_NE(dfa, nullptr);
+
+        // Nonterminals left in the RE have no rule and are matched as symbols
+        auto words = allWords(alphabet, 5);
+        for (size_t i = 0; i < words.size(); ++i) {
+            EXPECT_EQ(dfa->matches(words[i]), accepts(grammar.get(), regex, words[i], nmSymbol))
+                << name << " word " << i;
+        }
+    }
+
+    // Spot checks against the grammar itself
+    const TokenDFA* s = result.dfa(id("S"));
+    EXPECT_TRUE(s->matches(std::vector<std::string>{}));
+    EXPECT_TRUE(s->matches(std::vector<std::string>{"a", "b", "a", "c"}));
+    EXPECT_TRUE(s->matches(std::vector<std::string>{"c", "a", "b", "a", "c", "a", "c"}));
+    EXPECT_TRUE(s->matches(std::vector<std::string>{"a", "b"}));
+    EXPECT_FALSE(s->matches(std::vector<std::string>{"b"}));
+}
+
+TEST_F(RegularSubgrammarTest, BudgetsMarkTooLarge) {
+    define({
+        {"word", "letters , '!'."},
+        {"letters", "'a' , @*( 'a' ; 'b' )."},
+    });
+
+    RegularSubgrammarOptions options;
+    options.maxDfaStates = 1;
+    auto small = RegularSubgrammar::analyze(grammar.get(), options);
+    EXPECT_EQ(small.status(id("letters")), rsTooLarge);
+    EXPECT_EQ(small.status(id("word")), rsTooLarge);
+    EXPECT_EQ(small.dfa(id("letters")), nullptr);
+
+    options = RegularSubgrammarOptions();
+    options.maxNodes = 4;
+    auto narrow = RegularSubgrammar::analyze(grammar.get(), options);
+    EXPECT_EQ(narrow.status(id("word")), rsTooLarge);
+    EXPECT_EQ(narrow.regex(id("word")), nullptr);
+}
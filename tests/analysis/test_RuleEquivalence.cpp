@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/analysis/RuleEquivalence.h>
+#include <syngt/analysis/Minimize.h>
+#include <syngt/transform/LeftFactorization.h>
+
+using namespace syngt;
+
+class RuleEquivalenceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    EquivalenceResult compare(const std::string& first, const std::string& second) {
+        grammar->addNonTerminal("First");
+        grammar->addNonTerminal("Second");
+        grammar->setNTRule("First", first);
+        grammar->setNTRule("Second", second);
+        return RuleEquivalence::check(grammar->getNTItem("First")->root(), grammar.get(),
+                                      grammar->getNTItem("Second")->root(), grammar.get());
+    }
+
+    static void load(Grammar& target) {
+        target.fillNew();
+        target.addNonTerminal("S");
+        target.addNonTerminal("T");
+        target.setNTRule("S", "'a' , 'b' , T ; 'a' , 'c' ; 'a' , 'b' , 'd'.");
+        target.setNTRule("T", "('x' ; @) # ',' , $done.");
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(RuleEquivalenceTest, AlgebraicIdentities) {
+    EXPECT_TRUE(compare("'a' ; 'b'.", "'b' ; 'a'.").equivalent);
+    EXPECT_TRUE(compare("('a' *) *.", "'a' *.").equivalent);
+    EXPECT_TRUE(compare("'a' # 'b'.", "'a' , ('b' , 'a') *.").equivalent);
+    EXPECT_TRUE(compare("'a' , 'b' ; 'a' , 'c'.", "'a' , ('b' ; 'c').").equivalent);
+    EXPECT_TRUE(compare("('a' ; 'b') *.", "('a' * , 'b' *) *.").equivalent);
+    EXPECT_TRUE(compare("@ , 'a' ; @.", "('a' ; @).").equivalent);
+}
+
+TEST_F(RuleEquivalenceTest, ShortestCounterexample) {
+    EquivalenceResult result = compare("('a' ; 'b') * , 'a'.", "('a' ; 'b') * , 'b'.");
+    EXPECT_FALSE(result.equivalent);
+    EXPECT_TRUE(result.complete);
+    ASSERT_EQ(result.counterexample.size(), 1u);
+    EXPECT_EQ(result.acceptedByFirst, result.counterexample[0] == "'a'");
+}
+
+TEST_F(RuleEquivalenceTest, EmptyWordCounterexample) {
+    EquivalenceResult result = compare("'a' *.", "'a' #@.");
+    EXPECT_FALSE(result.equivalent);
+    EXPECT_TRUE(result.counterexample.empty());
+    EXPECT_TRUE(result.acceptedByFirst);
+    EXPECT_EQ(RuleEquivalence::wordToString(result.counterexample), "@");
+}
+
+TEST_F(RuleEquivalenceTest, NonTerminalsAndSemanticsAreSymbols) {
+    EquivalenceResult result = compare("'a' , B.", "'a' , $act.");
+    EXPECT_FALSE(result.equivalent);
+    EXPECT_EQ(RuleEquivalence::wordToString(result.counterexample).substr(0, 4), "'a' ");
+    EXPECT_FALSE(compare("$act ; 'a'.", "'a'.").equivalent);
+}
+
+TEST_F(RuleEquivalenceTest, StateLimitGivesIncompleteResult) {
+    // The DFA of "fifth symbol from the end is 'a'" needs 2^5 states
+    std::string rule = "('a' ; 'b') * , 'a' , ('a' ; 'b') , ('a' ; 'b') , ('a' ; 'b') , ('a' ; 'b').";
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", rule);
+    const RETree* root = grammar->getNTItem("S")->root();
+
+    EXPECT_TRUE(RuleEquivalence::check(root, grammar.get(), root, grammar.get()).complete);
+    EquivalenceResult limited = RuleEquivalence::check(root, grammar.get(), root, grammar.get(), 8);
+    EXPECT_FALSE(limited.complete);
+}
+
+TEST_F(RuleEquivalenceTest, VerifyMinimizedGrammar) {
+    Grammar original, minimized;
+    load(original);
+    load(minimized);
+    Minimize::minimize(&minimized);
+
+    auto results = RuleEquivalence::verify(&original, &minimized);
+    ASSERT_EQ(results.size(), 2u);
+    for (const auto& rule : results) {
+        EXPECT_FALSE(rule.missing);
+        EXPECT_TRUE(rule.result.equivalent) << rule.name;
+    }
+}
+
+TEST_F(RuleEquivalenceTest, VerifyInlinesAuxiliaryRules) {
+    Grammar original, factorized;
+    load(original);
+    load(factorized);
+    LeftFactorization::factorizeAll(&factorized);
+    ASSERT_GT(factorized.getNonTerminals().size(), original.getNonTerminals().size());
+
+    for (const auto& rule : RuleEquivalence::verify(&original, &factorized)) {
+        EXPECT_TRUE(rule.result.equivalent) << rule.name;
+    }
+}
+
+TEST_F(RuleEquivalenceTest, VerifyReportsChangedAndMissingRules) {
+    Grammar original, changed;
+    load(original);
+    changed.fillNew();
+    changed.addNonTerminal("S");
+    changed.setNTRule("S", "'a' , 'b' , T ; 'a' , 'c'.");
+
+    auto results = RuleEquivalence::verify(&original, &changed, 4);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].name, "S");
+    EXPECT_FALSE(results[0].result.equivalent);
+    EXPECT_TRUE(results[0].result.acceptedByFirst);
+    EXPECT_EQ(RuleEquivalence::wordToString(results[0].result.counterexample), "'a' 'b' 'd'");
+    EXPECT_EQ(results[1].name, "T");
+    EXPECT_TRUE(results[1].missing);
+}
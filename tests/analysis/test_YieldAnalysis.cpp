@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/analysis/YieldAnalysis.h>
+
+using namespace syngt;
+
+class YieldAnalysisTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    int t(const std::string& name) { return grammar->findTerminal(name); }
+
+    const NTYield& entry(const YieldAnalysis::Table& table, const std::string& name) {
+        return table[grammar->findNonTerminal(name)];
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(YieldAnalysisTest, SequenceYield) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' , 'c'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    const auto& s = entry(table, "S");
+    EXPECT_TRUE(s.productive);
+    EXPECT_EQ(s.minYield, (std::vector<int>{t("a"), t("b"), t("c")}));
+    EXPECT_EQ(s.minLength, 3u);
+    EXPECT_EQ(s.maxLength, 3u);
+}
+
+TEST_F(YieldAnalysisTest, ShortestAlternativeChosen) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "'x' , 'y' , 'z' ; A.");
+    grammar->setNTRule("A", "'a' , 'b'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    const auto& s = entry(table, "S");
+    EXPECT_EQ(s.minYield, (std::vector<int>{t("a"), t("b")}));
+    EXPECT_EQ(s.minLength, 2u);
+    EXPECT_EQ(s.maxLength, 3u);
+}
+
+TEST_F(YieldAnalysisTest, MinHeightBreaksLengthTies) {
+    // Both alternatives of A yield one terminal; the one without B is lower
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->setNTRule("A", "B ; 'a' , @.");
+    grammar->setNTRule("B", "'b'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    EXPECT_EQ(entry(table, "B").minHeight, 1u);
+    EXPECT_EQ(entry(table, "A").minHeight, 1u);
+    EXPECT_EQ(entry(table, "A").minYield, std::vector<int>{t("a")});
+
+    grammar->setNTRule("A", "B , @ ; 'a' , A.");
+    table = YieldAnalysis::compute(grammar.get());
+    EXPECT_EQ(entry(table, "A").minHeight, 2u);
+    EXPECT_EQ(entry(table, "A").minYield, std::vector<int>{t("b")});
+}
+
+TEST_F(YieldAnalysisTest, SemanticsAndEpsilonAreEmpty) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "$act , @ , 'a'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    EXPECT_EQ(entry(table, "S").minYield, std::vector<int>{t("a")});
+}
+
+TEST_F(YieldAnalysisTest, IterationMayRepeatZeroTimes) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' * , 'b'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    const auto& s = entry(table, "S");
+    EXPECT_EQ(s.minYield, std::vector<int>{t("b")});
+    EXPECT_EQ(s.maxLength, YieldAnalysis::Infinite);
+}
+
+TEST_F(YieldAnalysisTest, RecursionPumpsLength) {
+    grammar->addNonTerminal("E");
+    grammar->setNTRule("E", "E , '+' , 'n' ; 'n'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    const auto& e = entry(table, "E");
+    EXPECT_EQ(e.minYield, std::vector<int>{t("n")});
+    EXPECT_EQ(e.maxLength, YieldAnalysis::Infinite);
+}
+
+TEST_F(YieldAnalysisTest, UnitCycleDoesNotPump) {
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->setNTRule("A", "B ; 'a'.");
+    grammar->setNTRule("B", "A ; 'b' , 'b'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    EXPECT_EQ(entry(table, "A").maxLength, 2u);
+    EXPECT_EQ(entry(table, "B").maxLength, 2u);
+    EXPECT_EQ(entry(table, "B").minLength, 1u);
+}
+
+TEST_F(YieldAnalysisTest, EmptyIterationBodyDoesNotPump) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , $act *.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    EXPECT_EQ(entry(table, "S").maxLength, 1u);
+}
+
+TEST_F(YieldAnalysisTest, UnproductiveNonTerminal) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "'a' ; A , 'b'.");
+    grammar->setNTRule("A", "A , 'c'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    EXPECT_FALSE(entry(table, "A").productive);
+    EXPECT_TRUE(entry(table, "S").productive);
+    EXPECT_EQ(entry(table, "S").maxLength, 1u);
+}
+
+TEST_F(YieldAnalysisTest, MinYieldOfSubtree) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "A , 'x'.");
+    grammar->setNTRule("A", "'a' ; 'b' , 'c'.");
+
+    auto table = YieldAnalysis::compute(grammar.get());
+    auto yield = YieldAnalysis::minYieldOf(grammar->getNTItem("S")->root(), table, grammar.get());
+    ASSERT_TRUE(yield.has_value());
+    EXPECT_EQ(*yield, (std::vector<int>{t("a"), t("x")}));
+}
+
+TEST_F(YieldAnalysisTest, CacheInvalidatedByRuleChange) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b'.");
+
+    auto first = YieldAnalysis::analyze(grammar.get());
+    auto again = YieldAnalysis::analyze(grammar.get());
+    EXPECT_EQ(first.get(), again.get());
+
+    grammar->setNTRule("S", "'a'.");
+    auto changed = YieldAnalysis::analyze(grammar.get());
+    EXPECT_NE(first.get(), changed.get());
+    EXPECT_EQ((*changed)[0].minLength, 1u);
+}
+
+TEST_F(YieldAnalysisTest, NullGrammar) {
+    EXPECT_TRUE(YieldAnalysis::compute(nullptr).empty());
+    EXPECT_TRUE(YieldAnalysis::analyze(nullptr)->empty());
+}
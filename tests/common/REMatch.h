@@ -0,0 +1,112 @@
+#pragma once
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REOr.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REIteration.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RESemantic.h>
+#include <syngt/regex/RENonTerminal.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+// Brute-force matcher for checking languages of RE trees in tests
+
+namespace syngt::test {
+
+enum NTMatch {
+    nmSymbol = 0,   // A nonterminal matches one word symbol equal to its name
+    nmExpand = 1    // A nonterminal matches its rule, expanded up to a depth limit
+};
+
+// Positions where a match of tree starting at 'start' can end.
+// Semantics and the empty terminal match the empty word; with nmExpand
+// nonterminals are expanded at most 'depth' levels deep
+inline std::set<size_t> matchEnds(Grammar* grammar, const RETree* tree,
+                                  const std::vector<std::string>& word, size_t start,
+                                  NTMatch nonTerminals = nmSymbol, int depth = 0) {
+    if (auto* orNode = dynamic_cast<const REOr*>(tree)) {
+        auto result = matchEnds(grammar, orNode->left(), word, start, nonTerminals, depth);
+        auto right = matchEnds(grammar, orNode->right(), word, start, nonTerminals, depth);
+        result.insert(right.begin(), right.end());
+        return result;
+    }
+    if (auto* andNode = dynamic_cast<const REAnd*>(tree)) {
+        std::set<size_t> result;
+        for (size_t middle : matchEnds(grammar, andNode->left(), word, start, nonTerminals, depth)) {
+            auto right = matchEnds(grammar, andNode->right(), word, middle, nonTerminals, depth);
+            result.insert(right.begin(), right.end());
+        }
+        return result;
+    }
+    if (auto* iterNode = dynamic_cast<const REIteration*>(tree)) {
+        auto result = matchEnds(grammar, iterNode->left(), word, start, nonTerminals, depth);
+        std::vector<size_t> pending(result.begin(), result.end());
+        while (!pending.empty()) {
+            size_t position = pending.back();
+            pending.pop_back();
+            for (size_t middle : matchEnds(grammar, iterNode->right(), word, position, nonTerminals, depth)) {
+                for (size_t end : matchEnds(grammar, iterNode->left(), word, middle, nonTerminals, depth)) {
+                    if (result.insert(end).second) pending.push_back(end);
+                }
+            }
+        }
+        return result;
+    }
+    if (auto* nt = dynamic_cast<const RENonTerminal*>(tree)) {
+        if (nonTerminals == nmSymbol) {
+            if (start < word.size() && word[start] == grammar->getNonTerminalName(nt->getID())) {
+                return {start + 1};
+            }
+            return {};
+        }
+        const RETree* rule = grammar->getNTItemByIndex(nt->getID())->root();
+        if (depth == 0 || !rule) return {};
+        return matchEnds(grammar, rule, word, start, nonTerminals, depth - 1);
+    }
+    if (auto* term = dynamic_cast<const RETerminal*>(tree)) {
+        std::string name = grammar->terminals()->getRawString(term->getID());
+        if (name.empty()) return {start};
+        if (start < word.size() && word[start] == name) return {start + 1};
+        return {};
+    }
+    if (dynamic_cast<const RESemantic*>(tree)) return {start};
+    return {};
+}
+
+// Whole word matches tree; with nmExpand the depth limit grows with the
+// word length and the number of nonterminals
+inline bool accepts(Grammar* grammar, const RETree* tree, const std::vector<std::string>& word,
+                    NTMatch nonTerminals = nmSymbol) {
+    const int depth = 3 * static_cast<int>(word.size() + 1) *
+                      static_cast<int>(grammar->getNonTerminals().size());
+    return matchEnds(grammar, tree, word, 0, nonTerminals, depth).count(word.size()) > 0;
+}
+
+inline bool accepts(Grammar* grammar, const std::string& nt, const std::vector<std::string>& word,
+                    NTMatch nonTerminals = nmSymbol) {
+    return accepts(grammar, grammar->getNTItem(nt)->root(), word, nonTerminals);
+}
+
+// All words over the alphabet up to maxLength symbols, shortest first
+inline std::vector<std::vector<std::string>> allWords(const std::vector<std::string>& alphabet,
+                                                      size_t maxLength) {
+    std::vector<std::vector<std::string>> words{{}};
+    for (size_t begin = 0; words.back().size() < maxLength; ) {
+        size_t end = words.size();
+        for (size_t i = begin; i < end; ++i) {
+            for (const auto& symbol : alphabet) {
+                auto word = words[i];
+                word.push_back(symbol);
+                words.push_back(word);
+            }
+        }
+        begin = end;
+    }
+    return words;
+}
+
+}
@@ -135,4 +135,18 @@ TEST(GrammarTest, LoadLANGGRM) {
     EXPECT_EQ(nts[1], "initiations");
     
     EXPECT_TRUE(grammar.hasRule("program"));
-}
\ No newline at end of file
+}
+
+TEST(GrammarTest, FreshNonTerminalNameSkipsTakenNames) {
+    Grammar grammar;
+    grammar.fillNew();
+    grammar.addNonTerminal("A");
+    grammar.addNonTerminal("tmp_2");
+    grammar.addNonTerminal("tmp_3");
+
+    int count = static_cast<int>(grammar.getNonTerminals().size());
+    ASSERT_EQ(count, 3);
+    EXPECT_EQ(grammar.freshNonTerminalName("tmp"), "tmp_4");
+    EXPECT_EQ(grammar.freshNonTerminalName("other"), "other_3");
+    EXPECT_EQ(static_cast<int>(grammar.getNonTerminals().size()), count);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/GrammarSlice.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/transform/FirstFollow.h>
+#include <syngt/transform/LeftFactorization.h>
+
+#include <chrono>
+#include <stdexcept>
+
+using namespace syngt;
+
+class GrammarSliceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+        // program uses stmt and decl; expr is shared; unused is not reachable from stmt
+        for (const char* name : {"program", "decl", "stmt", "expr", "unused"}) {
+            grammar->addNonTerminal(name);
+        }
+        grammar->setNTRule("program", "decl , stmt.");
+        grammar->setNTRule("decl", "'var' , 'id' , $declare.");
+        grammar->setNTRule("stmt", "'id' , ':=' , expr ; 'if' , expr , 'then' , stmt.");
+        grammar->setNTRule("expr", "'id' # '+'.");
+        grammar->setNTRule("unused", "'u'.");
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(GrammarSliceTest, KeepsOnlyReachableRulesAndSymbols) {
+    GrammarSlice slice = GrammarSlice::extract(grammar.get(), std::vector<std::string>{"stmt"});
+    Grammar* sliced = slice.grammar();
+
+    EXPECT_EQ(sliced->getNonTerminals(), (std::vector<std::string>{"stmt", "expr"}));
+    for (const char* name : {"stmt", "expr"}) {
+        EXPECT_EQ(sliced->getNTItem(name)->root()->toString(SelectionMask{}, false),
+                  grammar->getNTItem(name)->root()->toString(SelectionMask{}, false));
+    }
+    EXPECT_LT(sliced->terminals()->getCount(), grammar->terminals()->getCount());
+    EXPECT_LT(sliced->findTerminal("var"), 0);
+    EXPECT_EQ(sliced->semantics()->getCount(), 0);
+
+    EXPECT_EQ(slice.originalNonTerminal(0), grammar->findNonTerminal("stmt"));
+    EXPECT_EQ(slice.slicedNonTerminal(grammar->findNonTerminal("expr")), 1);
+    EXPECT_EQ(slice.slicedNonTerminal(grammar->findNonTerminal("decl")), -1);
+}
+
+TEST_F(GrammarSliceTest, AnalysesRunOnTheSlice) {
+    GrammarSlice slice = GrammarSlice::extract(grammar.get(), std::vector<std::string>{"program"});
+
+    EXPECT_EQ(slice.grammar()->getNonTerminals().size(), 4u);
+    EXPECT_EQ(slice.grammar()->getNTItem("decl")->value(), "'var','id',$declare");
+    EXPECT_EQ(FirstFollow::isLL1(slice.grammar()), FirstFollow::isLL1(grammar.get()));
+}
+
+TEST_F(GrammarSliceTest, UnknownNameThrows) {
+    EXPECT_THROW(GrammarSlice::extract(grammar.get(), std::vector<std::string>{"missing"}),
+                 std::invalid_argument);
+}
+
+TEST_F(GrammarSliceTest, WriteBackAppliesSliceChanges) {
+    grammar->setNTRule("stmt", "'id' , ':=' , expr ; 'id' , '(' , expr , ')'.");
+    GrammarSlice slice = GrammarSlice::extract(grammar.get(), std::vector<std::string>{"stmt"});
+
+    LeftFactorization::factorizeAll(slice.grammar());
+    ASSERT_GT(slice.grammar()->getNonTerminals().size(), 2u);
+
+    size_t before = grammar->getNonTerminals().size();
+    int written = slice.writeBack(grammar.get());
+
+    EXPECT_EQ(written, static_cast<int>(slice.grammar()->getNonTerminals().size()));
+    EXPECT_EQ(grammar->getNonTerminals().size(), before + slice.grammar()->getNonTerminals().size() - 2);
+    EXPECT_EQ(grammar->getNTItem("stmt")->root()->toString(SelectionMask{}, false),
+              slice.grammar()->getNTItem("stmt")->root()->toString(SelectionMask{}, false));
+    EXPECT_EQ(grammar->getNTItem("decl")->value(), "'var' , 'id' , $declare.");
+}
+
+TEST(GrammarSliceLarge, SmallSliceOfLargeGrammarIsFast) {
+    // 20000 rules in two independent chains; the slice takes the short one
+    const int count = 20000;
+    Grammar large;
+    large.fillNew();
+    for (int i = 0; i < count; ++i) {
+        large.addNonTerminal("N" + std::to_string(i));
+    }
+    for (int i = 0; i < count; ++i) {
+        std::string next = i + 2 < count ? "N" + std::to_string(i + 2) : "'end'";
+        large.setNTRule("N" + std::to_string(i), "'t" + std::to_string(i % 50) + "' , " + next + " ; 'x'.");
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    GrammarSlice slice = GrammarSlice::extract(&large, std::vector<std::string>{"N" + std::to_string(count - 10)});
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 100);
+    EXPECT_EQ(slice.grammar()->getNonTerminals().size(), 5u);
+}
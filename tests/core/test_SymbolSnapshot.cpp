@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/SymbolSnapshot.h>
+
+using namespace syngt;
+
+TEST(SymbolSnapshotTest, FindsGrammarSymbols) {
+    Grammar grammar;
+    grammar.fillNew();
+    grammar.addNonTerminal("S");
+    grammar.setNTRule("S", "'a' , E , $act.");
+
+    SymbolSnapshot symbols(&grammar);
+
+    EXPECT_EQ(symbols.findTerminal(""), 0);
+    EXPECT_EQ(symbols.findTerminal("a"), grammar.findTerminal("a"));
+    EXPECT_EQ(symbols.findNonTerminal("S"), grammar.findNonTerminal("S"));
+    EXPECT_EQ(symbols.findNonTerminal("E"), grammar.findNonTerminal("E"));
+    EXPECT_EQ(symbols.findSemantic("$act"), grammar.findSemantic("$act"));
+    EXPECT_EQ(symbols.findTerminal("b"), -1);
+    EXPECT_EQ(symbols.findSemantic("act"), -1);
+}
+
+TEST(SymbolSnapshotTest, DoesNotSeeLaterSymbols) {
+    Grammar grammar;
+    grammar.fillNew();
+    SymbolSnapshot symbols(&grammar);
+
+    int id = grammar.addTerminal("late");
+    EXPECT_GE(id, 0);
+    EXPECT_EQ(symbols.findTerminal("late"), -1);
+}
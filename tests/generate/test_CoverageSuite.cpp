@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/generate/CoverageSuite.h>
+
+#include <set>
+
+using namespace syngt;
+
+class CoverageSuiteTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    std::set<std::string> sentences(const CoverageReport& report) {
+        std::set<std::string> result;
+        for (const auto& sentence : report.sentences) {
+            result.insert(CoverageSuite::formatSentence(grammar.get(), sentence.tokens));
+        }
+        return result;
+    }
+
+    size_t countKind(const CoverageReport& report, const std::string& kind) {
+        size_t result = 0;
+        for (const auto& goal : report.goals) {
+            if (goal.kind == kind) ++result;
+        }
+        return result;
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(CoverageSuiteTest, OneSentencePerAlternative) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' ; 'b' ; 'c'.");
+
+    auto report = CoverageSuite::build(grammar.get());
+    EXPECT_EQ(countKind(report, "alternative"), 3u);
+    EXPECT_EQ(report.coveredGoals, 3u);
+    EXPECT_EQ(sentences(report), (std::set<std::string>{"a", "b", "c"}));
+}
+
+TEST_F(CoverageSuiteTest, IterationNeedsRepeatAndSkip) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'x' , 'y' * , 'z'.");
+
+    auto report = CoverageSuite::build(grammar.get());
+    EXPECT_EQ(countKind(report, "iteration"), 1u);
+    EXPECT_EQ(countKind(report, "empty iteration"), 1u);
+    EXPECT_EQ(report.coveredGoals, report.goals.size());
+    EXPECT_EQ(sentences(report), (std::set<std::string>{"x z", "x y z"}));
+}
+
+TEST_F(CoverageSuiteTest, SentencesCombineGoals) {
+    // Every candidate covers one goal of each choice, so fewer sentences than goals
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' ; 'b') , ('c' ; 'd').");
+
+    auto report = CoverageSuite::build(grammar.get());
+    EXPECT_EQ(report.goals.size(), 4u);
+    EXPECT_EQ(report.coveredGoals, 4u);
+    EXPECT_LT(report.sentences.size(), report.goals.size());
+}
+
+TEST_F(CoverageSuiteTest, GoalsInsideNestedNonTerminals) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("S", "'(' , A , ')'.");
+    grammar->setNTRule("A", "$act , 'n' ; 'm'.");
+
+    auto report = CoverageSuite::build(grammar.get());
+    EXPECT_EQ(countKind(report, "semantic"), 1u);
+    EXPECT_EQ(report.coveredGoals, report.goals.size());
+    EXPECT_EQ(sentences(report), (std::set<std::string>{"( n )", "( m )"}));
+}
+
+TEST_F(CoverageSuiteTest, RecursiveGrammar) {
+    grammar->addNonTerminal("E");
+    grammar->addNonTerminal("T");
+    grammar->setNTRule("E", "T # ('+' ; '-').");
+    grammar->setNTRule("T", "'n' ; '(' , E , ')'.");
+
+    auto report = CoverageSuite::build(grammar.get());
+    EXPECT_EQ(report.coveredGoals, report.goals.size());
+
+    std::set<size_t> seen;
+    for (const auto& sentence : report.sentences) {
+        EXPECT_FALSE(sentence.newGoals.empty());
+        for (size_t goal : sentence.newGoals) {
+            EXPECT_TRUE(seen.insert(goal).second);
+        }
+    }
+    EXPECT_EQ(seen.size(), report.goals.size());
+}
+
+TEST_F(CoverageSuiteTest, UnreachableAndUnproductiveGoals) {
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("U");
+    grammar->addNonTerminal("L");
+    grammar->setNTRule("S", "'a' ; 'b' , L.");
+    grammar->setNTRule("U", "'u' ; 'v'.");
+    grammar->setNTRule("L", "'c' , L.");
+
+    auto report = CoverageSuite::build(grammar.get());
+    EXPECT_EQ(report.goals.size(), 4u);
+    EXPECT_EQ(report.coveredGoals, 1u);
+    EXPECT_EQ(sentences(report), std::set<std::string>{"a"});
+}
+
+TEST_F(CoverageSuiteTest, NullGrammar) {
+    auto report = CoverageSuite::build(nullptr);
+    EXPECT_TRUE(report.goals.empty());
+    EXPECT_TRUE(report.sentences.empty());
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/generate/SentenceGenerator.h>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+using namespace syngt;
+
+class SentenceGeneratorTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    int t(const std::string& name) { return grammar->findTerminal(name); }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+// ---------------------------------------------------------------------------
+// Counting
+// ---------------------------------------------------------------------------
+
+TEST_F(SentenceGeneratorTest, CountsAlternatives) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' ; 'b' ; 'c' , 'd'.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 3);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(0), 0.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(1), 2.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(2), 1.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(3), 0.0);
+}
+
+TEST_F(SentenceGeneratorTest, CountsIteration) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' ; 'b') *.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 10);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(0), 1.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(5), 32.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(10), 1024.0);
+}
+
+TEST_F(SentenceGeneratorTest, CountsIterationWithSeparator) {
+    // 'x' # ',' = x (, x)*
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'x' # ','.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 6);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(1), 1.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(2), 0.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(3), 1.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(5), 1.0);
+}
+
+TEST_F(SentenceGeneratorTest, CountsCatalan) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'(' , S , ')' , S ; @.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 12);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(2), 1.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(6), 5.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(12), 132.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(7), 0.0);
+}
+
+TEST_F(SentenceGeneratorTest, EmptyCycleThrows) {
+    grammar->addNonTerminal("A");
+    grammar->setNTRule("A", "A ; 'a'.");
+
+    EXPECT_THROW(SentenceGenerator::build(grammar.get(), 5), std::runtime_error);
+}
+
+TEST_F(SentenceGeneratorTest, NoSentencesOfLengthThrows) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b'.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 5);
+    EXPECT_THROW(generator->sentence(3, 1, 0), std::runtime_error);
+    EXPECT_THROW(generator->sentence(6, 1, 0), std::runtime_error);
+}
+
+TEST_F(SentenceGeneratorTest, NonTerminalWithoutRuleDerivesNothing) {
+    // X has no rule: S is unproductive, T only derives 'c'
+    grammar->addNonTerminal("S");
+    grammar->addNonTerminal("T");
+    grammar->setNTRule("S", "'a' , X , 'b' ; T.");
+    grammar->setNTRule("T", "'c' ; 'd' , X.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 4);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(1), 1.0);
+    EXPECT_DOUBLE_EQ(generator->countDerivations(2), 0.0);
+    EXPECT_THROW(generator->sentence(2, 1, 0), std::runtime_error);
+    for (uint64_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(generator->sentence(1, 1, i), std::vector<int>{t("c")});
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Sampling
+// ---------------------------------------------------------------------------
+
+TEST_F(SentenceGeneratorTest, SentencesHaveRequestedLengthAndAreBalanced) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'(' , S , ')' , S ; @.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 40);
+    int open = t("(");
+    for (uint64_t i = 0; i < 200; ++i) {
+        auto sentence = generator->sentence(40, 7, i);
+        ASSERT_EQ(sentence.size(), 40u);
+        int depth = 0;
+        for (int token : sentence) {
+            depth += token == open ? 1 : -1;
+            ASSERT_GE(depth, 0);
+        }
+        EXPECT_EQ(depth, 0);
+    }
+}
+
+TEST_F(SentenceGeneratorTest, SamplingIsUniform) {
+    // Three sentences of length 2; naive expansion would pick 'd' 'e' half the time
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , ('b' ; 'c') ; 'd' , 'e'.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 2);
+    std::map<std::vector<int>, int> histogram;
+    const int samples = 3000;
+    for (int i = 0; i < samples; ++i) {
+        histogram[generator->sentence(2, 42, i)]++;
+    }
+
+    ASSERT_EQ(histogram.size(), 3u);
+    for (const auto& [sentence, hits] : histogram) {
+        EXPECT_NEAR(hits, samples / 3, 150);
+    }
+}
+
+TEST_F(SentenceGeneratorTest, ReproducibleAcrossThreadCounts) {
+    grammar->addNonTerminal("E");
+    grammar->addNonTerminal("T");
+    grammar->setNTRule("E", "T # ('+' ; '-').");
+    grammar->setNTRule("T", "'n' ; '(' , E , ')'.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 15);
+
+    GeneratorOptions options;
+    options.length = 15;
+    options.count = 3000;
+    options.seed = 123;
+
+    std::ostringstream single, parallel;
+    options.threads = 1;
+    generator->generate(single, options);
+    options.threads = 4;
+    generator->generate(parallel, options);
+
+    std::string text = single.str();
+    EXPECT_EQ(text, parallel.str());
+    EXPECT_EQ(std::count(text.begin(), text.end(), '\n'), 3000);
+}
+
+TEST_F(SentenceGeneratorTest, DifferentSeedsDiffer) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' ; 'b') *.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 30);
+    EXPECT_EQ(generator->sentence(30, 5, 3), generator->sentence(30, 5, 3));
+    EXPECT_NE(generator->sentence(30, 5, 3), generator->sentence(30, 6, 3));
+}
+
+TEST_F(SentenceGeneratorTest, AdjacentSeedsAreNotShiftedStreams) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' ; 'b') *.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 30);
+    for (uint64_t i = 0; i < 20; ++i) {
+        EXPECT_NE(generator->sentence(30, 2, i), generator->sentence(30, 1, i + 1)) << i;
+        EXPECT_NE(generator->sentence(30, 2, i), generator->sentence(30, 1, i)) << i;
+    }
+
+    GeneratorOptions options;
+    options.length = 30;
+    options.count = 50;
+    options.threads = 1;
+    std::ostringstream first, second;
+    options.seed = 1;
+    generator->generate(first, options);
+    options.seed = 2;
+    generator->generate(second, options);
+    EXPECT_NE(first.str(), second.str());
+    EXPECT_EQ(first.str().find(second.str().substr(0, second.str().find('\n') + 1)),
+              std::string::npos);
+}
+
+TEST_F(SentenceGeneratorTest, OutputUsesTerminalNames) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'let' , $decl , 'x'.");
+
+    auto generator = SentenceGenerator::build(grammar.get(), 2);
+
+    GeneratorOptions options;
+    options.length = 2;
+    options.count = 2;
+    std::ostringstream out;
+    generator->generate(out, options);
+    EXPECT_EQ(out.str(), "let x\nlet x\n");
+}
@@ -42,6 +42,15 @@ TEST_F(ParserTest, WithParentheses) {
     EXPECT_EQ(tree->toString(EmptyMask(), false), "'begin',statement;'end'");
 }
 
+TEST_F(ParserTest, AlternativeInsideSequenceKeepsParentheses) {
+    auto tree = parser->parse("'begin' , ( statement ; 'skip' ) , 'end'.", grammar.get());
+    std::string text = tree->toString(EmptyMask(), false);
+    EXPECT_EQ(text, "'begin',(statement;'skip'),'end'");
+
+    auto reparsed = parser->parse(text + ".", grammar.get());
+    EXPECT_EQ(reparsed->toString(EmptyMask(), false), text);
+}
+
 TEST_F(ParserTest, ComplexExpression) {
     auto tree = parser->parse("'use' , '(' , library , @*( ',' , library ) , ')'.", grammar.get());
     EXPECT_FALSE(tree->toString(EmptyMask(), false).empty());
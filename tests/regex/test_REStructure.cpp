@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/REStructure.h>
+#include <syngt/regex/RETerminal.h>
+#include <syngt/regex/RENonTerminal.h>
+#include <syngt/regex/REAnd.h>
+#include <syngt/regex/REOr.h>
+
+#include <unordered_set>
+
+using namespace syngt;
+
+class REStructureTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    const RETree* rule(const std::string& name, const std::string& text) {
+        grammar->addNonTerminal(name);
+        grammar->setNTRule(name, text);
+        return grammar->getNTItem(name)->root();
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(REStructureTest, EqualTreesHaveEqualHashes) {
+    const RETree* a = rule("A", "'x' , B ; 'y' *.");
+    const RETree* b = rule("C", "'x' , B ; 'y' *.");
+
+    EXPECT_NE(a, b);
+    EXPECT_TRUE(structurallyEqual(a, b));
+    EXPECT_EQ(structuralHash(a), structuralHash(b));
+    EXPECT_EQ(nodeCount(a), 7);
+}
+
+TEST_F(REStructureTest, OrderAndNodeTypeMatter) {
+    const RETree* sequence = rule("A", "'x' , 'y'.");
+    EXPECT_FALSE(structurallyEqual(sequence, rule("B", "'y' , 'x'.")));
+    EXPECT_FALSE(structurallyEqual(sequence, rule("C", "'x' ; 'y'.")));
+    EXPECT_FALSE(structurallyEqual(sequence, rule("D", "'x' , B.")));
+    EXPECT_FALSE(structurallyEqual(sequence, nullptr));
+    EXPECT_TRUE(structurallyEqual(nullptr, nullptr));
+}
+
+TEST_F(REStructureTest, TerminalAndNonTerminalWithSameIdDiffer) {
+    int terminal = grammar->addTerminal("a");
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+
+    RETerminal t(grammar.get(), terminal);
+    RENonTerminal n(grammar.get(), terminal, false);
+    EXPECT_FALSE(structurallyEqual(&t, &n));
+}
+
+TEST_F(REStructureTest, FunctorsDeduplicateSubtrees) {
+    std::unordered_set<const RETree*, StructuralHash, StructuralEqual> seen;
+    seen.insert(rule("A", "'x' ; 'y'."));
+    seen.insert(rule("B", "'x' ; 'y'."));
+    seen.insert(rule("C", "'y' ; 'x'."));
+    EXPECT_EQ(seen.size(), 2u);
+}
+
+TEST_F(REStructureTest, NodeHashComposesToTreeHash) {
+    const RETree* tree = rule("A", "'x' , B ; @*( 'y' , $act ; 'z' ).");
+
+    std::vector<const RETree*> pending{tree};
+    while (!pending.empty()) {
+        const RETree* node = pending.back();
+        pending.pop_back();
+        if (!node) continue;
+        EXPECT_EQ(structuralNodeHash(node, structuralHash(node->left()), structuralHash(node->right())),
+                  structuralHash(node));
+        pending.push_back(node->left());
+        pending.push_back(node->right());
+    }
+}
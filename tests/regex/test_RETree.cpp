@@ -83,7 +83,7 @@ TEST_F(RETreeTest, ComplexExpression) {
     auto end = std::make_unique<RETerminal>(grammar.get(), tEnd);
     auto final = REAnd::make(std::move(seq1), std::move(end));
     
-    EXPECT_EQ(final->toString(EmptyMask(), false), "'begin',statement;expression,'end'");
+    EXPECT_EQ(final->toString(EmptyMask(), false), "'begin',(statement;expression),'end'");
     
     auto copy = final->copy();
     EXPECT_EQ(final->toString(EmptyMask(), false), 
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/transform/ExtractCommon.h>
+
+#include <chrono>
+
+using namespace syngt;
+
+class ExtractCommonTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    void define(const std::vector<std::pair<std::string, std::string>>& rules) {
+        for (const auto& rule : rules) {
+            grammar->addNonTerminal(rule.first);
+        }
+        for (const auto& rule : rules) {
+            grammar->setNTRule(rule.first, rule.second);
+        }
+    }
+
+    std::string rule(const std::string& name) {
+        NTListItem* nt = grammar->getNTItem(name);
+        return nt && nt->hasRoot() ? nt->root()->toString(SelectionMask{}, false) : "";
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(ExtractCommonTest, RepeatedSubexpressionBecomesNonTerminal) {
+    define({{"S", "'a' , ('(' , E , ')') ; 'b'."},
+            {"T", "'c' ; ('(' , E , ')') , 'd'."},
+            {"E", "'x'."}});
+
+    ExtractCommonStats stats = ExtractCommon::extract(grammar.get());
+
+    EXPECT_EQ(stats.extracted, 1);
+    EXPECT_EQ(stats.occurrences, 2);
+    EXPECT_EQ(rule("S"), "'a',common_3;'b'");
+    EXPECT_EQ(rule("T"), "'c';common_3,'d'");
+    EXPECT_EQ(rule("common_3"), "'(',E,')'");
+    EXPECT_LT(stats.nodesAfter, stats.nodesBefore);
+    EXPECT_LT(stats.bytesAfter, stats.bytesBefore);
+}
+
+TEST_F(ExtractCommonTest, WholeRuleIsReused) {
+    define({{"S", "list , ';' ; 'x' , (ID , @*(',' , ID))."},
+            {"list", "ID , @*(',' , ID)."},
+            {"ID", "'id'."}});
+
+    ExtractCommonStats stats = ExtractCommon::extract(grammar.get());
+
+    EXPECT_EQ(stats.extracted, 0);
+    EXPECT_EQ(stats.reused, 1);
+    EXPECT_EQ(rule("S"), "list,';';'x',list");
+    EXPECT_EQ(rule("list"), "ID,@*(',',ID)");
+}
+
+TEST_F(ExtractCommonTest, LargestRepeatWinsAndInnerRepeatsFollow) {
+    // 'p','q','r' repeats inside the larger repeat and once on its own
+    define({{"A", "'s' , ('p' , 'q' , 'r' , 'z')."},
+            {"B", "'t' , ('p' , 'q' , 'r' , 'z')."},
+            {"C", "'u' , ('p' , 'q' , 'r')."}});
+
+    ExtractCommonOptions options;
+    options.minNodes = 5;
+    ExtractCommonStats stats = ExtractCommon::extract(grammar.get(), options);
+
+    EXPECT_EQ(stats.extracted, 2);
+    EXPECT_EQ(stats.rounds, 3);
+    EXPECT_EQ(rule("A"), "'s',common_3");
+    EXPECT_EQ(rule("B"), "'t',common_3");
+    EXPECT_EQ(rule("common_3"), "common_4,'z'");
+    EXPECT_EQ(rule("common_4"), "'p','q','r'");
+    EXPECT_EQ(rule("C"), "'u',common_4");
+}
+
+TEST_F(ExtractCommonTest, SmallAndMacroRulesAreLeftAlone) {
+    define({{"S", "'a' , 'b' ; M."},
+            {"T", "'a' , 'b' , 'c'."},
+            {"M", "'x' , 'y' , 'z'."},
+            {"N", "'x' , 'y' , 'z' , 'w'."}});
+    grammar->getNTItem("M")->setMacro(true);
+
+    ExtractCommonStats stats = ExtractCommon::extract(grammar.get());
+
+    EXPECT_EQ(stats.extracted + stats.reused, 0);
+    EXPECT_EQ(rule("T"), "'a','b','c'");
+    EXPECT_EQ(rule("N"), "'x','y','z','w'");
+}
+
+TEST_F(ExtractCommonTest, ManyRulesAreFast) {
+    const int count = 3000;
+    for (int i = 0; i < count; ++i) {
+        grammar->addNonTerminal("R" + std::to_string(i));
+    }
+    for (int i = 0; i < count; ++i) {
+        grammar->setNTRule("R" + std::to_string(i),
+                           "'k" + std::to_string(i) + "' , ('(' , R0 , ')') ; '[' , R" +
+                           std::to_string((i + 1) % count) + " , ']'.");
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    ExtractCommonStats stats = ExtractCommon::extract(grammar.get());
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count(), 5);
+    EXPECT_EQ(stats.extracted, 1);
+    EXPECT_EQ(stats.occurrences, count);
+}
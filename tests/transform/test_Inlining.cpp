@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/transform/Inlining.h>
+
+#include <chrono>
+
+using namespace syngt;
+
+class InliningTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    void define(const std::vector<std::pair<std::string, std::string>>& rules) {
+        for (const auto& rule : rules) {
+            grammar->addNonTerminal(rule.first);
+        }
+        for (const auto& rule : rules) {
+            grammar->setNTRule(rule.first, rule.second);
+        }
+    }
+
+    std::string rule(const std::string& name) {
+        NTListItem* nt = grammar->getNTItem(name);
+        return nt->hasRoot() ? nt->root()->toString(SelectionMask{}, false) : "";
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(InliningTest, UnitChainCollapses) {
+    define({{"S", "A , A , 'x'."},
+            {"A", "B."},
+            {"B", "C."},
+            {"C", "'c' ; 'd'."}});
+
+    InliningOptions options;
+    options.singleUse = false;
+    InliningStats stats = Inlining::inlineRules(grammar.get(), options);
+
+    EXPECT_EQ(stats.unitRules, 2);
+    EXPECT_EQ(stats.rowsRemoved, 2);
+    EXPECT_EQ(stats.inlined, (std::vector<std::string>{"A", "B"}));
+    EXPECT_EQ(rule("S"), "C,C,'x'");
+    EXPECT_EQ(rule("C"), "'c';'d'");
+}
+
+TEST_F(InliningTest, SingleUseNonTerminalsAreInlined) {
+    define({{"S", "head , body."},
+            {"head", "'h' , name."},
+            {"name", "'n' # '.'."},
+            {"body", "'b' , S ; 'e'."}});
+
+    InliningStats stats = Inlining::inlineRules(grammar.get());
+
+    EXPECT_EQ(stats.singleUse, 3);
+    EXPECT_EQ(stats.rowsRemoved, 3);
+    EXPECT_EQ(rule("S"), "'h','n'#'.',('b',S;'e')");
+    EXPECT_LT(stats.operationsAfter, stats.operationsBefore);
+}
+
+TEST_F(InliningTest, StartMacrosAndRecursionAreKept) {
+    define({{"S", "M , R."},
+            {"M", "'m' , 'm'."},
+            {"R", "'r' , R ; 'r'."}});
+    grammar->getNTItem("M")->setMacro(true);
+
+    InliningStats stats = Inlining::inlineRules(grammar.get());
+
+    EXPECT_EQ(stats.rowsRemoved, 0);
+    EXPECT_EQ(rule("S"), "M,R");
+    EXPECT_EQ(rule("M"), "'m','m'");
+    EXPECT_EQ(rule("R"), "'r',R;'r'");
+}
+
+TEST_F(InliningTest, BudgetStopsGrowth) {
+    define({{"S", "'s' , big."},
+            {"big", "'a' , 'b' , 'c' , 'd' , 'e' , 'f'."}});
+
+    InliningOptions options;
+    options.maxRuleOperations = 5;
+    InliningStats stats = Inlining::inlineRules(grammar.get(), options);
+
+    EXPECT_EQ(stats.overBudget, 1);
+    EXPECT_EQ(stats.rowsRemoved, 0);
+    EXPECT_EQ(rule("S"), "'s',big");
+
+    options.maxRuleOperations = 7;
+    stats = Inlining::inlineRules(grammar.get(), options);
+    EXPECT_EQ(stats.singleUse, 1);
+    EXPECT_EQ(rule("S"), "'s','a','b','c','d','e','f'");
+}
+
+TEST_F(InliningTest, LongUnitChainIsFast) {
+    // N0 : N1 , N1.  N1 : N2.  ...  N(n-1) : 'x'.
+    const int count = 5000;
+    for (int i = 0; i < count; ++i) {
+        grammar->addNonTerminal("N" + std::to_string(i));
+    }
+    grammar->setNTRule("N0", "N1 , N1.");
+    for (int i = 1; i + 1 < count; ++i) {
+        grammar->setNTRule("N" + std::to_string(i), "N" + std::to_string(i + 1) + ".");
+    }
+    grammar->setNTRule("N" + std::to_string(count - 1), "'x'.");
+
+    auto started = std::chrono::steady_clock::now();
+    InliningStats stats = Inlining::inlineRules(grammar.get());
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 1000);
+    EXPECT_EQ(stats.rowsRemoved, count - 1);
+    EXPECT_EQ(rule("N0"), "'x','x'");
+}
@@ -2,6 +2,11 @@
 #include <syngt/core/Grammar.h>
 #include <syngt/core/NTListItem.h>
 #include <syngt/transform/LeftFactorization.h>
+#include <syngt/transform/FirstFollow.h>
+#include <syngt/analysis/RuleEquivalence.h>
+#include <syngt/regex/REOr.h>
+
+#include <chrono>
 
 using namespace syngt;
 
@@ -136,4 +141,73 @@ TEST_F(LeftFactorizationTest, NoInfiniteLoop) {
     grammar->setNTRule("S", "'a' , 'b' ; 'a' , 'c'.");
     
     EXPECT_NO_THROW(LeftFactorization::factorize(grammar->getNTItem("S"), grammar.get()));
-}
\ No newline at end of file
+}
+
+TEST_F(LeftFactorizationTest, NestedPrefixesFactoredInOnePass) {
+    // S : 'a' 'b' 'c' | 'a' 'b' 'd' | 'a' 'x' | 'y'
+    const char* rule = "'a' , 'b' , 'c' ; 'a' , 'b' , 'd' ; 'a' , 'x' ; 'y'.";
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", rule);
+    Grammar original;
+    original.fillNew();
+    original.addNonTerminal("S");
+    original.setNTRule("S", rule);
+
+    size_t beforeCount = grammar->getNonTerminals().size();
+    LeftFactorization::factorize(grammar->getNTItem("S"), grammar.get());
+
+    // 'a' (b (c | d) | x): one nonterminal per branch point
+    EXPECT_EQ(grammar->getNonTerminals().size(), beforeCount + 2);
+    EXPECT_TRUE(FirstFollow::isLL1(grammar.get()));
+    for (const auto& result : RuleEquivalence::verify(&original, grammar.get())) {
+        EXPECT_TRUE(result.result.equivalent) << result.name;
+    }
+}
+
+TEST_F(LeftFactorizationTest, AlternativeThatIsPrefixOfAnotherGetsEmptySuffix) {
+    const char* rule = "'if' , cond , 'then' , stmt ; 'if' , cond , 'then' , stmt , 'else' , stmt.";
+    grammar->addNonTerminal("stmt");
+    grammar->setNTRule("stmt", rule);
+    Grammar original;
+    original.fillNew();
+    original.addNonTerminal("stmt");
+    original.setNTRule("stmt", rule);
+
+    LeftFactorization::factorize(grammar->getNTItem("stmt"), grammar.get());
+
+    EXPECT_EQ(dynamic_cast<const REOr*>(grammar->getNTItem("stmt")->root()), nullptr);
+    for (const auto& result : RuleEquivalence::verify(&original, grammar.get())) {
+        EXPECT_TRUE(result.result.equivalent) << result.name;
+    }
+}
+
+TEST_F(LeftFactorizationTest, DuplicateAlternativesCollapse) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'b' ; 'c' ; 'a' , 'b'.");
+
+    size_t beforeCount = grammar->getNonTerminals().size();
+    LeftFactorization::factorize(grammar->getNTItem("S"), grammar.get());
+
+    EXPECT_EQ(grammar->getNonTerminals().size(), beforeCount);
+    EXPECT_EQ(grammar->getNTItem("S")->root()->toString(SelectionMask{}, false), "'a','b';'c'");
+}
+
+TEST_F(LeftFactorizationTest, ManyAlternativesAreFast) {
+    // S : 'k' 't0' | 'k' 't1' | ... | 'k' 't(n-1)'
+    const int count = 3000;
+    std::string rule;
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) rule += " ; ";
+        rule += "'k' , 't" + std::to_string(i) + "'";
+    }
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", rule + ".");
+
+    auto started = std::chrono::steady_clock::now();
+    LeftFactorization::factorize(grammar->getNTItem("S"), grammar.get());
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count(), 5);
+    EXPECT_EQ(grammar->getNTItem("S")->root()->toString(SelectionMask{}, false).rfind("'k',", 0), 0u);
+    EXPECT_EQ(dynamic_cast<const REOr*>(grammar->getNTItem("S")->root()), nullptr);
+}
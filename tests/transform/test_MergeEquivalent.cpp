@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/transform/MergeEquivalent.h>
+
+using namespace syngt;
+
+class MergeEquivalentTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    void define(const std::vector<std::pair<std::string, std::string>>& rules) {
+        for (const auto& rule : rules) {
+            grammar->addNonTerminal(rule.first);
+        }
+        for (const auto& rule : rules) {
+            grammar->setNTRule(rule.first, rule.second);
+        }
+    }
+
+    std::string rule(const std::string& name) {
+        NTListItem* nt = grammar->getNTItem(name);
+        return nt->hasRoot() ? nt->root()->toString(SelectionMask{}, false) : "";
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(MergeEquivalentTest, IdenticalRulesAreMerged) {
+    define({{"S", "ident1 , '=' , ident2."},
+            {"ident1", "'id'."},
+            {"ident2", "'id'."}});
+
+    MergeEquivalentReport report = MergeEquivalent::merge(grammar.get());
+
+    ASSERT_EQ(report.merged.size(), 1u);
+    EXPECT_EQ(report.merged[0], (std::vector<std::string>{"ident1", "ident2"}));
+    EXPECT_EQ(rule("S"), "ident1,'=',ident1");
+    EXPECT_EQ(rule("ident2"), "");
+}
+
+TEST_F(MergeEquivalentTest, RulesEqualUpToMergedReferences) {
+    // A and B only differ in referring to X or Y, which are equal themselves
+    define({{"S", "A ; B."},
+            {"A", "'(' , X , ')'."},
+            {"B", "'(' , Y , ')'."},
+            {"X", "'x' # ','."},
+            {"Y", "'x' # ','."}});
+
+    MergeEquivalentReport report = MergeEquivalent::merge(grammar.get());
+
+    ASSERT_EQ(report.merged.size(), 2u);
+    EXPECT_EQ(report.merged[0], (std::vector<std::string>{"A", "B"}));
+    EXPECT_EQ(report.merged[1], (std::vector<std::string>{"X", "Y"}));
+    EXPECT_EQ(rule("S"), "A;A");
+    EXPECT_EQ(rule("A"), "'(',X,')'");
+}
+
+TEST_F(MergeEquivalentTest, MutuallyRecursiveRulesAreMerged) {
+    // L1 and L2 unfold to the same infinite tree
+    define({{"S", "L1 , L2."},
+            {"L1", "'a' , L2 ; 'b'."},
+            {"L2", "'a' , L1 ; 'b'."}});
+
+    MergeEquivalentReport report = MergeEquivalent::merge(grammar.get());
+
+    ASSERT_EQ(report.merged.size(), 1u);
+    EXPECT_EQ(report.merged[0], (std::vector<std::string>{"L1", "L2"}));
+    EXPECT_EQ(rule("L1"), "'a',L1;'b'");
+    EXPECT_EQ(rule("S"), "L1,L1");
+}
+
+TEST_F(MergeEquivalentTest, DifferentRulesStaySeparate) {
+    // P and Q look alike until their references are told apart
+    define({{"S", "P , Q."},
+            {"P", "'a' , U."},
+            {"Q", "'a' , V."},
+            {"U", "'u'."},
+            {"V", "'v'."}});
+
+    MergeEquivalentReport report = MergeEquivalent::merge(grammar.get());
+
+    EXPECT_TRUE(report.merged.empty());
+    EXPECT_GE(report.rounds, 2);
+    EXPECT_EQ(rule("S"), "P,Q");
+    EXPECT_EQ(rule("Q"), "'a',V");
+}
+
+TEST_F(MergeEquivalentTest, UndefinedNonTerminalsAreNotMerged) {
+    define({{"S", "A ; B."},
+            {"A", "num."},
+            {"B", "ident."}});
+
+    MergeEquivalentReport report = MergeEquivalent::merge(grammar.get());
+
+    EXPECT_TRUE(report.merged.empty());
+    EXPECT_EQ(rule("S"), "A;B");
+}
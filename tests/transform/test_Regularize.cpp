@@ -4,8 +4,25 @@
 #include <syngt/transform/Regularize.h>
 #include <syngt/transform/LeftElimination.h>
 #include <syngt/transform/RightElimination.h>
+#include <syngt/analysis/RecursionAnalyzer.h>
+
+#include "common/REMatch.h"
 
 using namespace syngt;
+using namespace syngt::test;
+
+namespace {
+
+void loadIndirect(Grammar& target) {
+    // S : A , 'a' ; 'b'.   A : S , 'c' ; 'd'.  — S and A are left recursive only together
+    target.fillNew();
+    target.addNonTerminal("S");
+    target.addNonTerminal("A");
+    target.setNTRule("S", "A , 'a' ; 'b'.");
+    target.setNTRule("A", "S , 'c' ; 'd'.");
+}
+
+}
 
 class RegularizeTest : public ::testing::Test {
 protected:
@@ -130,3 +147,109 @@ TEST_F(RegularizeTest, SameResultAsGrammarMethod) {
     // Both should produce the same string representation
     EXPECT_EQ(e1->value(), e2->value());
 }
+
+// ---------------------------------------------------------------------------
+// Component-ordered regularization
+// ---------------------------------------------------------------------------
+
+TEST_F(RegularizeTest, IndirectLeftRecursionIsRemoved) {
+    for (RecursionTransform transform : {rtRegularize, rtEliminateLeft}) {
+        Grammar original, transformed;
+        loadIndirect(original);
+        loadIndirect(transformed);
+
+        RegularizeOptions options;
+        options.transform = transform;
+        RegularizeStats stats = Regularize::regularize(&transformed, options);
+
+        ASSERT_EQ(stats.recursive.size(), 1u) << transform;
+        EXPECT_EQ(stats.recursive[0].nonTerminals, (std::vector<std::string>{"S", "A"}));
+        EXPECT_EQ(stats.recursive[0].substitutions, 1);
+
+        for (const auto& result : RecursionAnalyzer::analyze(&transformed)) {
+            EXPECT_EQ(result.leftRecursion, "") << result.name << ", transform " << transform;
+        }
+        for (const auto& word : allWords({"a", "b", "c", "d"}, 5)) {
+            for (const char* nt : {"S", "A"}) {
+                ASSERT_EQ(accepts(&transformed, nt, word, nmExpand), accepts(&original, nt, word, nmExpand))
+                    << nt << " on " << word.size() << " symbols, transform " << transform;
+            }
+        }
+    }
+}
+
+TEST_F(RegularizeTest, ComponentsWithoutIndirectRecursionMatchPerRule) {
+    grammar->addNonTerminal("expr");
+    grammar->addNonTerminal("term");
+    grammar->addNonTerminal("list");
+    grammar->setNTRule("expr", "expr , '+' , term ; term.");
+    grammar->setNTRule("term", "term , '*' , 'id' ; 'id'.");
+    grammar->setNTRule("list", "'x' , list ; @.");
+
+    Grammar perRule;
+    perRule.fillNew();
+    for (const auto& name : grammar->getNonTerminals()) {
+        perRule.addNonTerminal(name);
+        perRule.setNTRule(name, grammar->getNTItem(name)->value());
+    }
+
+    RegularizeStats stats = Regularize::regularize(grammar.get(), RegularizeOptions{});
+    Regularize::regularize(&perRule);
+
+    EXPECT_EQ(stats.components, 3);
+    EXPECT_EQ(stats.recursive.size(), 3u);
+    for (const auto& name : perRule.getNonTerminals()) {
+        EXPECT_EQ(grammar->getNTItem(name)->value(), perRule.getNTItem(name)->value()) << name;
+    }
+}
+
+TEST_F(RegularizeTest, ParallelMatchesSequential) {
+    // 60 disjoint recursive components {S<i>, A<i>}, so the work is split
+    auto load = [](Grammar& target) {
+        target.fillNew();
+        for (int i = 0; i < 60; ++i) {
+            target.addNonTerminal("S" + std::to_string(i));
+            target.addNonTerminal("A" + std::to_string(i));
+        }
+        for (int i = 0; i < 60; ++i) {
+            std::string n = std::to_string(i);
+            target.setNTRule("S" + n, "A" + n + " , 'a' ; 'b' , S" + n + ".");
+            target.setNTRule("A" + n, "S" + n + " , 'c' ; 'd' ; 'e' , A" + n + ".");
+        }
+    };
+
+    Grammar sequential, parallel;
+    load(sequential);
+    load(parallel);
+
+    RegularizeOptions options;
+    RegularizeStats sequentialStats = Regularize::regularize(&sequential, options);
+    options.threads = 4;
+    RegularizeStats parallelStats = Regularize::regularize(&parallel, options);
+
+    ASSERT_EQ(sequentialStats.components, 60);
+    ASSERT_EQ(sequentialStats.recursive.size(), 60u);
+    EXPECT_EQ(parallelStats.components, sequentialStats.components);
+    EXPECT_EQ(parallelStats.recursive.size(), sequentialStats.recursive.size());
+    EXPECT_EQ(parallelStats.nodesAfter, sequentialStats.nodesAfter);
+    for (const auto& name : sequential.getNonTerminals()) {
+        EXPECT_EQ(parallel.getNTItem(name)->value(), sequential.getNTItem(name)->value()) << name;
+    }
+}
+
+TEST_F(RegularizeTest, StatsReportComponentGrowth) {
+    loadIndirect(*grammar);
+    grammar->addNonTerminal("T");
+    grammar->setNTRule("T", "'t' , S.");
+
+    RegularizeStats stats = Regularize::regularize(grammar.get(), RegularizeOptions{});
+
+    // {S, A} and {T}; only the first one is recursive
+    EXPECT_EQ(stats.components, 2);
+    ASSERT_EQ(stats.recursive.size(), 1u);
+    const ComponentStats& component = stats.recursive[0];
+    EXPECT_EQ(component.nodesBefore, 10);
+    EXPECT_GT(component.nodesAfter, 0);
+    EXPECT_EQ(stats.nodesBefore, component.nodesBefore + 3);
+    EXPECT_GE(stats.nodesAfter, component.nodesAfter);
+}
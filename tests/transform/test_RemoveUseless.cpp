@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/transform/RemoveUseless.h>
+
+#include <chrono>
+
+using namespace syngt;
+
+class RemoveUselessTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(RemoveUselessTest, ReportsRemovedSymbols) {
+    // S : A ; 'x' , B.   A : 'a'.   B : C.   C : B.   D : 'd'.
+    for (const char* name : {"S", "A", "B", "C", "D"}) {
+        grammar->addNonTerminal(name);
+    }
+    grammar->setNTRule("S", "A ; 'x' , B.");
+    grammar->setNTRule("A", "'a'.");
+    grammar->setNTRule("B", "C.");
+    grammar->setNTRule("C", "B.");
+    grammar->setNTRule("D", "'d'.");
+
+    RemoveUselessReport report = RemoveUseless::remove(grammar.get());
+
+    EXPECT_EQ(report.unproductive, (std::vector<std::string>{"B", "C"}));
+    EXPECT_EQ(report.unreachable, (std::vector<std::string>{"D"}));
+    EXPECT_TRUE(grammar->getNTItem("S")->hasRoot());
+    EXPECT_TRUE(grammar->getNTItem("A")->hasRoot());
+    EXPECT_FALSE(grammar->getNTItem("B")->hasRoot());
+    EXPECT_FALSE(grammar->getNTItem("D")->hasRoot());
+}
+
+TEST_F(RemoveUselessTest, UsefulGrammarIsUntouched) {
+    grammar->addNonTerminal("E");
+    grammar->addNonTerminal("T");
+    grammar->setNTRule("E", "T # '+'.");
+    grammar->setNTRule("T", "'n' ; '(' , E , ')'.");
+
+    RemoveUselessReport report = RemoveUseless::remove(grammar.get());
+
+    EXPECT_TRUE(report.unproductive.empty());
+    EXPECT_TRUE(report.unreachable.empty());
+    EXPECT_EQ(grammar->getNTItem("E")->value(), "T # '+'.");
+}
+
+TEST_F(RemoveUselessTest, IterationNeedsOnlyItsLeftOperand) {
+    // A#B = A(BA)*: productive with A alone, B only has to be reachable
+    for (const char* name : {"S", "L", "B", "Loop"}) {
+        grammar->addNonTerminal(name);
+    }
+    grammar->setNTRule("S", "'s' # B ; L.");
+    grammar->setNTRule("L", "Loop # 'x'.");
+    grammar->setNTRule("B", "'b'.");
+    grammar->setNTRule("Loop", "Loop , 'l'.");
+
+    RemoveUselessReport report = RemoveUseless::remove(grammar.get());
+
+    EXPECT_EQ(report.unproductive, (std::vector<std::string>{"L", "Loop"}));
+    EXPECT_TRUE(report.unreachable.empty());
+    EXPECT_TRUE(grammar->getNTItem("B")->hasRoot());
+}
+
+TEST_F(RemoveUselessTest, LongDependencyChainIsFast) {
+    // N(i) : N(i+1) , 'a' ; 'b' , N0.   N(n-1) : 'a'.  — productivity flows back one rule per round
+    const int count = 4000;
+    for (int i = 0; i < count; ++i) {
+        grammar->addNonTerminal("N" + std::to_string(i));
+    }
+    for (int i = 0; i + 1 < count; ++i) {
+        grammar->setNTRule("N" + std::to_string(i), "N" + std::to_string(i + 1) + " , 'a' ; 'b' , N0.");
+    }
+    grammar->setNTRule("N" + std::to_string(count - 1), "'a'.");
+
+    auto started = std::chrono::steady_clock::now();
+    RemoveUselessReport report = RemoveUseless::remove(grammar.get());
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 1000);
+    EXPECT_TRUE(report.unproductive.empty());
+    EXPECT_TRUE(report.unreachable.empty());
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/transform/RightFactorization.h>
+#include <syngt/analysis/RuleEquivalence.h>
+#include <syngt/regex/REOr.h>
+
+#include <chrono>
+
+using namespace syngt;
+
+class RightFactorizationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    std::string rule(const std::string& name) const {
+        return grammar->getNTItem(name)->root()->toString(SelectionMask{}, false);
+    }
+
+    // Factorize S in the fixture grammar and check it against a fresh copy
+    void factorizeAndVerify(const std::string& text) {
+        grammar->addNonTerminal("S");
+        grammar->setNTRule("S", text);
+        Grammar original;
+        original.fillNew();
+        original.addNonTerminal("S");
+        original.setNTRule("S", text);
+
+        RightFactorization::factorize(grammar->getNTItem("S"), grammar.get());
+
+        for (const auto& result : RuleEquivalence::verify(&original, grammar.get())) {
+            EXPECT_TRUE(result.result.equivalent) << result.name;
+        }
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(RightFactorizationTest, NoCommonSuffix) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "'a' , 'x' ; 'b' , 'y'.");
+    std::string before = rule("S");
+
+    RightFactorization::factorize(grammar->getNTItem("S"), grammar.get());
+
+    EXPECT_EQ(rule("S"), before);
+}
+
+TEST_F(RightFactorizationTest, FactorizeSimple) {
+    // S : 'a' X ';' | 'b' X ';'
+    factorizeAndVerify("'a' , X , ';' ; 'b' , X , ';'.");
+
+    EXPECT_EQ(rule("S"), "('a';'b'),X,';'");
+}
+
+TEST_F(RightFactorizationTest, FactorizeMultiple) {
+    factorizeAndVerify("'a' , 'x' ; 'b' , 'x' ; 'c' , 'x' ; 'y'.");
+
+    EXPECT_EQ(rule("S"), "('a';'b';'c'),'x';'y'");
+}
+
+TEST_F(RightFactorizationTest, NestedSuffixes) {
+    // 'c' 'd' is shared by three alternatives, 'b' 'c' 'd' by two of them
+    factorizeAndVerify("'a' , 'b' , 'c' , 'd' ; 'x' , 'b' , 'c' , 'd' ; 'y' , 'c' , 'd'.");
+
+    EXPECT_EQ(rule("S"), "(('a';'x'),'b';'y'),'c','d'");
+}
+
+TEST_F(RightFactorizationTest, AlternativeThatIsSuffixOfAnother) {
+    factorizeAndVerify("'a' , 'b' ; 'b'.");
+
+    EXPECT_EQ(dynamic_cast<const REOr*>(grammar->getNTItem("S")->root()), nullptr);
+}
+
+TEST_F(RightFactorizationTest, DoesNotAddNonTerminals) {
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->setNTRule("A", "'a' , 'c' ; 'b' , 'c'.");
+    grammar->setNTRule("B", "'x' , 'z' ; 'y' , 'z'.");
+
+    size_t beforeCount = grammar->getNonTerminals().size();
+    RightFactorization::factorizeAll(grammar.get());
+
+    EXPECT_EQ(grammar->getNonTerminals().size(), beforeCount);
+    EXPECT_EQ(rule("A"), "('a';'b'),'c'");
+    EXPECT_EQ(rule("B"), "('x';'y'),'z'");
+}
+
+TEST_F(RightFactorizationTest, SaveAfterFactorization) {
+    grammar->addNonTerminal("stmt");
+    grammar->setNTRule("stmt", "'if' , cond , body ; 'while' , cond , body.");
+
+    RightFactorization::factorize(grammar->getNTItem("stmt"), grammar.get());
+
+    std::string filename = "test_right_factorized.grm";
+    grammar->save(filename);
+
+    Grammar grammar2;
+    grammar2.load(filename);
+    EXPECT_EQ(grammar2.getNTItem("stmt")->root()->toString(SelectionMask{}, false),
+              "('if';'while'),cond,body");
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(RightFactorizationTest, ManyAlternativesAreFast) {
+    // S : 't0' 'k' | 't1' 'k' | ... | 't(n-1)' 'k'
+    const int count = 3000;
+    std::string text;
+    for (int i = 0; i < count; ++i) {
+        if (i > 0) text += " ; ";
+        text += "'t" + std::to_string(i) + "' , 'k'";
+    }
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", text + ".");
+
+    auto started = std::chrono::steady_clock::now();
+    RightFactorization::factorize(grammar->getNTItem("S"), grammar.get());
+    auto elapsed = std::chrono::steady_clock::now() - started;
+
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::seconds>(elapsed).count(), 5);
+    std::string result = rule("S");
+    EXPECT_EQ(result.substr(result.size() - 4), ",'k'");
+    EXPECT_EQ(dynamic_cast<const REOr*>(grammar->getNTItem("S")->root()), nullptr);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/transform/Simplify.h>
+#include <syngt/regex/REStructure.h>
+
+using namespace syngt;
+
+class SimplifyTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        grammar = std::make_unique<Grammar>();
+        grammar->fillNew();
+    }
+
+    // Simplified rule of S as text
+    std::string simplified(const std::string& rule) {
+        grammar->addNonTerminal("S");
+        grammar->setNTRule("S", rule);
+        Simplify::simplify(grammar.get());
+        return grammar->getNTItem("S")->root()->toString(SelectionMask{}, false);
+    }
+
+    // Rule as the parser builds it, in the same grammar
+    std::string parsed(const std::string& rule) {
+        grammar->addNonTerminal("Expected");
+        grammar->setNTRule("Expected", rule);
+        return grammar->getNTItem("Expected")->root()->toString(SelectionMask{}, false);
+    }
+
+    std::unique_ptr<Grammar> grammar;
+};
+
+TEST_F(SimplifyTest, EpsilonInSequence) {
+    EXPECT_EQ(simplified("@ , 'a' , @ , 'b'."), parsed("'a' , 'b'."));
+}
+
+TEST_F(SimplifyTest, DuplicateAlternatives) {
+    EXPECT_EQ(simplified("'a' ; 'b' ; 'a' ; 'c' ; 'b'."), parsed("'a' ; 'b' ; 'c'."));
+}
+
+TEST_F(SimplifyTest, AlternativeAbsorbedByIteration) {
+    EXPECT_EQ(simplified("'a' ; 'a' *."), parsed("'a' *."));
+    EXPECT_EQ(simplified("@ ; 'b' ; 'a' *."), parsed("'b' ; 'a' *."));
+}
+
+TEST_F(SimplifyTest, NestedIterations) {
+    EXPECT_EQ(simplified("('a' *) *."), parsed("'a' *."));
+    EXPECT_EQ(simplified("('a' #@) *."), parsed("'a' *."));
+    EXPECT_EQ(simplified("('a' ; @) *."), parsed("'a' *."));
+    EXPECT_EQ(simplified("('a' * ; 'b') *."), parsed("('a' ; 'b') *."));
+}
+
+TEST_F(SimplifyTest, IteratedEpsilon) {
+    EXPECT_EQ(simplified("(@) * , 'a'."), parsed("'a'."));
+}
+
+TEST_F(SimplifyTest, NullablePlusBecomesStar) {
+    EXPECT_EQ(simplified("('a' ; @) #@."), parsed("'a' *."));
+}
+
+TEST_F(SimplifyTest, RepeatedStarInSequence) {
+    EXPECT_EQ(simplified("'a' * , 'a' * , 'b'."), parsed("'a' * , 'b'."));
+}
+
+TEST_F(SimplifyTest, SemanticsAreKept) {
+    EXPECT_EQ(simplified("$act ; $act ; 'a'."), parsed("$act ; 'a'."));
+    EXPECT_EQ(simplified("$act , 'a'."), parsed("$act , 'a'."));
+}
+
+TEST_F(SimplifyTest, RewritesReachFixpoint) {
+    // Removing @ exposes a duplicate, which exposes a nested iteration
+    EXPECT_EQ(simplified("((@ , 'a') ; 'a') * *."), parsed("'a' *."));
+}
+
+TEST_F(SimplifyTest, UnchangedRulesAreNotTouched) {
+    grammar->addNonTerminal("A");
+    grammar->addNonTerminal("B");
+    grammar->setNTRule("A", "'a' , B ; 'b'.");
+    grammar->setNTRule("B", "'c' ; 'c' ; @ , 'd'.");
+    const RETree* untouched = grammar->getNTItem("A")->root();
+
+    SimplifyStats stats = Simplify::simplify(grammar.get());
+
+    EXPECT_EQ(stats.rules, 2);
+    EXPECT_EQ(stats.changedRules, 1);
+    EXPECT_LT(stats.nodesAfter, stats.nodesBefore);
+    EXPECT_EQ(grammar->getNTItem("A")->root(), untouched);
+    EXPECT_EQ(grammar->getNTItem("B")->root()->toString(SelectionMask{}, false), parsed("'c' ; 'd'."));
+}
+
+TEST_F(SimplifyTest, SimplifiedTreeIsIdempotent) {
+    grammar->addNonTerminal("S");
+    grammar->setNTRule("S", "('a' * ; @ ; 'b' , @) * , ('c' ; 'c') #@.");
+    auto once = Simplify::simplify(grammar->getNTItem("S")->root(), grammar.get());
+    auto twice = Simplify::simplify(once.get(), grammar.get());
+
+    EXPECT_TRUE(structurallyEqual(once.get(), twice.get()));
+    EXPECT_EQ(structuralHash(once.get()), structuralHash(twice.get()));
+    EXPECT_LT(nodeCount(once.get()), nodeCount(grammar->getNTItem("S")->root()));
+}
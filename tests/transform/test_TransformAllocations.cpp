@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <syngt/core/Grammar.h>
+#include <syngt/core/NTListItem.h>
+#include <syngt/regex/RETree.h>
+#include <syngt/regex/REStructure.h>
+#include <syngt/transform/LeftElimination.h>
+#include <syngt/transform/RightElimination.h>
+#include <syngt/transform/Regularize.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+// Counting allocator: every heap allocation in this test binary goes through here
+namespace {
+std::atomic<long> allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+using namespace syngt;
+
+namespace {
+
+// S : S , 'x' ; alt_0 ; ... ; alt_(n-1)  (or the mirrored right recursive rule)
+std::string recursiveRule(int alternatives, bool left) {
+    std::string rule = left ? "S , 'x'" : "'x' , S";
+    for (int i = 0; i < alternatives; ++i) {
+        std::string name = "'a" + std::to_string(i) + "'";
+        rule += " ; " + name + " , ('b' ; 'c') * , ('d' # ',') , " + name;
+    }
+    return rule + ".";
+}
+
+// Allocations made by the pass alone, not by building the grammar
+long countAllocations(const std::string& rule, const std::function<void(Grammar*)>& pass) {
+    Grammar grammar;
+    grammar.fillNew();
+    grammar.addNonTerminal("S");
+    grammar.setNTRule("S", rule);
+
+    long before = allocations.load();
+    pass(&grammar);
+    return allocations.load() - before;
+}
+
+void expectLinearGrowth(bool left, const std::function<void(Grammar*)>& pass) {
+    long small = countAllocations(recursiveRule(100, left), pass);
+    long large = countAllocations(recursiveRule(800, left), pass);
+
+    ASSERT_GT(small, 0);
+    // Eight times the input: a quadratic pass would allocate ~64 times more
+    EXPECT_LT(large, 9 * small) << small << " -> " << large;
+}
+
+}
+
+TEST(TransformAllocationsTest, LeftEliminationCopiesGrowLinearly) {
+    expectLinearGrowth(true, [](Grammar* grammar) { LeftElimination::eliminate(grammar); });
+}
+
+TEST(TransformAllocationsTest, RightEliminationCopiesGrowLinearly) {
+    expectLinearGrowth(false, [](Grammar* grammar) { RightElimination::eliminate(grammar); });
+}
+
+TEST(TransformAllocationsTest, RegularizeCopiesGrowLinearly) {
+    expectLinearGrowth(true, [](Grammar* grammar) { Regularize::regularize(grammar); });
+    expectLinearGrowth(false, [](Grammar* grammar) { Regularize::regularize(grammar); });
+}
+
+TEST(TransformAllocationsTest, RegularizeStaysCloseToOneCopyPerNode) {
+    std::string rule = recursiveRule(400, true);
+    Grammar grammar;
+    grammar.fillNew();
+    grammar.addNonTerminal("S");
+    grammar.setNTRule("S", rule);
+    int nodes = nodeCount(grammar.getNTItem("S")->root());
+
+    long pass = countAllocations(rule, [](Grammar* g) { Regularize::regularize(g); });
+    // One working copy of the rule plus the rebuilt value string
+    EXPECT_LT(pass, 2 * nodes) << nodes << " nodes";
+}